@@ -28,6 +28,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
  * all the API functions to use the MPU wrappers. That should only be done when
@@ -51,10 +52,42 @@
  * configUSE_EVENT_GROUPS is set to 1 in FreeRTOSConfig.h. */
 #if ( configUSE_EVENT_GROUPS == 1 )
 
+/* The number of event bits in an event group that are available to the
+ * application. */
+    #define eventNUMBER_OF_BITS    ( ( sizeof( EventBits_t ) * ( size_t ) 8 ) - ( size_t ) 8 )
+
+    #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+/* Describes what a task blocked on an event group's bitmap is waiting for.
+ * Allocated on the stack of the waiting task, which cannot return until the
+ * structure is no longer referenced by the event group. */
+        typedef struct EventBitmapWaiter
+        {
+            ListItem_t * pxEventListItem;          /**< The event list item of the waiting task. */
+            const EventBitmap_t * pxBitsToWaitFor; /**< The bits the task is waiting for. */
+            BaseType_t xClearOnExit;
+            BaseType_t xWaitForAllBits;
+            EventBitmap_t xEventBitmap;            /**< The value of the bitmap when the task was unblocked. */
+            struct EventBitmapWaiter * pxNext;
+        } EventBitmapWaiter_t;
+
+    #endif /* configUSE_EVENT_GROUP_BITMAPS */
+
     typedef struct EventGroupDef_t
     {
         EventBits_t uxEventBits;
-        List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set. */
+        List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set.  When configUSE_EVENT_GROUP_WAITER_INDEX is 1 only tasks waiting for any one of several bits are held here. */
+
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            EventBits_t uxAnyWaitersBits;                        /**< Includes all the bits waited for by the tasks in xTasksWaitingForBits. */
+            List_t xTasksWaitingForBit[ eventNUMBER_OF_BITS ]; /**< Lists of the other waiting tasks, indexed by one of the bits each is waiting for that is not yet set. */
+        #endif
+
+        #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+            List_t xTasksWaitingForBitmap;         /**< List of tasks waiting for bits in xEventBitmap to be set. */
+            EventBitmap_t xEventBitmap;
+            EventBitmapWaiter_t * pxBitmapWaiters; /**< Describes the wait condition of each task in xTasksWaitingForBitmap, plus tasks that timed out and have not yet run. */
+        #endif
 
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxEventGroupNumber;
@@ -65,6 +98,17 @@
         #endif
     } EventGroup_t;
 
+/* When configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1 interrupts access the lists
+ * of waiting tasks, so the tasks must access them from a critical section as
+ * well as with the scheduler suspended. */
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+        #define eventLOCK_WAITING_LISTS()      taskENTER_CRITICAL()
+        #define eventUNLOCK_WAITING_LISTS()    taskEXIT_CRITICAL()
+    #else
+        #define eventLOCK_WAITING_LISTS()
+        #define eventUNLOCK_WAITING_LISTS()
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -79,6 +123,85 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Set uxBitsToSet in the event group, unblock the tasks whose wait condition is
+ * then met, and clear the bits those tasks asked to be cleared on exit.  Called
+ * with the scheduler suspended and the waiting lists locked from a task, in
+ * which case pxHigherPriorityTaskWoken is NULL, or from a critical section
+ * within an ISR.
+ */
+    static void prvSetBits( EventGroup_t * pxEventBits,
+                            const EventBits_t uxBitsToSet,
+                            BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Evaluate the wait condition of each task in pxList against the event bits,
+ * unblocking the tasks whose condition is met.  The bits that must be cleared
+ * because an unblocked task specified eventCLEAR_EVENTS_ON_EXIT_BIT are added
+ * to *puxBitsToClear.  Returns all the bits waited for by the tasks that
+ * remain blocked.  pxHigherPriorityTaskWoken is as for prvSetBits().
+ */
+    static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                               List_t * pxList,
+                                               EventBits_t * puxBitsToClear,
+                                               BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+/*
+ * Initialise the lists used to index the tasks waiting on an event group.
+ */
+        static void prvInitialiseWaiterIndex( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the list on which a task that is about to wait for uxBitsToWaitFor
+ * should be placed.  A task that waits for a single bit, or for all of several
+ * bits, is placed on the list of one of the bits it waits for that is not yet
+ * set, as it cannot unblock until that bit is set.  A task that waits for any
+ * one of several bits is placed on xTasksWaitingForBits.
+ */
+        static List_t * prvGetWaitingList( EventGroup_t * pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the lowest bit set in uxBits, which must not be 0.
+ */
+        static UBaseType_t prvGetLowestBit( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
+    #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+/*
+ * The bitmap equivalent of prvTestWaitCondition().
+ */
+        static BaseType_t prvTestBitmapCondition( const EventBitmap_t * pxCurrentEventBitmap,
+                                                  const EventBitmap_t * pxBitsToWaitFor,
+                                                  const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the bits in pxBitsToSet in the event group's bitmap, unblock the tasks
+ * whose wait condition is then met, and clear the bits those tasks asked to be
+ * cleared on exit.  Called with the scheduler suspended.
+ */
+        static void prvSetBitmap( EventGroup_t * pxEventBits,
+                                  const EventBitmap_t * pxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Implements both xEventGroupWaitBitmap() and xEventGroupSyncBitmap().
+ * pxBitsToSet is NULL when called from xEventGroupWaitBitmap().
+ */
+        static BaseType_t prvWaitBitmap( EventGroup_t * pxEventBits,
+                                         const EventBitmap_t * pxBitsToSet,
+                                         const EventBitmap_t * pxBitsToWaitFor,
+                                         const BaseType_t xClearOnExit,
+                                         const BaseType_t xWaitForAllBits,
+                                         EventBitmap_t * pxEventBitmap,
+                                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_EVENT_GROUP_BITMAPS */
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,6 +236,20 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    prvInitialiseWaiterIndex( pxEventBits );
+                }
+                #endif
+
+                #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+                {
+                    vListInitialise( &( pxEventBits->xTasksWaitingForBitmap ) );
+                    ( void ) memset( &( pxEventBits->xEventBitmap ), 0x00, sizeof( EventBitmap_t ) );
+                    pxEventBits->pxBitmapWaiters = NULL;
+                }
+                #endif
+
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -158,6 +295,20 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    prvInitialiseWaiterIndex( pxEventBits );
+                }
+                #endif
+
+                #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+                {
+                    vListInitialise( &( pxEventBits->xTasksWaitingForBitmap ) );
+                    ( void ) memset( &( pxEventBits->xEventBitmap ), 0x00, sizeof( EventBitmap_t ) );
+                    pxEventBits->pxBitmapWaiters = NULL;
+                }
+                #endif
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -204,9 +355,22 @@
 
         vTaskSuspendAll();
         {
+            eventLOCK_WAITING_LISTS();
+
             uxOriginalBitValue = pxEventBits->uxEventBits;
 
-            ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+            #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+            {
+                /* The scheduler cannot be suspended again from within the
+                 * critical section, so set the bits directly. */
+                traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+                prvSetBits( pxEventBits, uxBitsToSet, NULL );
+            }
+            #else
+            {
+                ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+            }
+            #endif
 
             if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
             {
@@ -228,7 +392,15 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                    {
+                        vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    }
+                    #else
+                    {
+                        vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    }
+                    #endif
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +416,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            eventUNLOCK_WAITING_LISTS();
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -335,7 +509,11 @@
 
         vTaskSuspendAll();
         {
-            const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
+            EventBits_t uxCurrentEventBits;
+
+            eventLOCK_WAITING_LISTS();
+
+            uxCurrentEventBits = pxEventBits->uxEventBits;
 
             /* Check to see if the wait condition is already met or not. */
             xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
@@ -391,7 +569,15 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                }
+                #else
+                {
+                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                }
+                #endif
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -400,6 +586,8 @@
 
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
+
+            eventUNLOCK_WAITING_LISTS();
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -501,7 +689,37 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+        BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
+                                                const EventBits_t uxBitsToClear )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            EventGroup_t * pxEventBits = xEventGroup;
+
+            traceENTER_xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+                /* Clearing bits cannot unblock a task. */
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xEventGroupClearBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                                 const EventBits_t uxBitsToClear )
@@ -518,7 +736,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -547,13 +765,7 @@
     EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                     const EventBits_t uxBitsToSet )
     {
-        ListItem_t * pxListItem;
-        ListItem_t * pxNext;
-        ListItem_t const * pxListEnd;
-        List_t const * pxList;
-        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
         EventGroup_t * pxEventBits = xEventGroup;
-        BaseType_t xMatchFound = pdFALSE;
 
         traceENTER_xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -562,79 +774,15 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        pxList = &( pxEventBits->xTasksWaitingForBits );
-        pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
         {
-            traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
-
-            pxListItem = listGET_HEAD_ENTRY( pxList );
-
-            /* Set the bits. */
-            pxEventBits->uxEventBits |= uxBitsToSet;
-
-            /* See if the new bit value should unblock any tasks. */
-            while( pxListItem != pxListEnd )
+            eventLOCK_WAITING_LISTS();
             {
-                pxNext = listGET_NEXT( pxListItem );
-                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-                xMatchFound = pdFALSE;
-
-                /* Split the bits waited for from the control bits. */
-                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+                traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-                {
-                    /* Just looking for single bit being set. */
-                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                    {
-                        xMatchFound = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-                {
-                    /* All bits are set. */
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    /* Need all bits to be set, but not all the bits were set. */
-                }
-
-                if( xMatchFound != pdFALSE )
-                {
-                    /* The bits match.  Should the bits be cleared on exit? */
-                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                    {
-                        uxBitsToClear |= uxBitsWaitedFor;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Store the actual event flag value in the task's event list
-                     * item before removing the task from the event list.  The
-                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                     * that is was unblocked due to its required bits matching, rather
-                     * than because it timed out. */
-                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-                }
-
-                /* Move onto the next list item.  Note pxListItem->pxNext is not
-                 * used here as the list item may have been removed from the event list
-                 * and inserted into the ready/pending reading list. */
-                pxListItem = pxNext;
+                prvSetBits( pxEventBits, uxBitsToSet, NULL );
             }
-
-            /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-             * bit was set in the control word. */
-            pxEventBits->uxEventBits &= ~uxBitsToClear;
+            eventUNLOCK_WAITING_LISTS();
         }
         ( void ) xTaskResumeAll();
 
@@ -657,6 +805,8 @@
 
         vTaskSuspendAll();
         {
+            eventLOCK_WAITING_LISTS();
+
             traceEVENT_GROUP_DELETE( xEventGroup );
 
             while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
@@ -666,6 +816,47 @@
                 configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
                 vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
             }
+
+            #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            {
+                UBaseType_t uxBit;
+
+                for( uxBit = ( UBaseType_t ) 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+                    while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                    {
+                        vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                }
+            }
+            #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
+            #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+            {
+                EventBitmapWaiter_t * pxWaiter;
+
+                /* Unblock the tasks waiting for bitmap bits, returning a
+                 * cleared bitmap to each. */
+                for( pxWaiter = pxEventBits->pxBitmapWaiters; pxWaiter != NULL; pxWaiter = pxWaiter->pxNext )
+                {
+                    if( listLIST_ITEM_CONTAINER( pxWaiter->pxEventListItem ) == &( pxEventBits->xTasksWaitingForBitmap ) )
+                    {
+                        ( void ) memset( &( pxWaiter->xEventBitmap ), 0x00, sizeof( EventBitmap_t ) );
+                        vTaskRemoveFromUnorderedEventList( pxWaiter->pxEventListItem, eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                pxEventBits->pxBitmapWaiters = NULL;
+            }
+            #endif /* configUSE_EVENT_GROUP_BITMAPS */
+
+            eventUNLOCK_WAITING_LISTS();
         }
         ( void ) xTaskResumeAll();
 
@@ -694,6 +885,140 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+        void vEventGroupSetBitmap( EventGroupHandle_t xEventGroup,
+                                   const EventBitmap_t * pxBitsToSet,
+                                   EventBitmap_t * pxEventBitmap )
+        {
+            EventGroup_t * pxEventBits = xEventGroup;
+
+            traceENTER_vEventGroupSetBitmap( xEventGroup, pxBitsToSet, pxEventBitmap );
+
+            configASSERT( xEventGroup );
+            configASSERT( pxBitsToSet );
+
+            vTaskSuspendAll();
+            {
+                prvSetBitmap( pxEventBits, pxBitsToSet );
+
+                if( pxEventBitmap != NULL )
+                {
+                    *pxEventBitmap = pxEventBits->xEventBitmap;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vEventGroupSetBitmap();
+        }
+/*-----------------------------------------------------------*/
+
+        void vEventGroupClearBitmap( EventGroupHandle_t xEventGroup,
+                                     const EventBitmap_t * pxBitsToClear,
+                                     EventBitmap_t * pxEventBitmap )
+        {
+            EventGroup_t * pxEventBits = xEventGroup;
+            UBaseType_t uxWord;
+
+            traceENTER_vEventGroupClearBitmap( xEventGroup, pxBitsToClear, pxEventBitmap );
+
+            configASSERT( xEventGroup );
+            configASSERT( pxBitsToClear );
+
+            /* The bitmap is only accessed with the scheduler suspended, which
+             * avoids copying a multiword bitmap from within a critical
+             * section. */
+            vTaskSuspendAll();
+            {
+                /* The value returned is the bitmap prior to the bits being
+                 * cleared. */
+                if( pxEventBitmap != NULL )
+                {
+                    *pxEventBitmap = pxEventBits->xEventBitmap;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                {
+                    pxEventBits->xEventBitmap.ulWords[ uxWord ] &= ~( pxBitsToClear->ulWords[ uxWord ] );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vEventGroupClearBitmap();
+        }
+/*-----------------------------------------------------------*/
+
+        void vEventGroupGetBitmap( EventGroupHandle_t xEventGroup,
+                                   EventBitmap_t * pxEventBitmap )
+        {
+            EventGroup_t const * const pxEventBits = xEventGroup;
+
+            traceENTER_vEventGroupGetBitmap( xEventGroup, pxEventBitmap );
+
+            configASSERT( xEventGroup );
+            configASSERT( pxEventBitmap );
+
+            vTaskSuspendAll();
+            {
+                *pxEventBitmap = pxEventBits->xEventBitmap;
+            }
+            ( void ) xTaskResumeAll();
+
+            traceRETURN_vEventGroupGetBitmap();
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xEventGroupWaitBitmap( EventGroupHandle_t xEventGroup,
+                                          const EventBitmap_t * pxBitsToWaitFor,
+                                          const BaseType_t xClearOnExit,
+                                          const BaseType_t xWaitForAllBits,
+                                          EventBitmap_t * pxEventBitmap,
+                                          TickType_t xTicksToWait )
+        {
+            BaseType_t xReturn;
+
+            traceENTER_xEventGroupWaitBitmap( xEventGroup, pxBitsToWaitFor, xClearOnExit, xWaitForAllBits, pxEventBitmap, xTicksToWait );
+
+            xReturn = prvWaitBitmap( xEventGroup, NULL, pxBitsToWaitFor, xClearOnExit, xWaitForAllBits, pxEventBitmap, xTicksToWait );
+
+            traceRETURN_xEventGroupWaitBitmap( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xEventGroupSyncBitmap( EventGroupHandle_t xEventGroup,
+                                          const EventBitmap_t * pxBitsToSet,
+                                          const EventBitmap_t * pxBitsToWaitFor,
+                                          EventBitmap_t * pxEventBitmap,
+                                          TickType_t xTicksToWait )
+        {
+            BaseType_t xReturn;
+
+            traceENTER_xEventGroupSyncBitmap( xEventGroup, pxBitsToSet, pxBitsToWaitFor, pxEventBitmap, xTicksToWait );
+
+            configASSERT( pxBitsToSet );
+
+            /* A rendezvous always waits for all the bits, and always clears
+             * them. */
+            xReturn = prvWaitBitmap( xEventGroup, pxBitsToSet, pxBitsToWaitFor, pdTRUE, pdTRUE, pxEventBitmap, xTicksToWait );
+
+            traceRETURN_xEventGroupSyncBitmap( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_EVENT_GROUP_BITMAPS */
+/*-----------------------------------------------------------*/
+
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
         BaseType_t xEventGroupGetStaticBuffer( EventGroupHandle_t xEventGroup,
                                                StaticEventGroup_t ** ppxEventGroupBuffer )
@@ -772,6 +1097,505 @@
     }
 /*-----------------------------------------------------------*/
 
+    static void prvSetBits( EventGroup_t * pxEventBits,
+                            const EventBits_t uxBitsToSet,
+                            BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventBits_t uxBitsToClear = 0;
+
+        /* Set the bits. */
+        pxEventBits->uxEventBits |= uxBitsToSet;
+
+        /* See if the new bit value should unblock any tasks. */
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        {
+            UBaseType_t uxBit;
+
+            /* Only the tasks indexed by the bits being set, and the tasks
+             * waiting for any one of several bits that include a bit being
+             * set, can be unblocked. */
+            for( uxBit = ( UBaseType_t ) 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+            {
+                if( ( uxBitsToSet & ( ( EventBits_t ) 1U << uxBit ) ) != ( EventBits_t ) 0 )
+                {
+                    ( void ) prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), &uxBitsToClear, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( ( uxBitsToSet & pxEventBits->uxAnyWaitersBits ) != ( EventBits_t ) 0 )
+            {
+                pxEventBits->uxAnyWaitersBits = prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
+        {
+            ( void ) prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear, pxHigherPriorityTaskWoken );
+        }
+        #endif /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+/*-----------------------------------------------------------*/
+
+    static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                               List_t * pxList,
+                                               EventBits_t * puxBitsToClear,
+                                               BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        EventBits_t uxBitsWaitedFor, uxControlBits, uxRemainingBits = 0;
+        BaseType_t xMatchFound;
+
+        pxListEnd = listGET_END_MARKER( pxList );
+        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+            xMatchFound = pdFALSE;
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            {
+                /* Just looking for single bit being set. */
+                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                {
+                    xMatchFound = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+            {
+                /* All bits are set. */
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                /* Need all bits to be set, but not all the bits were set. */
+            }
+
+            if( xMatchFound != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    *puxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                if( pxHigherPriorityTaskWoken == NULL )
+                {
+                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+                else
+                {
+                    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+                    {
+                        if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
+                }
+            }
+            else
+            {
+                uxRemainingBits |= uxBitsWaitedFor;
+
+                #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+                {
+                    if( pxList != &( pxEventBits->xTasksWaitingForBits ) )
+                    {
+                        /* The task is waiting for all of several bits and only
+                         * some are set, so move it to the list of a bit that is
+                         * still not set.  That bit is not being set, so the task
+                         * is not evaluated again by this call. */
+                        ( void ) uxListRemove( pxListItem );
+                        vListInsertEnd( &( pxEventBits->xTasksWaitingForBit[ prvGetLowestBit( uxBitsWaitedFor & ~( pxEventBits->uxEventBits ) ) ] ), pxListItem );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+            }
+
+            /* Move onto the next list item.  Note pxListItem->pxNext is not
+             * used here as the list item may have been removed from the event list
+             * and inserted into the ready/pending reading list. */
+            pxListItem = pxNext;
+        }
+
+        return uxRemainingBits;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+        static void prvInitialiseWaiterIndex( EventGroup_t * pxEventBits )
+        {
+            UBaseType_t uxBit;
+
+            pxEventBits->uxAnyWaitersBits = 0;
+
+            for( uxBit = ( UBaseType_t ) 0; uxBit < ( UBaseType_t ) eventNUMBER_OF_BITS; uxBit++ )
+            {
+                vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static List_t * prvGetWaitingList( EventGroup_t * pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits )
+        {
+            List_t * pxList;
+
+            if( ( xWaitForAllBits != pdFALSE ) || ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1U ) ) == ( EventBits_t ) 0 ) )
+            {
+                /* The task is only blocking because its wait condition is not
+                 * met, so at least one of the bits it waits for is not set. */
+                pxList = &( pxEventBits->xTasksWaitingForBit[ prvGetLowestBit( uxBitsToWaitFor & ~( pxEventBits->uxEventBits ) ) ] );
+            }
+            else
+            {
+                pxEventBits->uxAnyWaitersBits |= uxBitsToWaitFor;
+                pxList = &( pxEventBits->xTasksWaitingForBits );
+            }
+
+            return pxList;
+        }
+/*-----------------------------------------------------------*/
+
+        static UBaseType_t prvGetLowestBit( EventBits_t uxBits )
+        {
+            UBaseType_t uxBit = 0;
+
+            configASSERT( uxBits != ( EventBits_t ) 0 );
+
+            while( ( uxBits & ( EventBits_t ) 1U ) == ( EventBits_t ) 0 )
+            {
+                uxBits >>= 1;
+                uxBit++;
+            }
+
+            return uxBit;
+        }
+
+    #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+        static BaseType_t prvTestBitmapCondition( const EventBitmap_t * pxCurrentEventBitmap,
+                                                  const EventBitmap_t * pxBitsToWaitFor,
+                                                  const BaseType_t xWaitForAllBits )
+        {
+            BaseType_t xWaitConditionMet = xWaitForAllBits;
+            UBaseType_t uxWord;
+            uint32_t ulMatchedBits;
+
+            for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+            {
+                ulMatchedBits = pxCurrentEventBitmap->ulWords[ uxWord ] & pxBitsToWaitFor->ulWords[ uxWord ];
+
+                if( xWaitForAllBits == pdFALSE )
+                {
+                    /* Task only has to wait for one bit within uxBitsToWaitFor
+                     * to be set.  Is one already set? */
+                    if( ulMatchedBits != 0U )
+                    {
+                        xWaitConditionMet = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Task has to wait for all the bits in uxBitsToWaitFor to be
+                     * set.  Are they set already? */
+                    if( ulMatchedBits != pxBitsToWaitFor->ulWords[ uxWord ] )
+                    {
+                        xWaitConditionMet = pdFALSE;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+
+            return xWaitConditionMet;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvSetBitmap( EventGroup_t * pxEventBits,
+                                  const EventBitmap_t * pxBitsToSet )
+        {
+            EventBitmapWaiter_t ** ppxWaiter;
+            EventBitmapWaiter_t * pxWaiter;
+            EventBitmap_t xBitsToClear;
+            UBaseType_t uxWord;
+
+            ( void ) memset( &xBitsToClear, 0x00, sizeof( EventBitmap_t ) );
+
+            /* Set the bits. */
+            for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+            {
+                pxEventBits->xEventBitmap.ulWords[ uxWord ] |= pxBitsToSet->ulWords[ uxWord ];
+            }
+
+            /* See if the new bit value should unblock any tasks.  Waiters whose
+             * task is no longer in xTasksWaitingForBitmap have timed out, and
+             * will remove themselves when they next run. */
+            ppxWaiter = &( pxEventBits->pxBitmapWaiters );
+
+            while( *ppxWaiter != NULL )
+            {
+                pxWaiter = *ppxWaiter;
+
+                if( ( listLIST_ITEM_CONTAINER( pxWaiter->pxEventListItem ) == &( pxEventBits->xTasksWaitingForBitmap ) ) &&
+                    ( prvTestBitmapCondition( &( pxEventBits->xEventBitmap ), pxWaiter->pxBitsToWaitFor, pxWaiter->xWaitForAllBits ) != pdFALSE ) )
+                {
+                    /* The bits match.  Should the bits be cleared on exit? */
+                    if( pxWaiter->xClearOnExit != pdFALSE )
+                    {
+                        for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                        {
+                            xBitsToClear.ulWords[ uxWord ] |= pxWaiter->pxBitsToWaitFor->ulWords[ uxWord ];
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Return the bitmap to the task through its waiter, which
+                     * is removed from the event group before the task is
+                     * unblocked. */
+                    pxWaiter->xEventBitmap = pxEventBits->xEventBitmap;
+                    *ppxWaiter = pxWaiter->pxNext;
+                    vTaskRemoveFromUnorderedEventList( pxWaiter->pxEventListItem, eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+                else
+                {
+                    ppxWaiter = &( pxWaiter->pxNext );
+                }
+            }
+
+            /* Clear any bits that matched when a task that requested the bits
+             * be cleared on exit was unblocked. */
+            for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+            {
+                pxEventBits->xEventBitmap.ulWords[ uxWord ] &= ~( xBitsToClear.ulWords[ uxWord ] );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvWaitBitmap( EventGroup_t * pxEventBits,
+                                         const EventBitmap_t * pxBitsToSet,
+                                         const EventBitmap_t * pxBitsToWaitFor,
+                                         const BaseType_t xClearOnExit,
+                                         const BaseType_t xWaitForAllBits,
+                                         EventBitmap_t * pxEventBitmap,
+                                         TickType_t xTicksToWait )
+        {
+            EventBitmapWaiter_t xWaiter;
+            EventBitmapWaiter_t ** ppxWaiter;
+            EventBitmap_t xCurrentEventBitmap;
+            BaseType_t xWaitConditionMet, xAlreadyYielded;
+            UBaseType_t uxWord;
+
+            configASSERT( pxEventBits );
+            configASSERT( pxBitsToWaitFor );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                uint32_t ulBitsToWaitFor = 0U;
+
+                /* Should not wait for no bits. */
+                for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                {
+                    ulBitsToWaitFor |= pxBitsToWaitFor->ulWords[ uxWord ];
+                }
+
+                configASSERT( ulBitsToWaitFor != 0U );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xCurrentEventBitmap = pxEventBits->xEventBitmap;
+
+                if( pxBitsToSet != NULL )
+                {
+                    /* As for xEventGroupSync(), the rendezvous condition is
+                     * tested against the bits as they were before any task
+                     * unblocked by setting the bits cleared them. */
+                    for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                    {
+                        xCurrentEventBitmap.ulWords[ uxWord ] |= pxBitsToSet->ulWords[ uxWord ];
+                    }
+
+                    prvSetBitmap( pxEventBits, pxBitsToSet );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xWaitConditionMet = prvTestBitmapCondition( &xCurrentEventBitmap, pxBitsToWaitFor, xWaitForAllBits );
+
+                if( xWaitConditionMet != pdFALSE )
+                {
+                    /* The wait condition has already been met so there is no
+                     * need to block. */
+                    xTicksToWait = ( TickType_t ) 0;
+
+                    if( xClearOnExit != pdFALSE )
+                    {
+                        for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                        {
+                            pxEventBits->xEventBitmap.ulWords[ uxWord ] &= ~( pxBitsToWaitFor->ulWords[ uxWord ] );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The wait condition has not been met, but no block time
+                     * was specified, so just return the current value. */
+                    xCurrentEventBitmap = pxEventBits->xEventBitmap;
+                }
+                else
+                {
+                    /* The wait condition is held in xWaiter rather than in the
+                     * task's event list item value, which is too narrow to hold
+                     * the bitmap. */
+                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBitmap ), ( TickType_t ) 0, xTicksToWait );
+                    xWaiter.pxEventListItem = pxTaskGetEventListItem();
+                    xWaiter.pxBitsToWaitFor = pxBitsToWaitFor;
+                    xWaiter.xClearOnExit = xClearOnExit;
+                    xWaiter.xWaitForAllBits = xWaitForAllBits;
+                    xWaiter.pxNext = pxEventBits->pxBitmapWaiters;
+                    pxEventBits->pxBitmapWaiters = &xWaiter;
+                }
+            }
+            xAlreadyYielded = xTaskResumeAll();
+
+            if( xTicksToWait != ( TickType_t ) 0 )
+            {
+                if( xAlreadyYielded == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( uxTaskResetEventItemValue() & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( TickType_t ) 0 )
+                {
+                    vTaskSuspendAll();
+                    {
+                        /* The task timed out, so its waiter is still referenced
+                         * by the event group and must be removed. */
+                        for( ppxWaiter = &( pxEventBits->pxBitmapWaiters ); *ppxWaiter != &xWaiter; ppxWaiter = &( ( *ppxWaiter )->pxNext ) )
+                        {
+                            configASSERT( *ppxWaiter != NULL );
+                        }
+
+                        *ppxWaiter = xWaiter.pxNext;
+
+                        /* It is possible that the bits were updated between this
+                         * task leaving the Blocked state and running again. */
+                        xCurrentEventBitmap = pxEventBits->xEventBitmap;
+                        xWaitConditionMet = prvTestBitmapCondition( &xCurrentEventBitmap, pxBitsToWaitFor, xWaitForAllBits );
+
+                        if( ( xWaitConditionMet != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
+                        {
+                            for( uxWord = ( UBaseType_t ) 0; uxWord < ( UBaseType_t ) eventBITMAP_WORDS; uxWord++ )
+                            {
+                                pxEventBits->xEventBitmap.ulWords[ uxWord ] &= ~( pxBitsToWaitFor->ulWords[ uxWord ] );
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    /* The task was unblocked because the bits were set, or
+                     * because the event group was deleted. */
+                    xCurrentEventBitmap = xWaiter.xEventBitmap;
+                    xWaitConditionMet = prvTestBitmapCondition( &xCurrentEventBitmap, pxBitsToWaitFor, xWaitForAllBits );
+                }
+            }
+
+            if( pxEventBitmap != NULL )
+            {
+                *pxEventBitmap = xCurrentEventBitmap;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xWaitConditionMet;
+        }
+
+    #endif /* configUSE_EVENT_GROUP_BITMAPS */
+/*-----------------------------------------------------------*/
+
     static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits )
@@ -809,7 +1633,50 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+        BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            EventGroup_t * pxEventBits = xEventGroup;
+            BaseType_t xYieldRequired = pdFALSE;
+
+            traceENTER_xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* The waiting tasks are evaluated, and unblocked, from within the
+             * interrupt.  The waiting lists are only accessed from critical
+             * sections so exclusive access to them is guaranteed here. */
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+                prvSetBits( pxEventBits, uxBitsToSet, &xYieldRequired );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupSetBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                               const EventBits_t uxBitsToSet,
@@ -827,7 +1694,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -0,0 +1,494 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Kernel microbenchmarks, run on the host with the POSIX port.
+ *
+ * Each benchmark times a fixed number of iterations of a kernel operation with
+ * the host's monotonic clock, and prints the result as one JSON object per
+ * line so the output of different kernel versions, configurations and heaps
+ * can be compared by a script.  The partner tasks in the ping-pong benchmarks
+ * have a higher priority than the task running the benchmarks, except in the
+ * yield benchmark where they have the same priority, so every iteration
+ * includes two context switches.
+ *
+ * Objects are created once and never deleted so the suite can run with every
+ * heap, including heap_1.
+ *
+ * Usage: benchmark [iterations]
+ */
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <stream_buffer.h>
+#include <timers.h>
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*-----------------------------------------------------------*/
+
+#define benchDEFAULT_ITERATIONS    100000UL
+
+#define benchRUNNER_PRIORITY       ( tskIDLE_PRIORITY + 1 )
+#define benchPARTNER_PRIORITY      ( tskIDLE_PRIORITY + 2 )
+
+/* The number of tasks contending for the mutex. */
+#define benchMUTEX_TASKS           4
+
+/* The number of live allocations in the allocator benchmark, and the range of
+ * allocation sizes. */
+#define benchMALLOC_SLOTS          64
+#define benchMALLOC_MIN_SIZE       16U
+#define benchMALLOC_MAX_SIZE       1024U
+
+/* The number of timers commanded in the timer benchmark. */
+#define benchTIMERS                16
+
+/*-----------------------------------------------------------*/
+
+static void prvRunnerTask( void * pvParameters );
+static void prvYieldTask( void * pvParameters );
+static void prvQueueEchoTask( void * pvParameters );
+static void prvNotifyEchoTask( void * pvParameters );
+static void prvStreamBufferEchoTask( void * pvParameters );
+static void prvMutexTask( void * pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+static void prvBenchmarkYieldPingPong( void );
+static void prvBenchmarkQueuePingPong( void );
+static void prvBenchmarkNotifyPingPong( void );
+static void prvBenchmarkStreamBufferPingPong( void );
+static void prvBenchmarkMutexContention( void );
+static void prvBenchmarkMallocChurn( void );
+static void prvBenchmarkTimerChurn( void );
+
+static uint64_t prvGetTimeNs( void );
+static void prvReport( const char * pcBenchmark,
+                       unsigned long ulIterations,
+                       uint64_t ullElapsedNs );
+
+/*-----------------------------------------------------------*/
+
+static unsigned long ulIterations = benchDEFAULT_ITERATIONS;
+
+static QueueHandle_t xPingQueue;
+static QueueHandle_t xPongQueue;
+static StreamBufferHandle_t xPingStreamBuffer;
+static StreamBufferHandle_t xPongStreamBuffer;
+static SemaphoreHandle_t xMutex;
+static SemaphoreHandle_t xMutexTasksDone;
+static TaskHandle_t xRunnerTask;
+static TaskHandle_t xNotifyEchoTask;
+static volatile BaseType_t xYieldTaskRunning;
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcBenchmark,
+                       unsigned long ulIterations,
+                       uint64_t ullElapsedNs )
+{
+    ( void ) printf( "{\"benchmark\":\"%s\",\"heap\":%d,\"iterations\":%lu,\"total_ns\":%llu,\"ns_per_iteration\":%.1f}\n",
+                     pcBenchmark,
+                     BENCHMARK_HEAP,
+                     ulIterations,
+                     ( unsigned long long ) ullElapsedNs,
+                     ( double ) ullElapsedNs / ( double ) ulIterations );
+    ( void ) fflush( stdout );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    while( xYieldTaskRunning != pdFALSE )
+    {
+        taskYIELD();
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkYieldPingPong( void )
+{
+    unsigned long ul;
+    uint64_t ullElapsedNs;
+    uint64_t ullStart;
+
+    /* The partner has the same priority as this task, so each yield switches
+     * to the partner, which yields straight back. */
+    xYieldTaskRunning = pdTRUE;
+    ( void ) xTaskCreate( prvYieldTask, "Yield", configMINIMAL_STACK_SIZE, NULL, benchRUNNER_PRIORITY, NULL );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        taskYIELD();
+    }
+
+    ullElapsedNs = prvGetTimeNs() - ullStart;
+
+    /* Let the partner see the flag and suspend itself, so it does not share
+     * the processor with the following benchmarks. */
+    xYieldTaskRunning = pdFALSE;
+    taskYIELD();
+
+    prvReport( "yield_ping_pong", ulIterations, ullElapsedNs );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueEchoTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueReceive( xPingQueue, &ulValue, portMAX_DELAY );
+        ( void ) xQueueSend( xPongQueue, &ulValue, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkQueuePingPong( void )
+{
+    uint32_t ulValue;
+    unsigned long ul;
+    uint64_t ullStart;
+
+    xPingQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    xPongQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    ( void ) xTaskCreate( prvQueueEchoTask, "QEcho", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, NULL );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ulValue = ( uint32_t ) ul;
+        ( void ) xQueueSend( xPingQueue, &ulValue, portMAX_DELAY );
+        ( void ) xQueueReceive( xPongQueue, &ulValue, portMAX_DELAY );
+    }
+
+    prvReport( "queue_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyEchoTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ( void ) xTaskNotifyGive( xRunnerTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkNotifyPingPong( void )
+{
+    unsigned long ul;
+    uint64_t ullStart;
+
+    ( void ) xTaskCreate( prvNotifyEchoTask, "NEcho", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, &xNotifyEchoTask );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ( void ) xTaskNotifyGive( xNotifyEchoTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    prvReport( "notify_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferEchoTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( xStreamBufferReceive( xPingStreamBuffer, &ulValue, sizeof( ulValue ), portMAX_DELAY ) == sizeof( ulValue ) )
+        {
+            ( void ) xStreamBufferSend( xPongStreamBuffer, &ulValue, sizeof( ulValue ), portMAX_DELAY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkStreamBufferPingPong( void )
+{
+    uint32_t ulValue;
+    unsigned long ul;
+    uint64_t ullStart;
+
+    xPingStreamBuffer = xStreamBufferCreate( 64, sizeof( uint32_t ) );
+    xPongStreamBuffer = xStreamBufferCreate( 64, sizeof( uint32_t ) );
+    ( void ) xTaskCreate( prvStreamBufferEchoTask, "SEcho", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, NULL );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ulValue = ( uint32_t ) ul;
+        ( void ) xStreamBufferSend( xPingStreamBuffer, &ulValue, sizeof( ulValue ), portMAX_DELAY );
+        ( void ) xStreamBufferReceive( xPongStreamBuffer, &ulValue, sizeof( ulValue ), portMAX_DELAY );
+    }
+
+    prvReport( "stream_buffer_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMutexTask( void * pvParameters )
+{
+    unsigned long ul;
+
+    ( void ) pvParameters;
+
+    /* Yield while holding the mutex, so the other tasks block on it, and after
+     * giving it, so it is handed to a task that was waiting. */
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+        taskYIELD();
+        ( void ) xSemaphoreGive( xMutex );
+        taskYIELD();
+    }
+
+    ( void ) xSemaphoreGive( xMutexTasksDone );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMutexContention( void )
+{
+    int i;
+    uint64_t ullStart;
+
+    xMutex = xSemaphoreCreateMutex();
+    xMutexTasksDone = xSemaphoreCreateCounting( benchMUTEX_TASKS, 0 );
+
+    ullStart = prvGetTimeNs();
+
+    /* Start all the tasks together. */
+    vTaskSuspendAll();
+    {
+        for( i = 0; i < benchMUTEX_TASKS; i++ )
+        {
+            ( void ) xTaskCreate( prvMutexTask, "Mutex", configMINIMAL_STACK_SIZE, NULL, benchPARTNER_PRIORITY, NULL );
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    for( i = 0; i < benchMUTEX_TASKS; i++ )
+    {
+        ( void ) xSemaphoreTake( xMutexTasksDone, portMAX_DELAY );
+    }
+
+    prvReport( "mutex_contention", ulIterations * benchMUTEX_TASKS, prvGetTimeNs() - ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMallocChurn( void )
+{
+    #if ( BENCHMARK_HEAP == 1 )
+    {
+        /* heap_1 cannot free memory. */
+        ( void ) printf( "{\"benchmark\":\"malloc_churn\",\"heap\":%d,\"skipped\":true}\n", BENCHMARK_HEAP );
+    }
+    #else
+    {
+        static void * pvSlots[ benchMALLOC_SLOTS ];
+        uint32_t ulRandom = 0x12345678UL;
+        unsigned long ul;
+        size_t xSlot;
+        size_t xSize;
+        uint64_t ullStart;
+
+        ullStart = prvGetTimeNs();
+
+        /* Allocate or free a random slot, using a fixed seed so every run
+         * performs the same sequence of operations. */
+        for( ul = 0; ul < ulIterations; ul++ )
+        {
+            ulRandom ^= ulRandom << 13;
+            ulRandom ^= ulRandom >> 17;
+            ulRandom ^= ulRandom << 5;
+
+            xSlot = ( size_t ) ( ulRandom % benchMALLOC_SLOTS );
+
+            if( pvSlots[ xSlot ] == NULL )
+            {
+                xSize = benchMALLOC_MIN_SIZE + ( size_t ) ( ( ulRandom >> 8 ) % ( benchMALLOC_MAX_SIZE - benchMALLOC_MIN_SIZE ) );
+                pvSlots[ xSlot ] = pvPortMalloc( xSize );
+                configASSERT( pvSlots[ xSlot ] != NULL );
+            }
+            else
+            {
+                vPortFree( pvSlots[ xSlot ] );
+                pvSlots[ xSlot ] = NULL;
+            }
+        }
+
+        prvReport( "malloc_churn", ulIterations, prvGetTimeNs() - ullStart );
+
+        for( xSlot = 0; xSlot < benchMALLOC_SLOTS; xSlot++ )
+        {
+            vPortFree( pvSlots[ xSlot ] );
+            pvSlots[ xSlot ] = NULL;
+        }
+    }
+    #endif /* if ( BENCHMARK_HEAP == 1 ) */
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTimerChurn( void )
+{
+    TimerHandle_t xTimers[ benchTIMERS ];
+    unsigned long ul;
+    int i;
+    uint64_t ullStart;
+
+    for( i = 0; i < benchTIMERS; i++ )
+    {
+        xTimers[ i ] = xTimerCreate( "Churn", pdMS_TO_TICKS( 1000 ), pdFALSE, NULL, prvTimerCallback );
+    }
+
+    ullStart = prvGetTimeNs();
+
+    /* Each command is processed by the higher priority timer task before the
+     * function that sends it returns. */
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        i = ( int ) ( ul % benchTIMERS );
+
+        if( ( ul & 1UL ) == 0UL )
+        {
+            ( void ) xTimerChangePeriod( xTimers[ i ], pdMS_TO_TICKS( 1000 ) + ( TickType_t ) i, portMAX_DELAY );
+        }
+        else
+        {
+            ( void ) xTimerStop( xTimers[ i ], portMAX_DELAY );
+        }
+    }
+
+    prvReport( "timer_churn", ulIterations, prvGetTimeNs() - ullStart );
+
+    for( i = 0; i < benchTIMERS; i++ )
+    {
+        ( void ) xTimerStop( xTimers[ i ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunnerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    ( void ) printf( "{\"kernel\":\"%s\",\"port\":\"GCC_POSIX\",\"cores\":%d,\"heap\":%d}\n",
+                     tskKERNEL_VERSION_NUMBER,
+                     configNUMBER_OF_CORES,
+                     BENCHMARK_HEAP );
+
+    prvBenchmarkYieldPingPong();
+    prvBenchmarkQueuePingPong();
+    prvBenchmarkNotifyPingPong();
+    prvBenchmarkStreamBufferPingPong();
+    prvBenchmarkMutexContention();
+    prvBenchmarkMallocChurn();
+    prvBenchmarkTimerChurn();
+
+    ( void ) fflush( stdout );
+    exit( EXIT_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    if( argc > 1 )
+    {
+        ulIterations = strtoul( argv[ 1 ], NULL, 0 );
+
+        if( ulIterations == 0UL )
+        {
+            ( void ) fprintf( stderr, "usage: %s [iterations]\n", argv[ 0 ] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    #if ( BENCHMARK_HEAP == 5 ) || ( BENCHMARK_HEAP == 6 )
+    {
+        static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+        const HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeap, sizeof( ucHeap ) },
+            { NULL,   0                }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+    #endif
+
+    ( void ) xTaskCreate( prvRunnerTask, "Runner", configMINIMAL_STACK_SIZE, NULL, benchRUNNER_PRIORITY, &xRunnerTask );
+
+    vTaskStartScheduler();
+
+    return EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
@@ -322,10 +322,64 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+/* Set configUSE_EVENT_GROUP_WAITER_INDEX to 1 to index the tasks waiting on an
+ * event group by the bits they are waiting for, so setting bits only evaluates
+ * the tasks that could be unblocked by those bits.  This adds a list for each
+ * event bit to every event group. */
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+    #define configUSE_EVENT_GROUP_WAITER_INDEX    0
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) && ( configUSE_EVENT_GROUPS != 1 ) )
+    #error configUSE_EVENT_GROUP_WAITER_INDEX is set to 1 but configUSE_EVENT_GROUPS is not set to 1.
+#endif
+
+/* Set configUSE_EVENT_GROUP_DIRECT_FROM_ISR to 1 to have
+ * xEventGroupSetBitsFromISR() and xEventGroupClearBitsFromISR() update the
+ * event group, and unblock any waiting tasks, from within the interrupt rather
+ * than deferring the operation to the timer service task.  The lists of tasks
+ * waiting on an event group are then accessed from critical sections, rather
+ * than only with the scheduler suspended. */
+#ifndef configUSE_EVENT_GROUP_DIRECT_FROM_ISR
+    #define configUSE_EVENT_GROUP_DIRECT_FROM_ISR    0
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) && ( configUSE_EVENT_GROUPS != 1 ) )
+    #error configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 but configUSE_EVENT_GROUPS is not set to 1.
+#endif
+
+/* Set configUSE_EVENT_GROUP_BITMAPS to 1 to add a bitmap of
+ * configEVENT_GROUP_BITMAP_BITS event bits to each event group.  The bitmap is
+ * accessed through the xEventGroup...Bitmap() API functions, and its width is
+ * independent of the width of TickType_t. */
+#ifndef configUSE_EVENT_GROUP_BITMAPS
+    #define configUSE_EVENT_GROUP_BITMAPS    0
+#endif
+
+#ifndef configEVENT_GROUP_BITMAP_BITS
+    #define configEVENT_GROUP_BITMAP_BITS    64
+#endif
+
+#if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+    #if ( configUSE_EVENT_GROUPS != 1 )
+        #error configUSE_EVENT_GROUP_BITMAPS is set to 1 but configUSE_EVENT_GROUPS is not set to 1.
+    #endif
+
+    #if ( configEVENT_GROUP_BITMAP_BITS < 1 )
+        #error configEVENT_GROUP_BITMAP_BITS must be at least 1.
+    #endif
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
 
+/* Set configUSE_MEMORY_POOLS to 1 to include the fixed-size block memory pool
+ * functionality (memory_pool.c) in the build. */
+#ifndef configUSE_MEMORY_POOLS
+    #define configUSE_MEMORY_POOLS    0
+#endif
+
 #ifndef configUSE_DAEMON_TASK_STARTUP_HOOK
     #define configUSE_DAEMON_TASK_STARTUP_HOOK    0
 #endif
@@ -533,6 +587,134 @@
 
 #endif /* configUSE_TIMERS */
 
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+    #if ( configUSE_TIMERS != 1 )
+        #error configUSE_TIMER_WHEEL is set to 1 but configUSE_TIMERS is not set to 1.
+    #endif
+
+/* Each level of the timer wheel has ( 1 << configTIMER_WHEEL_SLOT_BITS )
+ * slots, and each slot of a level covers as many ticks as the whole of the
+ * level below it. */
+    #ifndef configTIMER_WHEEL_SLOT_BITS
+        #define configTIMER_WHEEL_SLOT_BITS    5
+    #endif
+
+    #ifndef configTIMER_WHEEL_LEVELS
+        #define configTIMER_WHEEL_LEVELS    3
+    #endif
+
+    #if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 8 ) )
+        #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 8.
+    #endif
+
+    #if ( configTIMER_WHEEL_LEVELS < 1 )
+        #error configTIMER_WHEEL_LEVELS must be at least 1.
+    #endif
+
+#endif /* configUSE_TIMER_WHEEL */
+
+/* Set configUSE_TIMER_DIRECT_COMMANDS to 1 to have xTimerStart(), xTimerReset(),
+ * xTimerStop() and xTimerChangePeriod() update the active timers directly,
+ * with the scheduler suspended, when called from a task, rather than sending a
+ * command to the timer service task.  The timer service task is then only
+ * unblocked if the time at which it next needs to run changes. */
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+    #define configUSE_TIMER_DIRECT_COMMANDS    0
+#endif
+
+#if ( ( configUSE_TIMER_DIRECT_COMMANDS == 1 ) && ( configUSE_TIMERS != 1 ) )
+    #error configUSE_TIMER_DIRECT_COMMANDS is set to 1 but configUSE_TIMERS is not set to 1.
+#endif
+
+/* Set configUSE_PER_CORE_TIMER_TASKS to 1 to create a timer service task pinned
+ * to each core, each with its own active timers and timer queue, instead of a
+ * single timer service task. */
+#ifndef configUSE_PER_CORE_TIMER_TASKS
+    #define configUSE_PER_CORE_TIMER_TASKS    0
+#endif
+
+#if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+    #if ( configUSE_TIMERS != 1 )
+        #error configUSE_PER_CORE_TIMER_TASKS is set to 1 but configUSE_TIMERS is not set to 1.
+    #endif
+
+    #if ( ( configNUMBER_OF_CORES == 1 ) || ( configUSE_CORE_AFFINITY != 1 ) )
+        #error configUSE_PER_CORE_TIMER_TASKS requires configNUMBER_OF_CORES > 1 and configUSE_CORE_AFFINITY set to 1.
+    #endif
+#endif
+
+/* Set configUSE_TIMER_SLACK to 1 to allow timers created with
+ * xTimerCreateWithSlack() or xTimerCreateStaticWithSlack() to expire late by up
+ * to their slack, so the timer service task can process timers whose expiry
+ * windows overlap from a single wake-up. */
+#ifndef configUSE_TIMER_SLACK
+    #define configUSE_TIMER_SLACK    0
+#endif
+
+#if ( configUSE_TIMER_SLACK == 1 )
+    #if ( configUSE_TIMERS != 1 )
+        #error configUSE_TIMER_SLACK is set to 1 but configUSE_TIMERS is not set to 1.
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #error configUSE_TIMER_SLACK cannot be used with configUSE_TIMER_WHEEL as the timer wheel does not keep timers in expiry order.
+    #endif
+#endif
+
+/* Set configUSE_HIGH_RESOLUTION_TIMERS to 1 to include the high resolution
+ * timer API.  High resolution timers are one-shot timers that expire with the
+ * resolution of a hardware timer rather than that of the tick.  The port must
+ * provide the hardware timer by defining:
+ *
+ * portHR_TIMER_GET_COUNT() - returns the current count of a free running
+ * counter that increments portHR_TIMER_COUNTS_PER_SECOND times a second and
+ * wraps within portHR_TIMER_COUNT_TYPE.
+ *
+ * portHR_TIMER_SET_COMPARE( xCount ) - arms a one-shot compare that calls
+ * xHRTimerInterruptHandler() from an interrupt when the counter reaches xCount.
+ * The interrupt must still occur if the counter has already reached xCount.
+ *
+ * portHR_TIMER_CANCEL_COMPARE() - disarms the compare.
+ *
+ * portHR_TIMER_COUNT_TYPE can be defined to the type of the counter, otherwise
+ * it defaults to uint32_t. */
+#ifndef configUSE_HIGH_RESOLUTION_TIMERS
+    #define configUSE_HIGH_RESOLUTION_TIMERS    0
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    #if ( configUSE_TIMERS != 1 )
+        #error configUSE_HIGH_RESOLUTION_TIMERS is set to 1 but configUSE_TIMERS is not set to 1.
+    #endif
+
+    #if ( defined( configUSE_TASK_NOTIFICATIONS ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+        #error configUSE_HIGH_RESOLUTION_TIMERS is set to 1 but configUSE_TASK_NOTIFICATIONS is set to 0.
+    #endif
+
+    #if ( !defined( portHR_TIMER_GET_COUNT ) || !defined( portHR_TIMER_SET_COMPARE ) || !defined( portHR_TIMER_CANCEL_COMPARE ) || !defined( portHR_TIMER_COUNTS_PER_SECOND ) )
+        #error configUSE_HIGH_RESOLUTION_TIMERS is set to 1 but the port does not provide a high resolution timer.
+    #endif
+
+    #ifndef portHR_TIMER_COUNT_TYPE
+        #define portHR_TIMER_COUNT_TYPE    uint32_t
+    #endif
+
+/* The priority and stack depth of the task that executes the callbacks of high
+ * resolution timers that do not execute their callbacks from the interrupt. */
+    #ifndef configHR_TIMER_TASK_PRIORITY
+        #define configHR_TIMER_TASK_PRIORITY    ( configMAX_PRIORITIES - 1 )
+    #endif
+
+    #ifndef configHR_TIMER_TASK_STACK_DEPTH
+        #define configHR_TIMER_TASK_STACK_DEPTH    configTIMER_TASK_STACK_DEPTH
+    #endif
+#endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 #ifndef portHAS_NESTED_INTERRUPTS
     #if defined( portSET_INTERRUPT_MASK_FROM_ISR ) && defined( portCLEAR_INTERRUPT_MASK_FROM_ISR )
         #define portHAS_NESTED_INTERRUPTS    1
@@ -595,10 +777,47 @@
     #define configUSE_MINI_LIST_ITEM    1
 #endif
 
+#ifndef configUSE_ORDERED_LIST_TREE
+
+/* Set to 1 to index items placed in a list by vListInsert() with a red-black
+ * tree, making the insertion position search O(log n) rather than O(n). */
+    #define configUSE_ORDERED_LIST_TREE    0
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+/* Set configUSE_TRACE_RECORDER to 1 to include the built-in trace recorder
+ * (trace_recorder.c) in the build.  The recorder defines any trace macros that
+ * are not already defined in FreeRTOSConfig.h. */
+#ifndef configUSE_TRACE_RECORDER
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* The number of events held by the trace recorder for each core.  Must be a
+ * power of 2.  Each event uses 16 bytes on targets with pointers of up to 32
+ * bits, and 24 bytes on targets with 64-bit pointers. */
+    #ifndef configTRACE_RECORDER_BUFFER_EVENTS
+        #define configTRACE_RECORDER_BUFFER_EVENTS    1024
+    #endif
+
+    #if ( ( configTRACE_RECORDER_BUFFER_EVENTS < 1 ) || ( ( configTRACE_RECORDER_BUFFER_EVENTS & ( configTRACE_RECORDER_BUFFER_EVENTS - 1 ) ) != 0 ) )
+        #error configTRACE_RECORDER_BUFFER_EVENTS must be a power of 2
+    #endif
+
+/* The number of task, queue and timer names held by the trace recorder.  Names
+ * are held separately from the events so they are not overwritten when the
+ * event buffers wrap. */
+    #ifndef configTRACE_RECORDER_OBJECT_NAMES
+        #define configTRACE_RECORDER_OBJECT_NAMES    64
+    #endif
+
+    #include "trace_recorder.h"
+#endif /* configUSE_TRACE_RECORDER */
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -936,6 +1155,46 @@
     #define traceEVENT_GROUP_DELETE( xEventGroup )
 #endif
 
+#ifndef traceMEMORY_POOL_CREATE
+    #define traceMEMORY_POOL_CREATE( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+    #define traceMEMORY_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE
+    #define traceMEMORY_POOL_ALLOCATE( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_BLOCK
+    #define traceMEMORY_POOL_ALLOCATE_BLOCK( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_FAILED
+    #define traceMEMORY_POOL_ALLOCATE_FAILED( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_FROM_ISR
+    #define traceMEMORY_POOL_ALLOCATE_FROM_ISR( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_FROM_ISR_FAILED
+    #define traceMEMORY_POOL_ALLOCATE_FROM_ISR_FAILED( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+    #define traceMEMORY_POOL_FREE( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE_FROM_ISR
+    #define traceMEMORY_POOL_FREE_FROM_ISR( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+    #define traceMEMORY_POOL_DELETE( pxMemoryPool )
+#endif
+
 #ifndef tracePEND_FUNC_CALL
     #define tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, ret )
 #endif
@@ -1116,6 +1375,46 @@
     #define traceRETURN_vEventGroupDelete()
 #endif
 
+#ifndef traceENTER_vEventGroupSetBitmap
+    #define traceENTER_vEventGroupSetBitmap( xEventGroup, pxBitsToSet, pxEventBitmap )
+#endif
+
+#ifndef traceRETURN_vEventGroupSetBitmap
+    #define traceRETURN_vEventGroupSetBitmap()
+#endif
+
+#ifndef traceENTER_vEventGroupClearBitmap
+    #define traceENTER_vEventGroupClearBitmap( xEventGroup, pxBitsToClear, pxEventBitmap )
+#endif
+
+#ifndef traceRETURN_vEventGroupClearBitmap
+    #define traceRETURN_vEventGroupClearBitmap()
+#endif
+
+#ifndef traceENTER_vEventGroupGetBitmap
+    #define traceENTER_vEventGroupGetBitmap( xEventGroup, pxEventBitmap )
+#endif
+
+#ifndef traceRETURN_vEventGroupGetBitmap
+    #define traceRETURN_vEventGroupGetBitmap()
+#endif
+
+#ifndef traceENTER_xEventGroupWaitBitmap
+    #define traceENTER_xEventGroupWaitBitmap( xEventGroup, pxBitsToWaitFor, xClearOnExit, xWaitForAllBits, pxEventBitmap, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xEventGroupWaitBitmap
+    #define traceRETURN_xEventGroupWaitBitmap( xReturn )
+#endif
+
+#ifndef traceENTER_xEventGroupSyncBitmap
+    #define traceENTER_xEventGroupSyncBitmap( xEventGroup, pxBitsToSet, pxBitsToWaitFor, pxEventBitmap, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xEventGroupSyncBitmap
+    #define traceRETURN_xEventGroupSyncBitmap( xReturn )
+#endif
+
 #ifndef traceENTER_xEventGroupGetStaticBuffer
     #define traceENTER_xEventGroupGetStaticBuffer( xEventGroup, ppxEventGroupBuffer )
 #endif
@@ -1540,6 +1839,38 @@
     #define traceRETURN_xTimerCreateStatic( pxNewTimer )
 #endif
 
+#ifndef traceENTER_xTimerCreateWithSlack
+    #define traceENTER_xTimerCreateWithSlack( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, xTimerSlack )
+#endif
+
+#ifndef traceRETURN_xTimerCreateWithSlack
+    #define traceRETURN_xTimerCreateWithSlack( pxNewTimer )
+#endif
+
+#ifndef traceENTER_xTimerCreateStaticWithSlack
+    #define traceENTER_xTimerCreateStaticWithSlack( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, xTimerSlack, pxTimerBuffer )
+#endif
+
+#ifndef traceRETURN_xTimerCreateStaticWithSlack
+    #define traceRETURN_xTimerCreateStaticWithSlack( pxNewTimer )
+#endif
+
+#ifndef traceENTER_xTimerGetSlack
+    #define traceENTER_xTimerGetSlack( xTimer )
+#endif
+
+#ifndef traceRETURN_xTimerGetSlack
+    #define traceRETURN_xTimerGetSlack( xTimerSlack )
+#endif
+
+#ifndef traceENTER_ulTimerGetCoalescedWakeCount
+    #define traceENTER_ulTimerGetCoalescedWakeCount()
+#endif
+
+#ifndef traceRETURN_ulTimerGetCoalescedWakeCount
+    #define traceRETURN_ulTimerGetCoalescedWakeCount( ulCoalescedWakeCount )
+#endif
+
 #ifndef traceENTER_xTimerGenericCommandFromTask
     #define traceENTER_xTimerGenericCommandFromTask( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait )
 #endif
@@ -1580,6 +1911,22 @@
     #define traceRETURN_vTimerSetReloadMode()
 #endif
 
+#ifndef traceENTER_vTimerSetCoreID
+    #define traceENTER_vTimerSetCoreID( xTimer, xCoreID )
+#endif
+
+#ifndef traceRETURN_vTimerSetCoreID
+    #define traceRETURN_vTimerSetCoreID()
+#endif
+
+#ifndef traceENTER_xTimerGetCoreID
+    #define traceENTER_xTimerGetCoreID( xTimer )
+#endif
+
+#ifndef traceRETURN_xTimerGetCoreID
+    #define traceRETURN_xTimerGetCoreID( xCoreID )
+#endif
+
 #ifndef traceENTER_xTimerGetReloadMode
     #define traceENTER_xTimerGetReloadMode( xTimer )
 #endif
@@ -1676,6 +2023,94 @@
     #define traceRETURN_vTimerSetTimerNumber()
 #endif
 
+#ifndef traceENTER_xHRTimerCreate
+    #define traceENTER_xHRTimerCreate( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction )
+#endif
+
+#ifndef traceRETURN_xHRTimerCreate
+    #define traceRETURN_xHRTimerCreate( pxNewTimer )
+#endif
+
+#ifndef traceENTER_xHRTimerCreateStatic
+    #define traceENTER_xHRTimerCreateStatic( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction, pxTimerBuffer )
+#endif
+
+#ifndef traceRETURN_xHRTimerCreateStatic
+    #define traceRETURN_xHRTimerCreateStatic( pxNewTimer )
+#endif
+
+#ifndef traceENTER_vHRTimerDelete
+    #define traceENTER_vHRTimerDelete( xTimer )
+#endif
+
+#ifndef traceRETURN_vHRTimerDelete
+    #define traceRETURN_vHRTimerDelete()
+#endif
+
+#ifndef traceENTER_xHRTimerStart
+    #define traceENTER_xHRTimerStart( xTimer, xDelay )
+#endif
+
+#ifndef traceRETURN_xHRTimerStart
+    #define traceRETURN_xHRTimerStart( xReturn )
+#endif
+
+#ifndef traceENTER_xHRTimerStartFromISR
+    #define traceENTER_xHRTimerStartFromISR( xTimer, xDelay )
+#endif
+
+#ifndef traceRETURN_xHRTimerStartFromISR
+    #define traceRETURN_xHRTimerStartFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xHRTimerStop
+    #define traceENTER_xHRTimerStop( xTimer )
+#endif
+
+#ifndef traceRETURN_xHRTimerStop
+    #define traceRETURN_xHRTimerStop( xReturn )
+#endif
+
+#ifndef traceENTER_xHRTimerStopFromISR
+    #define traceENTER_xHRTimerStopFromISR( xTimer )
+#endif
+
+#ifndef traceRETURN_xHRTimerStopFromISR
+    #define traceRETURN_xHRTimerStopFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xHRTimerIsTimerActive
+    #define traceENTER_xHRTimerIsTimerActive( xTimer )
+#endif
+
+#ifndef traceRETURN_xHRTimerIsTimerActive
+    #define traceRETURN_xHRTimerIsTimerActive( xReturn )
+#endif
+
+#ifndef traceENTER_pvHRTimerGetTimerID
+    #define traceENTER_pvHRTimerGetTimerID( xTimer )
+#endif
+
+#ifndef traceRETURN_pvHRTimerGetTimerID
+    #define traceRETURN_pvHRTimerGetTimerID( pvTimerID )
+#endif
+
+#ifndef traceENTER_xHRTimerGetCount
+    #define traceENTER_xHRTimerGetCount()
+#endif
+
+#ifndef traceRETURN_xHRTimerGetCount
+    #define traceRETURN_xHRTimerGetCount( xCount )
+#endif
+
+#ifndef traceENTER_xHRTimerInterruptHandler
+    #define traceENTER_xHRTimerInterruptHandler()
+#endif
+
+#ifndef traceRETURN_xHRTimerInterruptHandler
+    #define traceRETURN_xHRTimerInterruptHandler( xHigherPriorityTaskWoken )
+#endif
+
 #ifndef traceENTER_xTaskCreateStatic
     #define traceENTER_xTaskCreateStatic( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer )
 #endif
@@ -1956,6 +2391,22 @@
     #define traceRETURN_uxTaskGetSystemState( uxTask )
 #endif
 
+#ifndef traceENTER_vTaskGetSchedulingLatency
+    #define traceENTER_vTaskGetSchedulingLatency( xTask, pxSchedulingLatency )
+#endif
+
+#ifndef traceRETURN_vTaskGetSchedulingLatency
+    #define traceRETURN_vTaskGetSchedulingLatency()
+#endif
+
+#ifndef traceENTER_vTaskResetSchedulingLatency
+    #define traceENTER_vTaskResetSchedulingLatency( xTask )
+#endif
+
+#ifndef traceRETURN_vTaskResetSchedulingLatency
+    #define traceRETURN_vTaskResetSchedulingLatency()
+#endif
+
 #if ( configNUMBER_OF_CORES == 1 )
     #ifndef traceENTER_xTaskGetIdleTaskHandle
         #define traceENTER_xTaskGetIdleTaskHandle()
@@ -2088,6 +2539,14 @@
     #define traceRETURN_vTaskRemoveFromUnorderedEventList()
 #endif
 
+#ifndef traceENTER_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue )
+#endif
+
+#ifndef traceRETURN_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskSetTimeOutState
     #define traceENTER_vTaskSetTimeOutState( pxTimeOut )
 #endif
@@ -2160,6 +2619,22 @@
     #define traceRETURN_pvTaskGetThreadLocalStoragePointer( pvReturn )
 #endif
 
+#ifndef traceENTER_pvTaskArenaAlloc
+    #define traceENTER_pvTaskArenaAlloc( xWantedSize )
+#endif
+
+#ifndef traceRETURN_pvTaskArenaAlloc
+    #define traceRETURN_pvTaskArenaAlloc( pvReturn )
+#endif
+
+#ifndef traceENTER_vTaskArenaReset
+    #define traceENTER_vTaskArenaReset()
+#endif
+
+#ifndef traceRETURN_vTaskArenaReset
+    #define traceRETURN_vTaskArenaReset()
+#endif
+
 #ifndef traceENTER_vTaskAllocateMPURegions
     #define traceENTER_vTaskAllocateMPURegions( xTaskToModify, pxRegions )
 #endif
@@ -2304,6 +2779,14 @@
     #define traceRETURN_uxTaskResetEventItemValue( uxReturn )
 #endif
 
+#ifndef traceENTER_pxTaskGetEventListItem
+    #define traceENTER_pxTaskGetEventListItem()
+#endif
+
+#ifndef traceRETURN_pxTaskGetEventListItem
+    #define traceRETURN_pxTaskGetEventListItem( pxEventListItem )
+#endif
+
 #ifndef traceENTER_pvTaskIncrementMutexHeldCount
     #define traceENTER_pvTaskIncrementMutexHeldCount()
 #endif
@@ -2552,6 +3035,46 @@
     #define traceRETURN_xStreamBufferReceiveCompletedFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_pvStreamBufferGetPingPongWriteBlock
+    #define traceENTER_pvStreamBufferGetPingPongWriteBlock( xStreamBuffer )
+#endif
+
+#ifndef traceRETURN_pvStreamBufferGetPingPongWriteBlock
+    #define traceRETURN_pvStreamBufferGetPingPongWriteBlock( pvReturn )
+#endif
+
+#ifndef traceENTER_pvStreamBufferSwapPingPongBlock
+    #define traceENTER_pvStreamBufferSwapPingPongBlock( xStreamBuffer )
+#endif
+
+#ifndef traceRETURN_pvStreamBufferSwapPingPongBlock
+    #define traceRETURN_pvStreamBufferSwapPingPongBlock( pvReturn )
+#endif
+
+#ifndef traceENTER_pvStreamBufferSwapPingPongBlockFromISR
+    #define traceENTER_pvStreamBufferSwapPingPongBlockFromISR( xStreamBuffer, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_pvStreamBufferSwapPingPongBlockFromISR
+    #define traceRETURN_pvStreamBufferSwapPingPongBlockFromISR( pvReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceivePingPongBlock
+    #define traceENTER_xStreamBufferReceivePingPongBlock( xStreamBuffer, ppvBlock, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceivePingPongBlock
+    #define traceRETURN_xStreamBufferReceivePingPongBlock( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferReleasePingPongBlock
+    #define traceENTER_vStreamBufferReleasePingPongBlock( xStreamBuffer )
+#endif
+
+#ifndef traceRETURN_vStreamBufferReleasePingPongBlock
+    #define traceRETURN_vStreamBufferReleasePingPongBlock()
+#endif
+
 #ifndef traceENTER_uxStreamBufferGetStreamBufferNotificationIndex
     #define traceENTER_uxStreamBufferGetStreamBufferNotificationIndex( xStreamBuffer )
 #endif
@@ -2632,6 +3155,14 @@
     #define traceRETURN_uxListRemove( uxNumberOfItems )
 #endif
 
+#ifndef traceENTER_vListTreeRemove
+    #define traceENTER_vListTreeRemove( pxList, pxItemToRemove )
+#endif
+
+#ifndef traceRETURN_vListTreeRemove
+    #define traceRETURN_vListTreeRemove()
+#endif
+
 #ifndef traceENTER_xCoRoutineCreate
     #define traceENTER_xCoRoutineCreate( pxCoRoutineCode, uxPriority, uxIndex )
 #endif
@@ -2664,6 +3195,118 @@
     #define traceRETURN_xCoRoutineRemoveFromEventList( xReturn )
 #endif
 
+#ifndef traceENTER_xMemoryPoolCreate
+    #define traceENTER_xMemoryPoolCreate( uxNumberOfBlocks, xBlockSize )
+#endif
+
+#ifndef traceRETURN_xMemoryPoolCreate
+    #define traceRETURN_xMemoryPoolCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xMemoryPoolCreateStatic
+    #define traceENTER_xMemoryPoolCreateStatic( uxNumberOfBlocks, xBlockSize, pucPoolStorageBuffer, pxStaticMemoryPool )
+#endif
+
+#ifndef traceRETURN_xMemoryPoolCreateStatic
+    #define traceRETURN_xMemoryPoolCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_pvMemoryPoolAllocate
+    #define traceENTER_pvMemoryPoolAllocate( xMemoryPool, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_pvMemoryPoolAllocate
+    #define traceRETURN_pvMemoryPoolAllocate( pvReturn )
+#endif
+
+#ifndef traceENTER_pvMemoryPoolAllocateFromISR
+    #define traceENTER_pvMemoryPoolAllocateFromISR( xMemoryPool )
+#endif
+
+#ifndef traceRETURN_pvMemoryPoolAllocateFromISR
+    #define traceRETURN_pvMemoryPoolAllocateFromISR( pvReturn )
+#endif
+
+#ifndef traceENTER_vMemoryPoolFree
+    #define traceENTER_vMemoryPoolFree( xMemoryPool, pvBlock )
+#endif
+
+#ifndef traceRETURN_vMemoryPoolFree
+    #define traceRETURN_vMemoryPoolFree()
+#endif
+
+#ifndef traceENTER_vMemoryPoolFreeFromISR
+    #define traceENTER_vMemoryPoolFreeFromISR( xMemoryPool, pvBlock, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vMemoryPoolFreeFromISR
+    #define traceRETURN_vMemoryPoolFreeFromISR()
+#endif
+
+#ifndef traceENTER_uxMemoryPoolGetFreeBlocks
+    #define traceENTER_uxMemoryPoolGetFreeBlocks( xMemoryPool )
+#endif
+
+#ifndef traceRETURN_uxMemoryPoolGetFreeBlocks
+    #define traceRETURN_uxMemoryPoolGetFreeBlocks( uxReturn )
+#endif
+
+#ifndef traceENTER_uxMemoryPoolGetHighWaterMark
+    #define traceENTER_uxMemoryPoolGetHighWaterMark( xMemoryPool )
+#endif
+
+#ifndef traceRETURN_uxMemoryPoolGetHighWaterMark
+    #define traceRETURN_uxMemoryPoolGetHighWaterMark( uxReturn )
+#endif
+
+#ifndef traceENTER_vMemoryPoolDelete
+    #define traceENTER_vMemoryPoolDelete( xMemoryPool )
+#endif
+
+#ifndef traceRETURN_vMemoryPoolDelete
+    #define traceRETURN_vMemoryPoolDelete()
+#endif
+
+#ifndef traceENTER_vTraceRecorderStart
+    #define traceENTER_vTraceRecorderStart()
+#endif
+
+#ifndef traceRETURN_vTraceRecorderStart
+    #define traceRETURN_vTraceRecorderStart()
+#endif
+
+#ifndef traceENTER_vTraceRecorderStop
+    #define traceENTER_vTraceRecorderStop()
+#endif
+
+#ifndef traceRETURN_vTraceRecorderStop
+    #define traceRETURN_vTraceRecorderStop()
+#endif
+
+#ifndef traceENTER_vTraceRecorderClear
+    #define traceENTER_vTraceRecorderClear()
+#endif
+
+#ifndef traceRETURN_vTraceRecorderClear
+    #define traceRETURN_vTraceRecorderClear()
+#endif
+
+#ifndef traceENTER_vTraceRecorderUserEvent
+    #define traceENTER_vTraceRecorderUserEvent( ulEventID, ulValue )
+#endif
+
+#ifndef traceRETURN_vTraceRecorderUserEvent
+    #define traceRETURN_vTraceRecorderUserEvent()
+#endif
+
+#ifndef traceENTER_vTraceRecorderDump
+    #define traceENTER_vTraceRecorderDump( pxWriteFunction, pvContext )
+#endif
+
+#ifndef traceRETURN_vTraceRecorderDump
+    #define traceRETURN_vTraceRecorderDump()
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -2682,6 +3325,42 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+/* Set configUSE_SCHEDULING_LATENCY_STATS to 1 to keep a histogram for each
+ * task of the time from the task being made ready to it running, measured with
+ * configSCHEDULING_LATENCY_TIMESTAMP(). */
+#ifndef configUSE_SCHEDULING_LATENCY_STATS
+    #define configUSE_SCHEDULING_LATENCY_STATS    0
+#endif
+
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configUSE_SCHEDULING_LATENCY_STATS is set to 1 but configGENERATE_RUN_TIME_STATS is not set to 1.
+    #endif
+
+/* The number of buckets in each task's scheduling latency histogram.  Bucket 0
+ * counts latencies of 0, bucket n counts latencies from 2^(n-1) to 2^n - 1 and
+ * the last bucket also counts all longer latencies. */
+    #ifndef configSCHEDULING_LATENCY_BUCKETS
+        #define configSCHEDULING_LATENCY_BUCKETS    16
+    #endif
+
+    #if ( configSCHEDULING_LATENCY_BUCKETS < 2 )
+        #error configSCHEDULING_LATENCY_BUCKETS must be at least 2
+    #endif
+
+/* Scheduling latencies are far shorter than a tick, so are measured with the
+ * port's high resolution timer when the port provides one.  Otherwise they are
+ * measured with the run time stats counter, which on many ports, including the
+ * POSIX port, counts too slowly to measure them.  Define
+ * configSCHEDULING_LATENCY_TIMESTAMP() to return the count of a faster free
+ * running counter to use that instead. */
+    #ifndef configSCHEDULING_LATENCY_TIMESTAMP
+        #ifdef portHR_TIMER_GET_COUNT
+            #define configSCHEDULING_LATENCY_TIMESTAMP()    portHR_TIMER_GET_COUNT()
+        #endif
+    #endif
+#endif /* configUSE_SCHEDULING_LATENCY_STATS */
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -2698,6 +3377,13 @@
     #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
 
+/* Called by the idle task on each iteration of its loop, before any tickless
+ * idle processing.  Ports that simulate time, rather than generate the tick
+ * from a hardware timer, can use it to advance the tick count. */
+#ifndef portIDLE_TASK_HOOK
+    #define portIDLE_TASK_HOOK()
+#endif
+
 #ifndef configEXPECTED_IDLE_TIME_BEFORE_SLEEP
     #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
 #endif
@@ -2798,6 +3484,17 @@
     #define configUSE_POSIX_ERRNO    0
 #endif
 
+#ifndef configUSE_TASK_ARENAS
+    #define configUSE_TASK_ARENAS    0
+#endif
+
+#ifndef configTASK_ARENA_CHUNK_SIZE
+
+/* The number of bytes requested from the heap each time a task's arena needs
+ * more space.  Requests larger than this get a chunk of their own. */
+    #define configTASK_ARENA_CHUNK_SIZE    256U
+#endif
+
 #ifndef configUSE_SB_COMPLETED_CALLBACK
 
 /* By default per-instance callbacks are not enabled for stream buffer or message buffer. */
@@ -2822,6 +3519,10 @@
     #define configSUPPORT_DYNAMIC_ALLOCATION    1
 #endif
 
+#if ( ( configUSE_TASK_ARENAS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use task arenas
+#endif
+
 #if ( ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
     #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
 #endif
@@ -3095,6 +3796,10 @@ struct xSTATIC_LIST_ITEM
     #endif
     TickType_t xDummy2;
     void * pvDummy3[ 4 ];
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+        void * pvDummy5[ 3 ];
+        UBaseType_t uxDummy6;
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy4;
     #endif
@@ -3125,6 +3830,9 @@ typedef struct xSTATIC_LIST
     UBaseType_t uxDummy2;
     void * pvDummy3;
     StaticMiniListItem_t xDummy4;
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+        void * pvDummy6;
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy5;
     #endif
@@ -3201,6 +3909,14 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_TASK_ARENAS == 1 )
+        void * pvDummy27;
+    #endif
+    #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy28[ 2 ];
+        uint32_t ulDummy29[ configSCHEDULING_LATENCY_BUCKETS ];
+        uint8_t ucDummy30;
+    #endif
 } StaticTask_t;
 
 /*
@@ -3265,6 +3981,17 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        TickType_t xDummy5;
+        StaticList_t xDummy6[ ( sizeof( TickType_t ) * ( size_t ) 8 ) - ( size_t ) 8 ];
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+        StaticList_t xDummy7;
+        uint32_t ulDummy8[ ( ( configEVENT_GROUP_BITMAP_BITS ) + 31 ) / 32 ];
+        void * pvDummy9;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -3299,8 +4026,46 @@ typedef struct xSTATIC_TIMER
         UBaseType_t uxDummy7;
     #endif
     uint8_t ucDummy8;
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        BaseType_t xDummy9;
+    #endif
+    #if ( configUSE_TIMER_SLACK == 1 )
+        TickType_t xDummy10;
+    #endif
 } StaticTimer_t;
 
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/*
+ * The count of the hardware timer used by high resolution timers.
+ */
+    typedef portHR_TIMER_COUNT_TYPE HRTimerCount_t;
+
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the high resolution timer structure
+ * used internally by FreeRTOS is not accessible to application code.  However,
+ * if the application writer wants to statically allocate the memory required
+ * to create a high resolution timer then the size of the timer object needs to
+ * be known.  The StaticHRTimer_t structure below is provided for this purpose.
+ * Its size and alignment requirements are guaranteed to match those of the
+ * genuine structure, no matter which architecture is being used, and no matter
+ * how the values in FreeRTOSConfig.h are set.  Its contents are somewhat
+ * obfuscated in the hope users will recognise that it would be unwise to make
+ * direct use of the structure members.
+ */
+    typedef struct xSTATIC_HR_TIMER
+    {
+        void * pvDummy1[ 3 ];
+        HRTimerCount_t xDummy2;
+        void * pvDummy3;
+        TaskFunction_t pvDummy4;
+        uint8_t ucDummy5;
+    } StaticHRTimer_t;
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3332,6 +4097,26 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real memory pool structure is not accessible to
+ * the application.  StaticMemoryPool_t is provided so the application writer
+ * can statically allocate the memory required to create a memory pool.  Its
+ * size and alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.
+ */
+typedef struct xSTATIC_MEMORY_POOL
+{
+    void * pvDummy1[ 3 ];
+    size_t xDummy2;
+    UBaseType_t uxDummy3[ 4 ];
+    StaticList_t xDummy4;
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy5;
+    #endif
+} StaticMemoryPool_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
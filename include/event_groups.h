@@ -112,6 +112,32 @@ typedef struct EventGroupDef_t   * EventGroupHandle_t;
  */
 typedef TickType_t               EventBits_t;
 
+#if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+/*
+ * The type that holds the event bits accessed through the
+ * xEventGroup...Bitmap() API functions.  It holds configEVENT_GROUP_BITMAP_BITS
+ * bits in an array of 32-bit words, bit n being held in bit ( n % 32 ) of word
+ * ( n / 32 ).  Use the eventBITMAP_...() macros to access individual bits.  An
+ * EventBitmap_t can be initialised to all bits clear with { { 0 } }.
+ *
+ * \defgroup EventBitmap_t EventBitmap_t
+ * \ingroup EventGroup
+ */
+    #define eventBITMAP_BITS_PER_WORD    ( 32U )
+    #define eventBITMAP_WORDS            ( ( ( uint32_t ) ( configEVENT_GROUP_BITMAP_BITS ) + ( eventBITMAP_BITS_PER_WORD - 1U ) ) / eventBITMAP_BITS_PER_WORD )
+
+    typedef struct EventBitmap
+    {
+        uint32_t ulWords[ eventBITMAP_WORDS ];
+    } EventBitmap_t;
+
+    #define eventBITMAP_SET_BIT( pxBitmap, uxBit )       ( ( pxBitmap )->ulWords[ ( uxBit ) / eventBITMAP_BITS_PER_WORD ] |= ( ( uint32_t ) 1U << ( ( uxBit ) % eventBITMAP_BITS_PER_WORD ) ) )
+    #define eventBITMAP_CLEAR_BIT( pxBitmap, uxBit )     ( ( pxBitmap )->ulWords[ ( uxBit ) / eventBITMAP_BITS_PER_WORD ] &= ~( ( uint32_t ) 1U << ( ( uxBit ) % eventBITMAP_BITS_PER_WORD ) ) )
+    #define eventBITMAP_IS_BIT_SET( pxBitmap, uxBit )    ( ( ( pxBitmap )->ulWords[ ( uxBit ) / eventBITMAP_BITS_PER_WORD ] & ( ( uint32_t ) 1U << ( ( uxBit ) % eventBITMAP_BITS_PER_WORD ) ) ) != 0U )
+
+#endif /* configUSE_EVENT_GROUP_BITMAPS */
+
 /**
  * event_groups.h
  * @code{c}
@@ -410,6 +436,11 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h then
+ * event groups are also protected by critical sections, and the bits are
+ * cleared directly from within the interrupt.  pdPASS is then always returned
+ * and it is not necessary to yield.
+ *
  * @note If this function returns pdPASS then the timer task is ready to run
  * and a portYIELD_FROM_ISR(pdTRUE) should be executed to perform the needed
  * clear on the event group.  This behavior is different from
@@ -452,7 +483,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) )
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
@@ -554,6 +585,14 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is set to 1 in FreeRTOSConfig.h then
+ * event groups are also protected by critical sections, and the bits are set
+ * directly from within the interrupt.  The tasks waiting on the event group
+ * are then evaluated and unblocked by xEventGroupSetBitsFromISR() itself, so
+ * neither configUSE_TIMERS nor INCLUDE_xTimerPendFunctionCall is required.
+ * Interrupts are masked while the waiting tasks are evaluated, so the time
+ * taken depends on the number of tasks waiting on the event group.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -568,11 +607,14 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * xEventGroupSetBitsFromISR(), indicating that a context switch should be
  * requested before the interrupt exits.  For that reason
  * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.  See the
- * example code below.
+ * example code below.  If configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1 then
+ * *pxHigherPriorityTaskWoken is instead set to pdTRUE if a task unblocked by
+ * the bits being set has a priority higher than the interrupted task.
  *
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * if the timer service queue was full.  pdPASS is always returned if
+ * configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1.
  *
  * Example usage:
  * @code{c}
@@ -610,7 +652,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -810,6 +852,157 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup ) PRIVILEG
  */
 void vEventGroupDelete( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+/**
+ * event_groups.h
+ * @code{c}
+ *  void vEventGroupSetBitmap( EventGroupHandle_t xEventGroup,
+ *                             const EventBitmap_t * pxBitsToSet,
+ *                             EventBitmap_t * pxEventBitmap );
+ * @endcode
+ *
+ * A version of xEventGroupSetBits() that sets bits in the event group's
+ * bitmap.  Each event group holds a bitmap of configEVENT_GROUP_BITMAP_BITS
+ * bits in addition to the bits accessed through the EventBits_t API functions,
+ * so the number of events an event group can convey is not limited by the
+ * width of TickType_t.  The bits of the bitmap are independent of the bits
+ * accessed through the EventBits_t API functions.
+ *
+ * Setting bits will automatically unblock tasks that are blocked in
+ * xEventGroupWaitBitmap() or xEventGroupSyncBitmap() waiting for the bits.
+ *
+ * This function cannot be called from an interrupt.
+ *
+ * configUSE_EVENT_GROUP_BITMAPS must be set to 1 in FreeRTOSConfig.h for the
+ * bitmap API functions to be available.
+ *
+ * @param xEventGroup The event group in which the bits are to be set.
+ *
+ * @param pxBitsToSet The bits to set.
+ *
+ * @param pxEventBitmap If not NULL, used to return the value of the bitmap
+ * after the bits were set.  As for xEventGroupSetBits(), bits may already have
+ * been cleared again by tasks that were unblocked and had requested the bits
+ * be cleared on exit.
+ *
+ * \defgroup vEventGroupSetBitmap vEventGroupSetBitmap
+ * \ingroup EventGroup
+ */
+    void vEventGroupSetBitmap( EventGroupHandle_t xEventGroup,
+                               const EventBitmap_t * pxBitsToSet,
+                               EventBitmap_t * pxEventBitmap ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ *  void vEventGroupClearBitmap( EventGroupHandle_t xEventGroup,
+ *                               const EventBitmap_t * pxBitsToClear,
+ *                               EventBitmap_t * pxEventBitmap );
+ * @endcode
+ *
+ * A version of xEventGroupClearBits() that clears bits in the event group's
+ * bitmap.  This function cannot be called from an interrupt.
+ *
+ * @param xEventGroup The event group in which the bits are to be cleared.
+ *
+ * @param pxBitsToClear The bits to clear.
+ *
+ * @param pxEventBitmap If not NULL, used to return the value of the bitmap
+ * before the bits were cleared.
+ *
+ * \defgroup vEventGroupClearBitmap vEventGroupClearBitmap
+ * \ingroup EventGroup
+ */
+    void vEventGroupClearBitmap( EventGroupHandle_t xEventGroup,
+                                 const EventBitmap_t * pxBitsToClear,
+                                 EventBitmap_t * pxEventBitmap ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ *  void vEventGroupGetBitmap( EventGroupHandle_t xEventGroup,
+ *                             EventBitmap_t * pxEventBitmap );
+ * @endcode
+ *
+ * Returns the current value of the event group's bitmap in *pxEventBitmap.
+ * This function cannot be called from an interrupt.
+ *
+ * \defgroup vEventGroupGetBitmap vEventGroupGetBitmap
+ * \ingroup EventGroup
+ */
+    void vEventGroupGetBitmap( EventGroupHandle_t xEventGroup,
+                               EventBitmap_t * pxEventBitmap ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ *  BaseType_t xEventGroupWaitBitmap( EventGroupHandle_t xEventGroup,
+ *                                    const EventBitmap_t * pxBitsToWaitFor,
+ *                                    const BaseType_t xClearOnExit,
+ *                                    const BaseType_t xWaitForAllBits,
+ *                                    EventBitmap_t * pxEventBitmap,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * A version of xEventGroupWaitBits() that waits for bits in the event group's
+ * bitmap.  The parameters and behaviour match xEventGroupWaitBits(), except
+ * that the bits are passed and returned by reference.  This function cannot
+ * be called from an interrupt.
+ *
+ * @param pxBitsToWaitFor The bits to wait for.  At least one bit must be set.
+ * The bitmap must remain valid until the function returns.
+ *
+ * @param pxEventBitmap If not NULL, used to return the value of the bitmap at
+ * the time either the bits being waited for became set, or the block time
+ * expired.  As for xEventGroupWaitBits(), the value is returned before any
+ * bits were cleared because xClearOnExit was pdTRUE.
+ *
+ * @return pdTRUE if the wait condition was met, otherwise pdFALSE.
+ *
+ * \defgroup xEventGroupWaitBitmap xEventGroupWaitBitmap
+ * \ingroup EventGroup
+ */
+    BaseType_t xEventGroupWaitBitmap( EventGroupHandle_t xEventGroup,
+                                      const EventBitmap_t * pxBitsToWaitFor,
+                                      const BaseType_t xClearOnExit,
+                                      const BaseType_t xWaitForAllBits,
+                                      EventBitmap_t * pxEventBitmap,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * event_groups.h
+ * @code{c}
+ *  BaseType_t xEventGroupSyncBitmap( EventGroupHandle_t xEventGroup,
+ *                                    const EventBitmap_t * pxBitsToSet,
+ *                                    const EventBitmap_t * pxBitsToWaitFor,
+ *                                    EventBitmap_t * pxEventBitmap,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * A version of xEventGroupSync() that uses the event group's bitmap, so a
+ * rendezvous is not limited in the number of tasks by the width of
+ * TickType_t.  The parameters and behaviour match xEventGroupSync(), except
+ * that the bits are passed and returned by reference.  This function cannot be
+ * called from an interrupt.
+ *
+ * @param pxEventBitmap If not NULL, used to return the value of the bitmap at
+ * the time either the bits being waited for became set, or the block time
+ * expired.
+ *
+ * @return pdTRUE if all the bits being waited for were set, otherwise pdFALSE.
+ *
+ * \defgroup xEventGroupSyncBitmap xEventGroupSyncBitmap
+ * \ingroup EventGroup
+ */
+    BaseType_t xEventGroupSyncBitmap( EventGroupHandle_t xEventGroup,
+                                      const EventBitmap_t * pxBitsToSet,
+                                      const EventBitmap_t * pxBitsToWaitFor,
+                                      EventBitmap_t * pxEventBitmap,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EVENT_GROUP_BITMAPS */
+
 /**
  * event_groups.h
  * @code{c}
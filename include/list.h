@@ -149,6 +149,12 @@ struct xLIST_ITEM
     struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /**< Pointer to the previous ListItem_t in the list. */
     void * pvOwner;                                     /**< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
     struct xLIST * configLIST_VOLATILE pxContainer;     /**< Pointer to the list in which this list item is placed (if any). */
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+        struct xLIST_ITEM * configLIST_VOLATILE pxTreeParent; /**< Parent of this item in the list's ordering tree. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxTreeLeft;   /**< Child holding items that sort before this item. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxTreeRight;  /**< Child holding items that sort at or after this item. */
+        configLIST_VOLATILE UBaseType_t uxTreeColour;         /**< Red or black while the item is indexed by the tree, otherwise listTREE_NOT_INDEXED. */
+    #endif
     listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /**< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;
@@ -175,9 +181,36 @@ typedef struct xLIST
     configLIST_VOLATILE UBaseType_t uxNumberOfItems;
     ListItem_t * configLIST_VOLATILE pxIndex; /**< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
     MiniListItem_t xListEnd;                  /**< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+        ListItem_t * configLIST_VOLATILE pxTreeRoot; /**< Root of the red-black tree indexing the items inserted by vListInsert(). */
+    #endif
     listSECOND_LIST_INTEGRITY_CHECK_VALUE     /**< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+/*
+ * When configUSE_ORDERED_LIST_TREE is set to 1 the items placed in a list by
+ * vListInsert() are also linked into a red-black tree that shares the order of
+ * the linked list, so the insertion position is found in O(log n) steps.  The
+ * linked list itself is unchanged, so every access macro continues to work.
+ * Items placed in a list by vListInsertEnd() or listINSERT_END() are not
+ * indexed by the tree, and are marked as such so that removing them does not
+ * touch the tree.
+ */
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+    #define listTREE_NOT_INDEXED                              ( ( UBaseType_t ) 0U )
+    #define listSET_ITEM_NOT_INDEXED( pxItem )                ( ( pxItem )->uxTreeColour = listTREE_NOT_INDEXED )
+    #define listREMOVE_ITEM_FROM_TREE( pxList, pxItem )             \
+    do {                                                            \
+        if( ( pxItem )->uxTreeColour != listTREE_NOT_INDEXED )      \
+        {                                                           \
+            vListTreeRemove( ( pxList ), ( pxItem ) );              \
+        }                                                           \
+    } while( 0 )
+#else
+    #define listSET_ITEM_NOT_INDEXED( pxItem )
+    #define listREMOVE_ITEM_FROM_TREE( pxList, pxItem )
+#endif
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -325,6 +358,7 @@ typedef struct xLIST
          * item. */                                                                                 \
         List_t * const pxList = ( pxItemToRemove )->pxContainer;                                    \
                                                                                                     \
+        listREMOVE_ITEM_FROM_TREE( pxList, ( pxItemToRemove ) );                                    \
         ( pxItemToRemove )->pxNext->pxPrevious = ( pxItemToRemove )->pxPrevious;                    \
         ( pxItemToRemove )->pxPrevious->pxNext = ( pxItemToRemove )->pxNext;                        \
         /* Make sure the index is left pointing to a valid item. */                                 \
@@ -374,6 +408,7 @@ typedef struct xLIST
          * listGET_OWNER_OF_NEXT_ENTRY(). */                                                        \
         ( pxNewListItem )->pxNext = pxIndex;                                                        \
         ( pxNewListItem )->pxPrevious = pxIndex->pxPrevious;                                        \
+        listSET_ITEM_NOT_INDEXED( pxNewListItem );                                                  \
                                                                                                     \
         pxIndex->pxPrevious->pxNext = ( pxNewListItem );                                            \
         pxIndex->pxPrevious = ( pxNewListItem );                                                    \
@@ -502,6 +537,24 @@ void vListInsertEnd( List_t * const pxList,
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unlink an item from the red-black tree that indexes pxList.  Only available
+ * when configUSE_ORDERED_LIST_TREE is set to 1.  This is called by
+ * uxListRemove() and listREMOVE_ITEM() for items that were inserted with
+ * vListInsert(), and does not remove the item from the linked list itself.
+ *
+ * @param pxList The list whose tree indexes the item.
+ *
+ * @param pxItemToRemove The item to be unlinked from the tree.
+ *
+ * \page vListTreeRemove vListTreeRemove
+ * \ingroup LinkedList
+ */
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+    void vListTreeRemove( List_t * const pxList,
+                          ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
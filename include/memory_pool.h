@@ -0,0 +1,373 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include memory_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A memory pool is a fixed number of equally sized blocks of memory.  Blocks
+ * are allocated from and freed back to the pool in constant time, without
+ * fragmentation, and unlike pvPortMalloc() a block can be allocated or freed
+ * from an interrupt.  A task can optionally enter the Blocked state to wait
+ * for a block to become available if all the blocks in the pool are in use.
+ *
+ * Memory pools are intended for objects that are created and destroyed often
+ * and are always the same size, such as network frames or message structures.
+ */
+
+/**
+ * memory_pool.h
+ *
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemoryPoolCreate() returns a MemoryPoolHandle_t variable that can then be
+ * used as a parameter to other memory pool functions.
+ *
+ * \defgroup MemoryPoolHandle_t MemoryPoolHandle_t
+ * \ingroup MemoryPool
+ */
+struct MemoryPoolDef_t;
+typedef struct MemoryPoolDef_t * MemoryPoolHandle_t;
+
+/**
+ * memory_pool.h
+ *
+ * The number of bytes a memory pool uses for each block of xBlockSize bytes.
+ * Each block is rounded up so it can hold a pointer and is a multiple of
+ * portBYTE_ALIGNMENT bytes.
+ */
+#define memorypoolBLOCK_SIZE( xBlockSize )                                                                    \
+    ( ( ( ( ( size_t ) ( xBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( size_t ) ( xBlockSize ) ) + \
+        ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * memory_pool.h
+ *
+ * The size, in bytes, of the storage area that must be passed to
+ * xMemoryPoolCreateStatic() for a pool of uxNumberOfBlocks blocks of
+ * xBlockSize bytes.
+ */
+#define memorypoolSTORAGE_SIZE( uxNumberOfBlocks, xBlockSize )    ( ( size_t ) ( uxNumberOfBlocks ) * memorypoolBLOCK_SIZE( xBlockSize ) )
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxNumberOfBlocks,
+ *                                       size_t xBlockSize );
+ * @endcode
+ *
+ * Create a new memory pool.
+ *
+ * Internally, within the FreeRTOS implementation, memory pools use two blocks
+ * of memory.  The first block is used to hold the pool's data structures.  The
+ * second block is used to hold the blocks that are allocated from the pool.
+ * If a memory pool is created using xMemoryPoolCreate() then both blocks of
+ * memory are automatically dynamically allocated inside the
+ * xMemoryPoolCreate() function.  (see https://www.FreeRTOS.org/a00111.html).
+ * If a memory pool is created using xMemoryPoolCreateStatic() then the
+ * application writer must provide the memory that will get used by the memory
+ * pool.  xMemoryPoolCreateStatic() therefore allows a memory pool to be
+ * created without using any dynamic memory allocation.
+ *
+ * configUSE_MEMORY_POOLS and configSUPPORT_DYNAMIC_ALLOCATION must both be set
+ * to 1 in FreeRTOSConfig.h for xMemoryPoolCreate() to be available.
+ *
+ * @param uxNumberOfBlocks The number of blocks in the pool.
+ *
+ * @param xBlockSize The size, in bytes, of each block.
+ *
+ * @return If the memory pool is created then a handle to the created pool is
+ * returned.  If there was insufficient FreeRTOS heap available to create the
+ * pool then NULL is returned.  See https://www.FreeRTOS.org/a00111.html
+ *
+ * Example usage:
+ * @code{c}
+ *
+ *  typedef struct AMessage
+ *  {
+ *      uint32_t ulMessageID;
+ *      uint8_t ucData[ 64 ];
+ *  } AMessage_t;
+ *
+ *  MemoryPoolHandle_t xMessagePool;
+ *
+ *  void vAFunction( void )
+ *  {
+ *      // Create a pool of 10 messages.
+ *      xMessagePool = xMemoryPoolCreate( 10, sizeof( AMessage_t ) );
+ *
+ *      if( xMessagePool == NULL )
+ *      {
+ *          // There was not enough FreeRTOS heap to create the pool.
+ *      }
+ *  }
+ * @endcode
+ * \defgroup xMemoryPoolCreate xMemoryPoolCreate
+ * \ingroup MemoryPool
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxNumberOfBlocks,
+                                          size_t xBlockSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxNumberOfBlocks,
+ *                                             size_t xBlockSize,
+ *                                             uint8_t * pucPoolStorageBuffer,
+ *                                             StaticMemoryPool_t * pxStaticMemoryPool );
+ * @endcode
+ *
+ * Create a new memory pool using memory provided by the application writer.
+ * See xMemoryPoolCreate() for a description of the memory used by a pool.
+ *
+ * configUSE_MEMORY_POOLS and configSUPPORT_STATIC_ALLOCATION must both be set
+ * to 1 in FreeRTOSConfig.h for xMemoryPoolCreateStatic() to be available.
+ *
+ * @param uxNumberOfBlocks The number of blocks in the pool.
+ *
+ * @param xBlockSize The size, in bytes, of each block.
+ *
+ * @param pucPoolStorageBuffer Must point to a buffer of at least
+ * memorypoolSTORAGE_SIZE( uxNumberOfBlocks, xBlockSize ) bytes that is aligned
+ * to portBYTE_ALIGNMENT bytes.  The blocks are allocated from this buffer.
+ *
+ * @param pxStaticMemoryPool Must point to a variable of type
+ * StaticMemoryPool_t, which will be used to hold the memory pool's data
+ * structure.
+ *
+ * @return If neither pucPoolStorageBuffer nor pxStaticMemoryPool are NULL then
+ * a handle to the created pool is returned.  Otherwise NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ *
+ *  #define NUMBER_OF_FRAMES    8
+ *  #define FRAME_SIZE          1536
+ *
+ *  // The blocks are allocated from this buffer.
+ *  static uint8_t ucFrameStorage[ memorypoolSTORAGE_SIZE( NUMBER_OF_FRAMES, FRAME_SIZE ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+ *
+ *  // The variable used to hold the pool's data structure.
+ *  static StaticMemoryPool_t xFramePoolStruct;
+ *
+ *  void vAFunction( void )
+ *  {
+ *      MemoryPoolHandle_t xFramePool;
+ *
+ *      xFramePool = xMemoryPoolCreateStatic( NUMBER_OF_FRAMES, FRAME_SIZE, ucFrameStorage, &xFramePoolStruct );
+ *
+ *      // As neither buffer was NULL xFramePool will not be NULL.
+ *  }
+ * @endcode
+ * \defgroup xMemoryPoolCreateStatic xMemoryPoolCreateStatic
+ * \ingroup MemoryPool
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxNumberOfBlocks,
+                                                size_t xBlockSize,
+                                                uint8_t * pucPoolStorageBuffer,
+                                                StaticMemoryPool_t * pxStaticMemoryPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * void * pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Allocate a block from a memory pool, optionally waiting in the Blocked
+ * state for a block to be freed if all the blocks are in use.  If more than
+ * one task is waiting for a block then the highest priority task is the first
+ * to be given a block that is freed.
+ *
+ * The contents of the allocated block are undefined.
+ *
+ * This function cannot be called from an interrupt.  See
+ * pvMemoryPoolAllocateFromISR() for an alternative that can.
+ *
+ * @param xMemoryPool The pool from which the block is allocated.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for a block to become available.  The macro pdMS_TO_TICKS() can be
+ * used to convert a time specified in milliseconds to a time specified in
+ * ticks.  Setting xTicksToWait to portMAX_DELAY will cause the task to wait
+ * indefinitely (without timing out), provided INCLUDE_vTaskSuspend is set to 1
+ * in FreeRTOSConfig.h.
+ *
+ * @return A pointer to the allocated block, or NULL if no block became
+ * available before xTicksToWait ticks had passed.
+ *
+ * \defgroup pvMemoryPoolAllocate pvMemoryPoolAllocate
+ * \ingroup MemoryPool
+ */
+void * pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * void * pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * A version of pvMemoryPoolAllocate() that can be called from an interrupt
+ * service routine.  The function never blocks.
+ *
+ * @param xMemoryPool The pool from which the block is allocated.
+ *
+ * @return A pointer to the allocated block, or NULL if all the blocks in the
+ * pool are in use.
+ *
+ * \defgroup pvMemoryPoolAllocateFromISR pvMemoryPoolAllocateFromISR
+ * \ingroup MemoryPool
+ */
+void * pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool,
+ *                       void * pvBlock );
+ * @endcode
+ *
+ * Return a block to the memory pool from which it was allocated.  If a task
+ * is blocked waiting for a block then the highest priority waiting task is
+ * unblocked.
+ *
+ * This function cannot be called from an interrupt.  See
+ * vMemoryPoolFreeFromISR() for an alternative that can.
+ *
+ * @param xMemoryPool The pool from which the block was allocated.
+ *
+ * @param pvBlock The block being freed, as returned by pvMemoryPoolAllocate()
+ * or pvMemoryPoolAllocateFromISR().
+ *
+ * \defgroup vMemoryPoolFree vMemoryPoolFree
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool,
+                      void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+ *                              void * pvBlock,
+ *                              BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vMemoryPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xMemoryPool The pool from which the block was allocated.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * @param pxHigherPriorityTaskWoken Freeing a block can unblock a task that is
+ * waiting to allocate a block from the pool.  If the unblocked task has a
+ * priority higher than the currently running task then
+ * *pxHigherPriorityTaskWoken is set to pdTRUE, indicating a context switch
+ * should be requested before the interrupt is exited.  pxHigherPriorityTaskWoken
+ * can be NULL.
+ *
+ * \defgroup vMemoryPoolFreeFromISR vMemoryPoolFreeFromISR
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                             void * pvBlock,
+                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * @param xMemoryPool The pool being queried.
+ *
+ * @return The number of blocks that are not currently allocated.
+ *
+ * \defgroup uxMemoryPoolGetFreeBlocks uxMemoryPoolGetFreeBlocks
+ * \ingroup MemoryPool
+ */
+UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * UBaseType_t uxMemoryPoolGetHighWaterMark( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * Returns the minimum number of free blocks there have been in the pool since
+ * it was created.  A value of zero means that at some point every block was in
+ * use, so callers of pvMemoryPoolAllocate() may have blocked or failed.
+ *
+ * @param xMemoryPool The pool being queried.
+ *
+ * @return The smallest number of free blocks the pool has had.
+ *
+ * \defgroup uxMemoryPoolGetHighWaterMark uxMemoryPoolGetHighWaterMark
+ * \ingroup MemoryPool
+ */
+UBaseType_t uxMemoryPoolGetHighWaterMark( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ * @code{c}
+ * void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool );
+ * @endcode
+ *
+ * Delete a memory pool.  A pool must not be deleted while tasks are blocked
+ * waiting to allocate a block from it, and blocks allocated from the pool
+ * must not be used after the pool is deleted.
+ *
+ * @param xMemoryPool The pool being deleted.
+ *
+ * \defgroup vMemoryPoolDelete vMemoryPoolDelete
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* MEMORY_POOL_H */
@@ -94,6 +94,52 @@
     #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP    0
 #endif
 
+/* Set configUSE_HEAP_CORE_CACHES to 1 to give each core a cache of small
+ * blocks that heap_4.c and heap_5.c can allocate and free without suspending
+ * the scheduler. */
+#ifndef configUSE_HEAP_CORE_CACHES
+    #define configUSE_HEAP_CORE_CACHES    0
+#endif
+
+/* The number of blocks of each size class a core's cache can hold. */
+#ifndef configHEAP_CORE_CACHE_DEPTH
+    #define configHEAP_CORE_CACHE_DEPTH    8
+#endif
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 ) && ( configHEAP_CORE_CACHE_DEPTH < 2 )
+    #error configHEAP_CORE_CACHE_DEPTH must be at least 2
+#endif
+
+/* Set configUSE_HEAP_ALLOCATION_TRACKING to 1 to have heap_4.c and heap_5.c
+ * record the task and call site that allocated each block, and to include the
+ * allocation and fragmentation reporting functions declared below.  Doing so
+ * adds two pointers to the header of every block. */
+#ifndef configUSE_HEAP_ALLOCATION_TRACKING
+    #define configUSE_HEAP_ALLOCATION_TRACKING    0
+#endif
+
+/* The number of buckets in the free block size histogram returned by
+ * vPortGetHeapFragmentationStats(). */
+#ifndef configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS
+    #define configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS    16
+#endif
+
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 ) && ( configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS < 1 )
+    #error configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS must be at least 1
+#endif
+
+/* Returns the address the function that uses it was called from.  Used by
+ * configUSE_HEAP_ALLOCATION_TRACKING to record the call site of each
+ * allocation.  Compilers without a GCC compatible builtin record NULL unless
+ * the port or FreeRTOSConfig.h provides an alternative. */
+#ifndef portGET_CALLER_ADDRESS
+    #ifdef __GNUC__
+        #define portGET_CALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define portGET_CALLER_ADDRESS()    NULL
+    #endif
+#endif
+
 #include "mpu_wrappers.h"
 
 /* *INDENT-OFF* */
@@ -136,7 +182,7 @@
     #endif
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
-/* Used by heap_5.c to define the start address and size of each memory region
+/* Used by heap_5.c and heap_6.c to define the start address and size of each memory region
  * that together comprise the total FreeRTOS heap space. */
 typedef struct HeapRegion
 {
@@ -154,18 +200,50 @@ typedef struct xHeapStats
     size_t xMinimumEverFreeBytesRemaining;  /* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
     size_t xNumberOfSuccessfulAllocations;  /* The number of calls to pvPortMalloc() that have returned a valid memory block. */
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        size_t xNumberOfCacheHits;          /* The number of calls to pvPortMalloc() that were satisfied from a core's cache. */
+        size_t xNumberOfCacheMisses;        /* The number of calls to pvPortMalloc() for a cacheable size that found the core's cache empty. */
+        size_t xCachedBytes;                /* The total size of the blocks held in the core caches.  These bytes are not included in xAvailableHeapSpaceInBytes. */
+    #endif
 } HeapStats_t;
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+    struct tskTaskControlBlock; /* Declared here as task.h is not included by this file. */
+
+/* Used to pass information about one live allocation out of
+ * uxPortGetHeapAllocations(). */
+    typedef struct xHeapAllocationRecord
+    {
+        void * pvAddress;                      /* The address returned by pvPortMalloc(). */
+        size_t xBlockSizeInBytes;              /* The size of the block, including the heap's own block header and any padding. */
+        struct tskTaskControlBlock * xOwner;   /* The task that allocated the block, or NULL if it was allocated before the scheduler started. */
+        void * pvCaller;                       /* The address pvPortMalloc() or pvPortCalloc() was called from, or NULL if portGET_CALLER_ADDRESS() is not supported. */
+    } HeapAllocationRecord_t;
+
+/* Used to pass information about heap fragmentation out of
+ * vPortGetHeapFragmentationStats(). */
+    typedef struct xHeapFragmentationStats
+    {
+        size_t xFreeBlockHistogram[ configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS ]; /* Bucket n counts the free blocks of at least 2^(n+4) and less than 2^(n+5) bytes, including the block header.  The first bucket also counts smaller blocks and the last bucket also counts larger blocks. */
+        size_t xSizeOfLargestFreeBlockInBytes;                                  /* The size of the largest free block at the time vPortGetHeapFragmentationStats() is called. */
+        size_t xMinimumEverLargestFreeBlockInBytes;                             /* The smallest value xSizeOfLargestFreeBlockInBytes has had over all calls to vPortGetHeapFragmentationStats(). */
+        size_t xNumberOfLiveAllocations;                                        /* The number of blocks currently allocated to the application. */
+    } HeapFragmentationStats_t;
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
- * must be called before any calls to pvPortMalloc() - not creating a task,
- * queue, semaphore, mutex, software timer, event group, etc. will result in
- * pvPortMalloc being called.
+ * Used to define multiple heap regions for use by heap_5.c and heap_6.c.  This
+ * function must be called before any calls to pvPortMalloc() - not creating a
+ * task, queue, semaphore, mutex, software timer, event group, etc. will result
+ * in pvPortMalloc being called.
  *
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
- * terminated by a HeapRegions_t structure that has a size of 0.  The region
- * with the lowest start address must appear first in the array.
+ * terminated by a HeapRegions_t structure that has a size of 0.  When using
+ * heap_5.c the region with the lowest start address must appear first in the
+ * array.
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
@@ -175,12 +253,73 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+/*
+ * Only available when using heap_4.c or heap_5.c with
+ * configUSE_HEAP_ALLOCATION_TRACKING set to 1.
+ *
+ * Fills pxRecords with up to uxMaxRecords records describing the blocks that
+ * are currently allocated, in address order, and returns the total number of
+ * allocated blocks.  A return value greater than uxMaxRecords means the array
+ * was too small to hold every record.  Blocks held in the heap_4/heap_5 core
+ * caches are free, so are not reported.  The scheduler is suspended while the
+ * heap is walked.
+ */
+    UBaseType_t uxPortGetHeapAllocations( HeapAllocationRecord_t * const pxRecords,
+                                          const UBaseType_t uxMaxRecords ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when using heap_4.c or heap_5.c with
+ * configUSE_HEAP_ALLOCATION_TRACKING set to 1.
+ *
+ * Returns the total size of the blocks currently allocated by xTask, including
+ * the block headers.  Passing NULL returns the size of the blocks allocated
+ * before the scheduler was started.  If puxNumberOfBlocks is not NULL then
+ * the number of those blocks is written to it.
+ */
+    size_t xPortGetHeapAllocatedBytesForTask( struct tskTaskControlBlock * xTask,
+                                              UBaseType_t * puxNumberOfBlocks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when using heap_4.c or heap_5.c with
+ * configUSE_HEAP_ALLOCATION_TRACKING set to 1.
+ *
+ * Returns a histogram of the free block sizes, the size of the largest free
+ * block and the lowest that size has been over all calls to this function.
+ * Calling it periodically therefore records the trend in the largest
+ * allocation that can succeed.
+ */
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
 /*
  * Map to the memory management routines required for the port.
  */
 void * pvPortMalloc( size_t xWantedSize ) PRIVILEGED_FUNCTION;
 void * pvPortCalloc( size_t xNum,
                      size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when using heap_4.c or heap_5.c.
+ *
+ * pvPortRealloc() resizes the block pv to hold xWantedSize bytes.  The block
+ * is resized in place if it is shrinking or if the block that follows it is
+ * free and large enough, otherwise a new block is allocated, the contents are
+ * copied and the original block is freed.  Returns NULL, leaving pv allocated,
+ * if the block cannot be resized.  Passing NULL as pv is equivalent to calling
+ * pvPortMalloc(), and passing 0 as xWantedSize frees pv and returns NULL.
+ * Blocks that are moved keep portBYTE_ALIGNMENT alignment only.
+ *
+ * pvPortMallocAligned() returns a block of xWantedSize bytes aligned to
+ * xAlignment bytes, which must be a power of two, without over-allocating.
+ * The block is freed with vPortFree().
+ */
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize ) PRIVILEGED_FUNCTION;
+void * pvPortMallocAligned( size_t xWantedSize,
+                           size_t xAlignment ) PRIVILEGED_FUNCTION;
 void vPortFree( void * pv ) PRIVILEGED_FUNCTION;
 void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
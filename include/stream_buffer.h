@@ -68,6 +68,7 @@
 #define sbTYPE_STREAM_BUFFER             ( ( BaseType_t ) 0 )
 #define sbTYPE_MESSAGE_BUFFER            ( ( BaseType_t ) 1 )
 #define sbTYPE_STREAM_BATCHING_BUFFER    ( ( BaseType_t ) 2 )
+#define sbTYPE_STREAM_PING_PONG_BUFFER   ( ( BaseType_t ) 3 )
 
 /**
  * Type by which stream buffers are referenced.  For example, a call to
@@ -459,6 +460,160 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BATCHING_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamPingPongBufferCreate( size_t xBlockSizeBytes );
+ * @endcode
+ *
+ * Creates a new stream ping-pong buffer using dynamically allocated memory.
+ * See xStreamPingPongBufferCreateStatic() for a version that uses statically
+ * allocated memory (memory that is allocated at compile time).
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xStreamPingPongBufferCreate() to be available.
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamPingPongBufferCreate() to be available.
+ *
+ * A stream ping-pong buffer is a double buffer.  Its storage area is split
+ * into two blocks of xBlockSizeBytes.  The writer (typically an ISR that runs
+ * when a DMA transfer completes) fills one block in place, obtained using
+ * pvStreamBufferGetPingPongWriteBlock(), then hands the whole block to the
+ * reader by calling pvStreamBufferSwapPingPongBlockFromISR(), which returns
+ * the block to fill next.  The reader obtains a pointer to the filled block
+ * using xStreamBufferReceivePingPongBlock(), processes it in place, then
+ * returns it to the writer by calling vStreamBufferReleasePingPongBlock().  No
+ * data is copied in either direction.  xStreamBufferReceive() can also be used
+ * to copy a whole block out, in which case the block is released immediately.
+ *
+ * xStreamBufferSend() and xStreamBufferSendFromISR() cannot be used with a
+ * stream ping-pong buffer.
+ *
+ * @param xBlockSizeBytes The size, in bytes, of each of the two blocks.  The
+ * trigger level of the buffer is fixed at this value.
+ *
+ * @param pxSendCompletedCallback Callback invoked when a block is handed to
+ * the reader. If the parameter is NULL, it will use the default implementation
+ * provided by sbSEND_COMPLETED macro. To enable the callback,
+ * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h.
+ *
+ * @param pxReceiveCompletedCallback Callback invoked when the reader releases
+ * a block. If the parameter is NULL, it will use the default implementation
+ * provided by sbRECEIVE_COMPLETED macro. To enable the callback,
+ * configUSE_SB_COMPLETED_CALLBACK must be set to 1 in FreeRTOSConfig.h.
+ *
+ * @return If NULL is returned, then the stream ping-pong buffer cannot be
+ * created because there is insufficient heap memory available for FreeRTOS to
+ * allocate the stream ping-pong buffer data structures and storage area.  A
+ * non-NULL value being returned indicates that the stream ping-pong buffer has
+ * been created successfully - the returned value should be stored as the
+ * handle to the created stream ping-pong buffer.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * #define BLOCK_SIZE_BYTES 256
+ *
+ * StreamBufferHandle_t xAdcBuffer;
+ *
+ * void vAdcDmaCompleteISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * void *pvNextBlock;
+ *
+ *  // Hand the block the DMA just filled to the reader.  If the reader still
+ *  // holds the other block NULL is returned and the DMA is restarted on the
+ *  // same block, overwriting it.
+ *  pvNextBlock = pvStreamBufferSwapPingPongBlockFromISR( xAdcBuffer, &xHigherPriorityTaskWoken );
+ *
+ *  if( pvNextBlock == NULL )
+ *  {
+ *      pvNextBlock = pvStreamBufferGetPingPongWriteBlock( xAdcBuffer );
+ *  }
+ *
+ *  vStartAdcDma( pvNextBlock, BLOCK_SIZE_BYTES );
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vAdcTask( void *pvParameters )
+ * {
+ * void *pvBlock;
+ *
+ *  xAdcBuffer = xStreamPingPongBufferCreate( BLOCK_SIZE_BYTES );
+ *  vStartAdcDma( pvStreamBufferGetPingPongWriteBlock( xAdcBuffer ), BLOCK_SIZE_BYTES );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xStreamBufferReceivePingPongBlock( xAdcBuffer, &pvBlock, portMAX_DELAY ) != 0 )
+ *      {
+ *          vProcessSamples( pvBlock, BLOCK_SIZE_BYTES );
+ *          vStreamBufferReleasePingPongBlock( xAdcBuffer );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamPingPongBufferCreate xStreamPingPongBufferCreate
+ * \ingroup StreamPingPongBufferManagement
+ */
+
+#define xStreamPingPongBufferCreate( xBlockSizeBytes ) \
+    xStreamBufferGenericCreate( ( xBlockSizeBytes ) * ( size_t ) 2, ( xBlockSizeBytes ), sbTYPE_STREAM_PING_PONG_BUFFER, NULL, NULL )
+
+#if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
+    #define xStreamPingPongBufferCreateWithCallback( xBlockSizeBytes, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
+    xStreamBufferGenericCreate( ( xBlockSizeBytes ) * ( size_t ) 2, ( xBlockSizeBytes ), sbTYPE_STREAM_PING_PONG_BUFFER, ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamPingPongBufferCreateStatic( size_t xBlockSizeBytes,
+ *                                                         uint8_t *pucStreamBufferStorageArea,
+ *                                                         StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * @endcode
+ * Creates a new stream ping-pong buffer using statically allocated memory.
+ * See xStreamPingPongBufferCreate() for a version that uses dynamically
+ * allocated memory, and a description of how stream ping-pong buffers are
+ * used.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xStreamPingPongBufferCreateStatic() to be available. configUSE_STREAM_BUFFERS
+ * must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamPingPongBufferCreateStatic() to be available.
+ *
+ * @param xBlockSizeBytes The size, in bytes, of each of the two blocks.
+ *
+ * @param pucStreamBufferStorageArea Must point to a uint8_t array that is
+ * exactly ( 2 * xBlockSizeBytes ) big.  The first block starts at
+ * pucStreamBufferStorageArea and the second at
+ * pucStreamBufferStorageArea + xBlockSizeBytes, so any alignment the writer
+ * needs (for example cache line alignment for DMA) can be arranged by
+ * aligning the array and choosing xBlockSizeBytes accordingly.
+ *
+ * @param pxStaticStreamBuffer Must point to a variable of type
+ * StaticStreamBuffer_t, which will be used to hold the stream ping-pong
+ * buffer's data structure.
+ *
+ * @return If the stream ping-pong buffer is created successfully then a handle
+ * to the created stream ping-pong buffer is returned. If either
+ * pucStreamBufferStorageArea or pxStaticstreamBuffer are NULL then NULL is
+ * returned.
+ *
+ * \defgroup xStreamPingPongBufferCreateStatic xStreamPingPongBufferCreateStatic
+ * \ingroup StreamPingPongBufferManagement
+ */
+
+#define xStreamPingPongBufferCreateStatic( xBlockSizeBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBlockSizeBytes ) * ( size_t ) 2, ( xBlockSizeBytes ), sbTYPE_STREAM_PING_PONG_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
+
+#if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
+    #define xStreamPingPongBufferCreateStaticWithCallback( xBlockSizeBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
+    xStreamBufferGenericCreateStatic( ( xBlockSizeBytes ) * ( size_t ) 2, ( xBlockSizeBytes ), sbTYPE_STREAM_PING_PONG_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -1245,6 +1400,157 @@ UBaseType_t uxStreamBufferGetStreamBufferNotificationIndex( StreamBufferHandle_t
 void vStreamBufferSetStreamBufferNotificationIndex( StreamBufferHandle_t xStreamBuffer,
                                                     UBaseType_t uxNotificationIndex ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void * pvStreamBufferGetPingPongWriteBlock( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Returns a pointer to the block of a stream ping-pong buffer that is
+ * currently being filled by the writer.  Typically used to obtain the first
+ * block to fill, as pvStreamBufferSwapPingPongBlockFromISR() returns each
+ * subsequent block.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * pvStreamBufferGetPingPongWriteBlock() to be available.
+ *
+ * @param xStreamBuffer The handle of a stream ping-pong buffer.
+ *
+ * @return A pointer to the block currently owned by the writer.
+ *
+ * \defgroup pvStreamBufferGetPingPongWriteBlock pvStreamBufferGetPingPongWriteBlock
+ * \ingroup StreamPingPongBufferManagement
+ */
+void * pvStreamBufferGetPingPongWriteBlock( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void * pvStreamBufferSwapPingPongBlock( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Hands the block the writer has filled to the reader, and returns the block
+ * the writer should fill next.  The whole block is handed over, so a task
+ * blocked in xStreamBufferReceivePingPongBlock() or xStreamBufferReceive() is
+ * unblocked.
+ *
+ * A block can only be handed over if the reader has released the block it
+ * was previously given.  If it has not then nothing is handed over, NULL is
+ * returned, and the writer continues to own the block it was filling.
+ *
+ * Use pvStreamBufferSwapPingPongBlockFromISR() to swap blocks from an
+ * interrupt service routine.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * pvStreamBufferSwapPingPongBlock() to be available.
+ *
+ * @param xStreamBuffer The handle of a stream ping-pong buffer.
+ *
+ * @return A pointer to the block the writer should fill next, or NULL if the
+ * reader still holds that block.
+ *
+ * \defgroup pvStreamBufferSwapPingPongBlock pvStreamBufferSwapPingPongBlock
+ * \ingroup StreamPingPongBufferManagement
+ */
+void * pvStreamBufferSwapPingPongBlock( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void * pvStreamBufferSwapPingPongBlockFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                                BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of pvStreamBufferSwapPingPongBlock() that can be called from an
+ * interrupt service routine (ISR).
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * pvStreamBufferSwapPingPongBlockFromISR() to be available.
+ *
+ * @param xStreamBuffer The handle of a stream ping-pong buffer.
+ *
+ * @param pxHigherPriorityTaskWoken It is possible that a stream ping-pong
+ * buffer will have a task blocked on it waiting for a block.  Handing a block
+ * over will cause the task to unblock.  If calling
+ * pvStreamBufferSwapPingPongBlockFromISR() causes a task to leave the blocked
+ * state, and the unblocked task has a priority higher than the currently
+ * executing task (the task that was interrupted), then, internally,
+ * pvStreamBufferSwapPingPongBlockFromISR() will set *pxHigherPriorityTaskWoken
+ * to pdTRUE.  If pvStreamBufferSwapPingPongBlockFromISR() sets this value to
+ * pdTRUE, then normally a context switch should be performed before the
+ * interrupt is exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE
+ * before it is passed into the function.
+ *
+ * @return A pointer to the block the writer should fill next, or NULL if the
+ * reader still holds that block.
+ *
+ * \defgroup pvStreamBufferSwapPingPongBlockFromISR pvStreamBufferSwapPingPongBlockFromISR
+ * \ingroup StreamPingPongBufferManagement
+ */
+void * pvStreamBufferSwapPingPongBlockFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceivePingPongBlock( StreamBufferHandle_t xStreamBuffer,
+ *                                           void **ppvBlock,
+ *                                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains the block of a stream ping-pong buffer that was last handed over by
+ * the writer, without copying it.  The reader owns the block until it calls
+ * vStreamBufferReleasePingPongBlock(), and until then the writer cannot hand
+ * over another block.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferReceivePingPongBlock() to be available.
+ *
+ * @param xStreamBuffer The handle of a stream ping-pong buffer.
+ *
+ * @param ppvBlock Set to point to the block handed over by the writer, or to
+ * NULL if no block was available.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a block to be handed over, should none already be
+ * available.  The block time is specified in tick periods, so the absolute
+ * time it represents is dependent on the tick frequency.
+ *
+ * @return The number of bytes in the block, which is the block size the
+ * buffer was created with, or 0 if no block was available.
+ *
+ * \defgroup xStreamBufferReceivePingPongBlock xStreamBufferReceivePingPongBlock
+ * \ingroup StreamPingPongBufferManagement
+ */
+size_t xStreamBufferReceivePingPongBlock( StreamBufferHandle_t xStreamBuffer,
+                                          void ** ppvBlock,
+                                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferReleasePingPongBlock( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Returns the block obtained by xStreamBufferReceivePingPongBlock() to the
+ * writer, so the writer can hand over the block it is filling.  Calling this
+ * function when the reader does not hold a block has no effect.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * vStreamBufferReleasePingPongBlock() to be available.
+ *
+ * @param xStreamBuffer The handle of a stream ping-pong buffer.
+ *
+ * \defgroup vStreamBufferReleasePingPongBlock vStreamBufferReleasePingPongBlock
+ * \ingroup StreamPingPongBufferManagement
+ */
+void vStreamBufferReleasePingPongBlock( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
@@ -180,6 +180,18 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+
+/* Used with the vTaskGetSchedulingLatency() function to return the scheduling
+ * latency histogram of a task.  Latencies are in the units of
+ * configSCHEDULING_LATENCY_TIMESTAMP(). */
+    typedef struct xTASK_SCHEDULING_LATENCY
+    {
+        uint32_t ulHistogram[ configSCHEDULING_LATENCY_BUCKETS ]; /* ulHistogram[ 0 ] counts latencies of 0, ulHistogram[ n ] counts latencies from 2^(n-1) to 2^n - 1, and the last entry also counts all longer latencies. */
+        configRUN_TIME_COUNTER_TYPE ulMaximumLatency;             /* The longest latency seen. */
+    } TaskSchedulingLatency_t;
+#endif
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -1925,6 +1937,53 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configUSE_TASK_ARENAS == 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void *pvTaskArenaAlloc( size_t xWantedSize );
+ * @endcode
+ *
+ * configUSE_TASK_ARENAS must be defined as 1 for this function to be
+ * available.
+ *
+ * Allocates memory from the calling task's arena.  The arena obtains chunks of
+ * configTASK_ARENA_CHUNK_SIZE bytes from the heap using pvPortMalloc() and hands
+ * out successive allocations from the current chunk, so an allocation costs
+ * little more than advancing an offset.  Requests larger than
+ * configTASK_ARENA_CHUNK_SIZE are given a chunk of their own.
+ *
+ * Memory obtained from the arena must not be passed to vPortFree().  Instead
+ * all of it is released at once, either when the task calls vTaskArenaReset()
+ * or when the task is deleted.  The arena belongs to the calling task, so memory
+ * obtained from it must not be used after either of those events, and this
+ * function must not be called from an interrupt.
+ *
+ * @param xWantedSize The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, aligned to portBYTE_ALIGNMENT, or
+ * NULL if xWantedSize is 0 or the heap could not supply a new chunk.
+ */
+    void * pvTaskArenaAlloc( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskArenaReset( void );
+ * @endcode
+ *
+ * configUSE_TASK_ARENAS must be defined as 1 for this function to be
+ * available.
+ *
+ * Releases everything the calling task has allocated with pvTaskArenaAlloc().
+ * The most recently obtained chunk is kept and reused by later allocations;
+ * all other chunks are returned to the heap.
+ */
+    void vTaskArenaReset( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_ARENAS */
+
 #if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
 
 /**
@@ -2183,6 +2242,82 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetSchedulingLatency( TaskHandle_t xTask, TaskSchedulingLatency_t * pxSchedulingLatency );
+ * @endcode
+ *
+ * configUSE_SCHEDULING_LATENCY_STATS must be defined as 1 for this function to
+ * be available.  See the configuration section for more information.
+ *
+ * Each task keeps a histogram of its scheduling latency - the time from the
+ * task leaving the Blocked or Suspended state, or being created, to the task
+ * next entering the Running state.  configGENERATE_RUN_TIME_STATS must also be
+ * 1.  A task that often waits a long time to run after it is unblocked is
+ * being kept out of the Running state by tasks of the same or higher priority,
+ * so the histograms can be used to find tasks with too low a priority.
+ *
+ * Latencies are measured with configSCHEDULING_LATENCY_TIMESTAMP(), which
+ * defaults to the port's high resolution timer, so on the POSIX port they are
+ * in nanoseconds.  On a port without a high resolution timer it defaults to
+ * portGET_RUN_TIME_COUNTER_VALUE(), and the histogram is only as fine as that
+ * counter - every latency shorter than one count is recorded as 0.
+ *
+ * The histograms of all tasks can be obtained by passing each handle returned
+ * by uxTaskGetSystemState() to vTaskGetSchedulingLatency().
+ *
+ * @param xTask The handle of the task to query.  Passing NULL queries the
+ * calling task.
+ *
+ * @param pxSchedulingLatency The task's histogram and longest latency are
+ * copied into the TaskSchedulingLatency_t structure pointed to by
+ * pxSchedulingLatency.
+ *
+ * Example usage:
+ * @code{c}
+ *  void vPrintSchedulingLatency( TaskHandle_t xTask )
+ *  {
+ *      TaskSchedulingLatency_t xLatency;
+ *      UBaseType_t x;
+ *
+ *      vTaskGetSchedulingLatency( xTask, &xLatency );
+ *
+ *      for( x = 0; x < configSCHEDULING_LATENCY_BUCKETS; x++ )
+ *      {
+ *          printf( "< 2^%u: %u\r\n", ( unsigned ) x, ( unsigned ) xLatency.ulHistogram[ x ] );
+ *      }
+ *  }
+ *  @endcode
+ * \defgroup vTaskGetSchedulingLatency vTaskGetSchedulingLatency
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+    void vTaskGetSchedulingLatency( TaskHandle_t xTask,
+                                    TaskSchedulingLatency_t * pxSchedulingLatency ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskResetSchedulingLatency( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_SCHEDULING_LATENCY_STATS must be defined as 1 for this function to
+ * be available.
+ *
+ * Clear the scheduling latency histogram and longest latency of a task.
+ *
+ * @param xTask The handle of the task whose histogram is cleared.  Passing
+ * NULL clears the histogram of the calling task.
+ *
+ * \defgroup vTaskResetSchedulingLatency vTaskResetSchedulingLatency
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+    void vTaskResetSchedulingLatency( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3564,6 +3699,26 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that can be called from an
+ * interrupt.  If the scheduler is suspended the task is held on the pending
+ * ready list until the scheduler is resumed, as is done by
+ * xTaskRemoveFromEventList().  Used when configUSE_EVENT_GROUP_DIRECT_FROM_ISR
+ * is set to 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was interrupted, otherwise pdFALSE.
+ */
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3584,6 +3739,14 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  */
 TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the event list item of the calling task, which references the task
+ * from the event list on which it is waiting.
+ */
+#if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+    ListItem_t * pxTaskGetEventListItem( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Return the handle of the calling task.
  */
@@ -52,6 +52,7 @@
  * as defined below.  The commands that are sent from interrupts must use the
  * highest numbers as tmrFIRST_FROM_ISR_COMMAND is used to determine if the task
  * or interrupt version of the queue send function should be used. */
+#define tmrCOMMAND_WAKE_TIMER_TASK             ( ( BaseType_t ) -3 )
 #define tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR    ( ( BaseType_t ) -2 )
 #define tmrCOMMAND_EXECUTE_CALLBACK             ( ( BaseType_t ) -1 )
 #define tmrCOMMAND_START_DONT_TRACE             ( ( BaseType_t ) 0 )
@@ -89,6 +90,38 @@ typedef void (* TimerCallbackFunction_t)( TimerHandle_t xTimer );
 typedef void (* PendedFunction_t)( void * arg1,
                                    uint32_t arg2 );
 
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/* Values that can be passed into the xCallbackContext parameter of
+ * xHRTimerCreate() and xHRTimerCreateStatic() to select the context from which
+ * the callback function of a high resolution timer is executed. */
+    #define tmrHR_CALLBACK_FROM_ISR     ( ( BaseType_t ) 0 )
+    #define tmrHR_CALLBACK_FROM_TASK    ( ( BaseType_t ) 1 )
+
+/* Converts a time in microseconds to a count of the high resolution timer. */
+    #define tmrUS_TO_HR_COUNTS( xTimeInUs )    ( ( HRTimerCount_t ) ( ( ( HRTimerCount_t ) ( xTimeInUs ) * ( HRTimerCount_t ) portHR_TIMER_COUNTS_PER_SECOND ) / ( HRTimerCount_t ) 1000000U ) )
+
+/* The longest delay with which a high resolution timer can be started. */
+    #define tmrHR_MAX_DELAY    ( ( ( HRTimerCount_t ) ~( ( HRTimerCount_t ) 0U ) ) >> 1U )
+
+/**
+ * Type by which high resolution timers are referenced.
+ */
+    struct tmrHRTimerControl;
+    typedef struct tmrHRTimerControl * HRTimerHandle_t;
+
+/*
+ * Defines the prototype to which high resolution timer callback functions must
+ * conform.  When the callback executes from the interrupt it can set
+ * *pxHigherPriorityTaskWoken to pdTRUE to request a context switch when the
+ * interrupt exits.  When it executes from a task pxHigherPriorityTaskWoken is
+ * NULL.
+ */
+    typedef void (* HRTimerCallbackFunction_t)( HRTimerHandle_t xTimer,
+                                                BaseType_t * pxHigherPriorityTaskWoken );
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 /**
  * TimerHandle_t xTimerCreate(  const char * const pcTimerName,
  *                              TickType_t xTimerPeriodInTicks,
@@ -365,6 +398,74 @@ typedef void (* PendedFunction_t)( void * arg1,
                                       StaticTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName,
+ *                                      const TickType_t xTimerPeriodInTicks,
+ *                                      const BaseType_t xAutoReload,
+ *                                      void * const pvTimerID,
+ *                                      TimerCallbackFunction_t pxCallbackFunction,
+ *                                      const TickType_t xTimerSlack );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Creates a new software timer instance, exactly as xTimerCreate() does, but
+ * allows the timer to expire up to xTimerSlack ticks after its expiry time.
+ *
+ * Before blocking, the timer service task looks at the timers due to expire
+ * next.  Where the expiry windows of several timers overlap it blocks until
+ * the latest expiry time that is still within the window of every one of
+ * them, and then processes them all from that single wake-up.  This reduces
+ * the number of times the timer service task, and therefore the
+ * microcontroller, has to wake.  Timers that expire at the same time as each
+ * other are always processed from the same wake-up.
+ *
+ * The slack does not accumulate - the next expiry time of an auto-reload
+ * timer is always calculated from its expiry time, not from the time at
+ * which it was processed.  The slack of a timer created with xTimerCreate()
+ * is 0.
+ *
+ * @param xTimerSlack The number of ticks by which the expiry of the timer can
+ * be delayed so it coincides with the expiry of other timers.
+ *
+ * See xTimerCreate() for a description of the other parameters and the return
+ * value.
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+    TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName,
+                                         const TickType_t xTimerPeriodInTicks,
+                                         const BaseType_t xAutoReload,
+                                         void * const pvTimerID,
+                                         TimerCallbackFunction_t pxCallbackFunction,
+                                         const TickType_t xTimerSlack ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TimerHandle_t xTimerCreateStaticWithSlack( const char * const pcTimerName,
+ *                                            const TickType_t xTimerPeriodInTicks,
+ *                                            const BaseType_t xAutoReload,
+ *                                            void * const pvTimerID,
+ *                                            TimerCallbackFunction_t pxCallbackFunction,
+ *                                            const TickType_t xTimerSlack,
+ *                                            StaticTimer_t * pxTimerBuffer );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * The statically allocated equivalent of xTimerCreateWithSlack().  See
+ * xTimerCreateStatic() and xTimerCreateWithSlack() for a description of the
+ * parameters and the return value.
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+    TimerHandle_t xTimerCreateStaticWithSlack( const char * const pcTimerName,
+                                               const TickType_t xTimerPeriodInTicks,
+                                               const BaseType_t xAutoReload,
+                                               void * const pvTimerID,
+                                               TimerCallbackFunction_t pxCallbackFunction,
+                                               const TickType_t xTimerSlack,
+                                               StaticTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -451,6 +552,10 @@ BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  *
  * Simply returns the handle of the timer service/daemon task.  It it not valid
  * to call xTimerGetTimerDaemonTaskHandle() before the scheduler has been started.
+ *
+ * If configUSE_PER_CORE_TIMER_TASKS is set to 1 then the handle of the timer
+ * service task of the core on which xTimerGetTimerDaemonTaskHandle() is called
+ * is returned.
  */
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
 
@@ -1299,6 +1404,80 @@ BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetCoreID( TimerHandle_t xTimer, BaseType_t xCoreID );
+ *
+ * configUSE_PER_CORE_TIMER_TASKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * When configUSE_PER_CORE_TIMER_TASKS is set to 1 each core has its own timer
+ * service task, and each timer is owned by one of them.  The owning task
+ * processes the timer's commands and executes its callback function on its
+ * core.  A timer is owned by the core on which it is created unless
+ * vTimerSetCoreID() is used to move it to another core.
+ *
+ * A timer can only be moved while it is dormant.  Commands sent to the timer
+ * before it was moved are passed on to the timer service task of its new core.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xCoreID The core whose timer service task will own the timer.
+ */
+#if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+    void vTimerSetCoreID( TimerHandle_t xTimer,
+                          BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xTimerGetCoreID( TimerHandle_t xTimer );
+ *
+ * configUSE_PER_CORE_TIMER_TASKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Queries the core whose timer service task owns a timer.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The core that owns the timer.
+ */
+#if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+    BaseType_t xTimerGetCoreID( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Returns the number of ticks by which the expiry of a timer can be delayed.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack of the timer in ticks.
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * uint32_t ulTimerGetCoalescedWakeCount( void );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Returns the number of wake-ups of the timer service task that were saved
+ * because timers with overlapping expiry windows were processed together.  A
+ * batch of timers with n distinct expiry times adds n - 1 to the count once
+ * the timer service task has woken to process it.  When
+ * configUSE_PER_CORE_TIMER_TASKS is 1 the count covers all cores.
+ *
+ * @return The number of wake-ups saved since the scheduler was started.
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    uint32_t ulTimerGetCoalescedWakeCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * TickType_t xTimerGetPeriod( TimerHandle_t xTimer );
  *
@@ -1345,12 +1524,237 @@ TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
                                       StaticTimer_t ** ppxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName,
+ *                                 const BaseType_t xCallbackContext,
+ *                                 void * const pvTimerID,
+ *                                 HRTimerCallbackFunction_t pxCallbackFunction );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Creates a new high resolution timer instance, and returns a handle by which
+ * the created timer can be referenced.
+ *
+ * High resolution timers are one-shot timers that expire with the resolution
+ * of a hardware timer provided by the port, rather than with the resolution of
+ * the tick.  They are not processed by the timer service task.  Instead the
+ * port's hardware timer interrupt is always set to the expiry time of the high
+ * resolution timer that expires first.
+ *
+ * The callback function of a timer either executes directly from the hardware
+ * timer interrupt, or from a task of priority configHR_TIMER_TASK_PRIORITY that
+ * is unblocked by the interrupt.  Executing callbacks from the interrupt gives
+ * the lowest latency, but callbacks that execute from the interrupt can only
+ * use interrupt safe API functions.
+ *
+ * @param pcTimerName A text name that is assigned to the timer.  This is done
+ * purely to assist debugging.
+ *
+ * @param xCallbackContext tmrHR_CALLBACK_FROM_ISR to execute the timer's
+ * callback function from the hardware timer interrupt, or
+ * tmrHR_CALLBACK_FROM_TASK to execute it from the high resolution timer task.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer being created.
+ *
+ * @param pxCallbackFunction The function to call when the timer expires.
+ *
+ * @return If the timer is successfully created then a handle to the newly
+ * created timer is returned.  If the timer cannot be created because there is
+ * insufficient FreeRTOS heap remaining to allocate the timer structures then
+ * NULL is returned.
+ *
+ * Example usage:
+ * @verbatim
+ * // Executed from the hardware timer interrupt 150 microseconds after the
+ * // timer was started.
+ * void vProtocolTimeout( HRTimerHandle_t xTimer, BaseType_t * pxHigherPriorityTaskWoken )
+ * {
+ *     vTaskNotifyGiveFromISR( xProtocolTask, pxHigherPriorityTaskWoken );
+ * }
+ *
+ * void vSendFrame( void )
+ * {
+ *     vTransmitFrame();
+ *     xHRTimerStart( xTimeoutTimer, tmrUS_TO_HR_COUNTS( 150 ) );
+ * }
+ *
+ * void main( void )
+ * {
+ *     xTimeoutTimer = xHRTimerCreate( "Timeout", tmrHR_CALLBACK_FROM_ISR, NULL, vProtocolTimeout );
+ *
+ *     // Create tasks, then start the scheduler.
+ *     vTaskStartScheduler();
+ * }
+ * @endverbatim
+ */
+#if ( ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName,
+                                    const BaseType_t xCallbackContext,
+                                    void * const pvTimerID,
+                                    HRTimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName,
+ *                                       const BaseType_t xCallbackContext,
+ *                                       void * const pvTimerID,
+ *                                       HRTimerCallbackFunction_t pxCallbackFunction,
+ *                                       StaticHRTimer_t * pxTimerBuffer );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * The statically allocated equivalent of xHRTimerCreate().  pxTimerBuffer must
+ * point to a variable of type StaticHRTimer_t, which will be used to hold the
+ * timer's data structure.  See xHRTimerCreate() for a description of the other
+ * parameters.
+ *
+ * @return If pxTimerBuffer is not NULL then a handle to the created timer is
+ * returned, otherwise NULL is returned.
+ */
+#if ( ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName,
+                                          const BaseType_t xCallbackContext,
+                                          void * const pvTimerID,
+                                          HRTimerCallbackFunction_t pxCallbackFunction,
+                                          StaticHRTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vHRTimerDelete( HRTimerHandle_t xTimer );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Stops a high resolution timer and, if it was created with xHRTimerCreate(),
+ * frees its memory.  The application must ensure the timer's callback function
+ * is not executing when the timer is deleted.
+ *
+ * @param xTimer The handle of the timer being deleted.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    void vHRTimerDelete( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerStart( HRTimerHandle_t xTimer, const HRTimerCount_t xDelay );
+ * BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer, const HRTimerCount_t xDelay );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * these functions to be available.
+ *
+ * Starts a high resolution timer so it expires xDelay counts of the hardware
+ * timer after the time at which the function is called.  If the timer was
+ * already running it is restarted.  If the timer expired but its callback
+ * function has not executed yet then the callback function will still
+ * execute.
+ *
+ * Unlike the software timer API, the timer is started immediately - there is
+ * no command queue and no block time.  xHRTimerStartFromISR() is the version
+ * that can be called from an interrupt service routine, including from the
+ * callback function of a timer that executes from the interrupt.
+ *
+ * @param xTimer The handle of the timer being started.
+ *
+ * @param xDelay The number of counts of the hardware timer after which the
+ * timer expires.  tmrUS_TO_HR_COUNTS() can be used to convert a time in
+ * microseconds to counts.  Must not exceed tmrHR_MAX_DELAY.
+ *
+ * @return pdFAIL if xDelay exceeds tmrHR_MAX_DELAY, otherwise pdPASS.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerStart( HRTimerHandle_t xTimer,
+                              const HRTimerCount_t xDelay ) PRIVILEGED_FUNCTION;
+    BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer,
+                                     const HRTimerCount_t xDelay ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerStop( HRTimerHandle_t xTimer );
+ * BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * these functions to be available.
+ *
+ * Stops a high resolution timer.  If the timer expired but its callback
+ * function has not started to execute yet then the callback function will not
+ * execute.  xHRTimerStopFromISR() is the version that can be called from an
+ * interrupt service routine.
+ *
+ * @param xTimer The handle of the timer being stopped.
+ *
+ * @return pdTRUE if the timer was running, or its callback function was
+ * pending, otherwise pdFALSE.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerStop( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+    BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Queries a high resolution timer to see if it is running.
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @return pdFALSE will be returned if the timer is not running (it has not
+ * been started, has been stopped, or has expired).  Otherwise pdTRUE is
+ * returned.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void * pvHRTimerGetTimerID( HRTimerHandle_t xTimer );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Returns the ID assigned to a high resolution timer when it was created.
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @return The ID assigned to the timer being queried.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    void * pvHRTimerGetTimerID( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * HRTimerCount_t xHRTimerGetCount( void );
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @return The current count of the hardware timer used by high resolution
+ * timers.  The count increments portHR_TIMER_COUNTS_PER_SECOND times a second.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    HRTimerCount_t xHRTimerGetCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by the port from the interrupt generated by the compare set with
+ * portHR_TIMER_SET_COMPARE().  Processes the high resolution timers that have
+ * expired and returns pdTRUE if a context switch should be performed before
+ * the interrupt exits.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerInterruptHandler( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Splitting the xTimerGenericCommand into two sub functions and making it a macro
  * removes a recursion path when called from ISRs. This is primarily for the XCore
@@ -1398,6 +1802,50 @@ BaseType_t xTimerGenericCommandFromISR( TimerHandle_t xTimer,
                                          StackType_t ** ppxTimerTaskStackBuffer,
                                          configSTACK_DEPTH_TYPE * puxTimerTaskStackSize );
 
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPerCoreTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer, StackType_t ** ppxTimerTaskStackBuffer, configSTACK_DEPTH_TYPE * puxTimerTaskStackSize, BaseType_t xTimerTaskIndex )
+ * @endcode
+ *
+ * This function is used to provide statically allocated blocks of memory to FreeRTOS to hold the TCBs of
+ * the additional timer tasks created when configUSE_PER_CORE_TIMER_TASKS is set to 1.  The timer task of
+ * core 0 uses the memory provided by vApplicationGetTimerTaskMemory(), and vApplicationGetPerCoreTimerTaskMemory()
+ * is called with timer task index 0, 1 ... ( configNUMBER_OF_CORES - 2 ) to get memory for the timer tasks of
+ * cores 1, 2 ... ( configNUMBER_OF_CORES - 1 ).
+ *
+ * @param ppxTimerTaskTCBBuffer   A handle to a statically allocated TCB buffer
+ * @param ppxTimerTaskStackBuffer A handle to a statically allocated Stack buffer for the timer task
+ * @param puxTimerTaskStackSize   A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xTimerTaskIndex         The index of the timer task buffer
+ */
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        void vApplicationGetPerCoreTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                                    StackType_t ** ppxTimerTaskStackBuffer,
+                                                    configSTACK_DEPTH_TYPE * puxTimerTaskStackSize,
+                                                    BaseType_t xTimerTaskIndex );
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetHRTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer, StackType_t ** ppxTimerTaskStackBuffer, configSTACK_DEPTH_TYPE * puxTimerTaskStackSize )
+ * @endcode
+ *
+ * This function is used to provide a statically allocated block of memory to FreeRTOS to hold the TCB of the
+ * task that executes high resolution timer callbacks.  This function is required when configSUPPORT_STATIC_ALLOCATION
+ * and configUSE_HIGH_RESOLUTION_TIMERS are both set to 1.
+ *
+ * @param ppxTimerTaskTCBBuffer   A handle to a statically allocated TCB buffer
+ * @param ppxTimerTaskStackBuffer A handle to a statically allocated Stack buffer for the high resolution timer task
+ * @param puxTimerTaskStackSize   A pointer to the number of elements that will fit in the allocated stack buffer
+ */
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+        void vApplicationGetHRTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                               StackType_t ** ppxTimerTaskStackBuffer,
+                                               configSTACK_DEPTH_TYPE * puxTimerTaskStackSize );
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 #endif
 
 #if ( configUSE_DAEMON_TASK_STARTUP_HOOK != 0 )
@@ -0,0 +1,511 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include trace_recorder.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * The trace recorder records kernel events into a fixed size binary buffer
+ * for each core.  Each event is a record holding a timestamp, an event code
+ * and two parameters, the first of which is wide enough to hold a handle.  A
+ * record is 16 bytes on targets with pointers of up to 32 bits, and 24 bytes on
+ * targets with 64-bit pointers.  Events are written by the core on which they
+ * occur with only that core's interrupts masked, so recording does not take
+ * any lock that is shared between cores.  When a core's buffer is full the
+ * oldest events are overwritten.
+ *
+ * The recorder is included by setting configUSE_TRACE_RECORDER to 1 in
+ * FreeRTOSConfig.h.  It then defines each of the kernel's trace macros that is
+ * not already defined in FreeRTOSConfig.h, so the application can override or
+ * remove individual events - for example defining traceTASK_INCREMENT_TICK()
+ * to nothing in FreeRTOSConfig.h stops the tick being recorded.
+ *
+ * The buffers are written out by vTraceRecorderDump() and can be converted to
+ * a timeline by tools/trace_recorder/decode_trace.py.
+ */
+
+/* The timestamp of each event is read from configTRACE_RECORDER_TIMESTAMP(),
+ * which must return a free running count that increments
+ * configTRACE_RECORDER_TIMESTAMP_FREQUENCY times a second.  By default the
+ * port's high resolution timer is used.  Only the low 48 bits of the count are
+ * recorded. */
+#ifndef configTRACE_RECORDER_TIMESTAMP
+    #ifdef portHR_TIMER_GET_COUNT
+        #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint64_t ) portHR_TIMER_GET_COUNT() )
+    #else
+        #error configUSE_TRACE_RECORDER is set to 1 but the port does not provide a high resolution timer, so configTRACE_RECORDER_TIMESTAMP() must be defined in FreeRTOSConfig.h.
+    #endif
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP_FREQUENCY
+    #ifdef portHR_TIMER_COUNTS_PER_SECOND
+        #define configTRACE_RECORDER_TIMESTAMP_FREQUENCY    portHR_TIMER_COUNTS_PER_SECOND
+    #else
+        #error configUSE_TRACE_RECORDER is set to 1 but configTRACE_RECORDER_TIMESTAMP_FREQUENCY is not defined.
+    #endif
+#endif
+
+/* Event codes.  The meaning of the two parameters of each event is given in
+ * the comment, a handle being the address of the task, queue, timer, event
+ * group or stream buffer. */
+#define traceRECORDER_EVENT_TASK_SWITCHED_IN              ( ( uint8_t ) 1U )   /* Task handle, priority. */
+#define traceRECORDER_EVENT_TASK_SWITCHED_OUT             ( ( uint8_t ) 2U )   /* Task handle. */
+#define traceRECORDER_EVENT_TASK_CREATE                   ( ( uint8_t ) 3U )   /* Task handle, priority. */
+#define traceRECORDER_EVENT_TASK_DELETE                   ( ( uint8_t ) 4U )   /* Task handle. */
+#define traceRECORDER_EVENT_TASK_READY                    ( ( uint8_t ) 5U )   /* Task handle. */
+#define traceRECORDER_EVENT_TASK_DELAY                    ( ( uint8_t ) 6U )   /* Ticks to delay. */
+#define traceRECORDER_EVENT_TASK_DELAY_UNTIL              ( ( uint8_t ) 7U )   /* Tick count at which the task will wake. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_SET             ( ( uint8_t ) 8U )   /* Task handle, new priority. */
+#define traceRECORDER_EVENT_TASK_SUSPEND                  ( ( uint8_t ) 9U )   /* Task handle. */
+#define traceRECORDER_EVENT_TASK_RESUME                   ( ( uint8_t ) 10U )  /* Task handle. */
+#define traceRECORDER_EVENT_TASK_RESUME_FROM_ISR          ( ( uint8_t ) 11U )  /* Task handle. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_INHERIT         ( ( uint8_t ) 12U )  /* Mutex holder's task handle, inherited priority. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT      ( ( uint8_t ) 13U )  /* Mutex holder's task handle, original priority. */
+#define traceRECORDER_EVENT_TICK                          ( ( uint8_t ) 14U )  /* Tick count. */
+#define traceRECORDER_EVENT_QUEUE_CREATE                  ( ( uint8_t ) 20U )  /* Queue handle, queue length. */
+#define traceRECORDER_EVENT_MUTEX_CREATE                  ( ( uint8_t ) 21U )  /* Mutex handle. */
+#define traceRECORDER_EVENT_QUEUE_SEND                    ( ( uint8_t ) 22U )  /* Queue handle, items in the queue before the send. */
+#define traceRECORDER_EVENT_QUEUE_SEND_FAILED             ( ( uint8_t ) 23U )  /* Queue handle, items in the queue. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE                 ( ( uint8_t ) 24U )  /* Queue handle, items in the queue before the receive. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED          ( ( uint8_t ) 25U )  /* Queue handle, items in the queue. */
+#define traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR           ( ( uint8_t ) 26U )  /* Queue handle, items in the queue before the send. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR        ( ( uint8_t ) 27U )  /* Queue handle, items in the queue before the receive. */
+#define traceRECORDER_EVENT_QUEUE_BLOCK_SEND              ( ( uint8_t ) 28U )  /* Queue handle. */
+#define traceRECORDER_EVENT_QUEUE_BLOCK_RECEIVE           ( ( uint8_t ) 29U )  /* Queue handle. */
+#define traceRECORDER_EVENT_QUEUE_DELETE                  ( ( uint8_t ) 30U )  /* Queue handle. */
+#define traceRECORDER_EVENT_NOTIFY                        ( ( uint8_t ) 40U )  /* Task handle, notification index. */
+#define traceRECORDER_EVENT_NOTIFY_FROM_ISR               ( ( uint8_t ) 41U )  /* Task handle, notification index. */
+#define traceRECORDER_EVENT_NOTIFY_GIVE_FROM_ISR          ( ( uint8_t ) 42U )  /* Task handle, notification index. */
+#define traceRECORDER_EVENT_NOTIFY_BLOCK                  ( ( uint8_t ) 43U )  /* Notification index. */
+#define traceRECORDER_EVENT_NOTIFY_RECEIVED               ( ( uint8_t ) 44U )  /* Notification index. */
+#define traceRECORDER_EVENT_MALLOC                        ( ( uint8_t ) 50U )  /* Address, size. */
+#define traceRECORDER_EVENT_FREE                          ( ( uint8_t ) 51U )  /* Address, size. */
+#define traceRECORDER_EVENT_TIMER_CREATE                  ( ( uint8_t ) 60U )  /* Timer handle. */
+#define traceRECORDER_EVENT_TIMER_COMMAND                 ( ( uint8_t ) 61U )  /* Timer handle, command ID. */
+#define traceRECORDER_EVENT_TIMER_EXPIRED                 ( ( uint8_t ) 62U )  /* Timer handle. */
+#define traceRECORDER_EVENT_EVENT_GROUP_CREATE            ( ( uint8_t ) 70U )  /* Event group handle. */
+#define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS          ( ( uint8_t ) 71U )  /* Event group handle, bits to set. */
+#define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS_FROM_ISR ( ( uint8_t ) 72U )  /* Event group handle, bits to set. */
+#define traceRECORDER_EVENT_EVENT_GROUP_BLOCK             ( ( uint8_t ) 73U )  /* Event group handle, bits to wait for. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_CREATE          ( ( uint8_t ) 80U )  /* Stream buffer handle, stream buffer type. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_SEND            ( ( uint8_t ) 81U )  /* Stream buffer handle, bytes sent. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_SEND_FROM_ISR   ( ( uint8_t ) 82U )  /* Stream buffer handle, bytes sent. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE         ( ( uint8_t ) 83U )  /* Stream buffer handle, bytes received. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE_FROM_ISR ( ( uint8_t ) 84U ) /* Stream buffer handle, bytes received. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_BLOCK_SEND      ( ( uint8_t ) 85U )  /* Stream buffer handle. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_BLOCK_RECEIVE   ( ( uint8_t ) 86U )  /* Stream buffer handle. */
+#define traceRECORDER_EVENT_ISR_ENTER                     ( ( uint8_t ) 90U )  /* No parameters. */
+#define traceRECORDER_EVENT_ISR_EXIT                      ( ( uint8_t ) 91U )  /* No parameters. */
+#define traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER         ( ( uint8_t ) 92U )  /* No parameters. */
+#define traceRECORDER_EVENT_LOW_POWER_IDLE_BEGIN          ( ( uint8_t ) 100U ) /* No parameters. */
+#define traceRECORDER_EVENT_LOW_POWER_IDLE_END            ( ( uint8_t ) 101U ) /* No parameters. */
+#define traceRECORDER_EVENT_USER                          ( ( uint8_t ) 200U ) /* Event ID, value. */
+
+/* Convert a handle or address to an event parameter.  The whole handle is
+ * recorded, so handles that differ only above bit 31 are not confused. */
+#define traceRECORDER_HANDLE( pvHandle )    ( ( portPOINTER_SIZE_TYPE ) ( pvHandle ) )
+
+/* Record an event with its first parameter converted to portPOINTER_SIZE_TYPE
+ * and its second parameter converted to uint32_t. */
+#define traceRECORDER_EVENT( ucEventCode, xParameter1, xParameter2 ) \
+    vTraceRecorderEvent( ( ucEventCode ), ( portPOINTER_SIZE_TYPE ) ( xParameter1 ), ( uint32_t ) ( xParameter2 ) )
+
+/* Trace macros implemented by the recorder. */
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_SWITCHED_IN, traceRECORDER_HANDLE( pxCurrentTCB ), pxCurrentTCB->uxPriority )
+#endif
+
+#ifndef traceTASK_SWITCHED_OUT
+    #define traceTASK_SWITCHED_OUT()    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_SWITCHED_OUT, traceRECORDER_HANDLE( pxCurrentTCB ), 0U )
+#endif
+
+#ifndef traceTASK_CREATE
+    #define traceTASK_CREATE( pxNewTCB )                                                                                  \
+    do {                                                                                                                  \
+        vTraceRecorderObjectName( ( pxNewTCB ), ( pxNewTCB )->pcTaskName );                                               \
+        traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_CREATE, traceRECORDER_HANDLE( pxNewTCB ), ( pxNewTCB )->uxPriority ); \
+    } while( 0 )
+#endif
+
+#ifndef traceTASK_DELETE
+    #define traceTASK_DELETE( pxTaskToDelete )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_DELETE, traceRECORDER_HANDLE( pxTaskToDelete ), 0U )
+#endif
+
+#ifndef traceMOVED_TASK_TO_READY_STATE
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_READY, traceRECORDER_HANDLE( pxTCB ), 0U )
+#endif
+
+#ifndef traceTASK_DELAY
+    #define traceTASK_DELAY()    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_DELAY, xTicksToDelay, 0U )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+    #define traceTASK_DELAY_UNTIL( x )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_DELAY_UNTIL, ( x ), 0U )
+#endif
+
+#ifndef traceTASK_PRIORITY_SET
+    #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_PRIORITY_SET, traceRECORDER_HANDLE( pxTask ), ( uxNewPriority ) )
+#endif
+
+#ifndef traceTASK_SUSPEND
+    #define traceTASK_SUSPEND( pxTaskToSuspend )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_SUSPEND, traceRECORDER_HANDLE( pxTaskToSuspend ), 0U )
+#endif
+
+#ifndef traceTASK_RESUME
+    #define traceTASK_RESUME( pxTaskToResume )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_RESUME, traceRECORDER_HANDLE( pxTaskToResume ), 0U )
+#endif
+
+#ifndef traceTASK_RESUME_FROM_ISR
+    #define traceTASK_RESUME_FROM_ISR( pxTaskToResume )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_RESUME_FROM_ISR, traceRECORDER_HANDLE( pxTaskToResume ), 0U )
+#endif
+
+#ifndef traceTASK_PRIORITY_INHERIT
+    #define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_PRIORITY_INHERIT, traceRECORDER_HANDLE( pxTCBOfMutexHolder ), ( uxInheritedPriority ) )
+#endif
+
+#ifndef traceTASK_PRIORITY_DISINHERIT
+    #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )    traceRECORDER_EVENT( traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT, traceRECORDER_HANDLE( pxTCBOfMutexHolder ), ( uxOriginalPriority ) )
+#endif
+
+#ifndef traceTASK_INCREMENT_TICK
+    #define traceTASK_INCREMENT_TICK( xTickCount )    traceRECORDER_EVENT( traceRECORDER_EVENT_TICK, ( xTickCount ), 0U )
+#endif
+
+#ifndef traceQUEUE_CREATE
+    #define traceQUEUE_CREATE( pxNewQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_CREATE, traceRECORDER_HANDLE( pxNewQueue ), ( pxNewQueue )->uxLength )
+#endif
+
+#ifndef traceCREATE_MUTEX
+    #define traceCREATE_MUTEX( pxNewQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_MUTEX_CREATE, traceRECORDER_HANDLE( pxNewQueue ), 0U )
+#endif
+
+#ifndef traceQUEUE_SEND
+    #define traceQUEUE_SEND( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_SEND, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_SEND_FAILED
+    #define traceQUEUE_SEND_FAILED( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_SEND_FAILED, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE
+    #define traceQUEUE_RECEIVE( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_RECEIVE, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FAILED
+    #define traceQUEUE_RECEIVE_FAILED( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR
+    #define traceQUEUE_SEND_FROM_ISR( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+    #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR, traceRECORDER_HANDLE( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_BLOCK_SEND, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_BLOCK_RECEIVE, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceQUEUE_DELETE
+    #define traceQUEUE_DELETE( pxQueue )    traceRECORDER_EVENT( traceRECORDER_EVENT_QUEUE_DELETE, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceQUEUE_REGISTRY_ADD
+    #define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )    vTraceRecorderObjectName( ( xQueue ), ( pcQueueName ) )
+#endif
+
+#ifndef traceTASK_NOTIFY
+    #define traceTASK_NOTIFY( uxIndexToNotify )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY, traceRECORDER_HANDLE( xTaskToNotify ), ( uxIndexToNotify ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_FROM_ISR
+    #define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_FROM_ISR, traceRECORDER_HANDLE( xTaskToNotify ), ( uxIndexToNotify ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+    #define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_GIVE_FROM_ISR, traceRECORDER_HANDLE( xTaskToNotify ), ( uxIndexToNotify ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+    #define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_BLOCK, ( uxIndexToWait ), 0U )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+    #define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_BLOCK, ( uxIndexToWait ), 0U )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE
+    #define traceTASK_NOTIFY_TAKE( uxIndexToWait )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_RECEIVED, ( uxIndexToWait ), 0U )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT
+    #define traceTASK_NOTIFY_WAIT( uxIndexToWait )    traceRECORDER_EVENT( traceRECORDER_EVENT_NOTIFY_RECEIVED, ( uxIndexToWait ), 0U )
+#endif
+
+#ifndef traceMALLOC
+    #define traceMALLOC( pvAddress, uiSize )    traceRECORDER_EVENT( traceRECORDER_EVENT_MALLOC, traceRECORDER_HANDLE( pvAddress ), ( uiSize ) )
+#endif
+
+#ifndef traceFREE
+    #define traceFREE( pvAddress, uiSize )    traceRECORDER_EVENT( traceRECORDER_EVENT_FREE, traceRECORDER_HANDLE( pvAddress ), ( uiSize ) )
+#endif
+
+#ifndef traceTIMER_CREATE
+    #define traceTIMER_CREATE( pxNewTimer )                                                                   \
+    do {                                                                                                      \
+        vTraceRecorderObjectName( ( pxNewTimer ), ( pxNewTimer )->pcTimerName );                              \
+        traceRECORDER_EVENT( traceRECORDER_EVENT_TIMER_CREATE, traceRECORDER_HANDLE( pxNewTimer ), 0U );      \
+    } while( 0 )
+#endif
+
+#ifndef traceTIMER_COMMAND_SEND
+    #define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn )    traceRECORDER_EVENT( traceRECORDER_EVENT_TIMER_COMMAND, traceRECORDER_HANDLE( xTimer ), ( xMessageID ) )
+#endif
+
+#ifndef traceTIMER_EXPIRED
+    #define traceTIMER_EXPIRED( pxTimer )    traceRECORDER_EVENT( traceRECORDER_EVENT_TIMER_EXPIRED, traceRECORDER_HANDLE( pxTimer ), 0U )
+#endif
+
+#ifndef traceEVENT_GROUP_CREATE
+    #define traceEVENT_GROUP_CREATE( xEventGroup )    traceRECORDER_EVENT( traceRECORDER_EVENT_EVENT_GROUP_CREATE, traceRECORDER_HANDLE( xEventGroup ), 0U )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+    #define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )    traceRECORDER_EVENT( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS, traceRECORDER_HANDLE( xEventGroup ), ( uxBitsToSet ) )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+    #define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )    traceRECORDER_EVENT( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS_FROM_ISR, traceRECORDER_HANDLE( xEventGroup ), ( uxBitsToSet ) )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+    #define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )    traceRECORDER_EVENT( traceRECORDER_EVENT_EVENT_GROUP_BLOCK, traceRECORDER_HANDLE( xEventGroup ), ( uxBitsToWaitFor ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+    #define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xStreamBufferType )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_CREATE, traceRECORDER_HANDLE( pxStreamBuffer ), ( xStreamBufferType ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+    #define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_SEND, traceRECORDER_HANDLE( xStreamBuffer ), ( xBytesSent ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+    #define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_SEND_FROM_ISR, traceRECORDER_HANDLE( xStreamBuffer ), ( xBytesSent ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+    #define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE, traceRECORDER_HANDLE( xStreamBuffer ), ( xReceivedLength ) )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+    #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE_FROM_ISR, traceRECORDER_HANDLE( xStreamBuffer ), ( xReceivedLength ) )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+    #define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_BLOCK_SEND, traceRECORDER_HANDLE( xStreamBuffer ), 0U )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+    #define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )    traceRECORDER_EVENT( traceRECORDER_EVENT_STREAM_BUFFER_BLOCK_RECEIVE, traceRECORDER_HANDLE( xStreamBuffer ), 0U )
+#endif
+
+#ifndef traceISR_ENTER
+    #define traceISR_ENTER()    traceRECORDER_EVENT( traceRECORDER_EVENT_ISR_ENTER, 0U, 0U )
+#endif
+
+#ifndef traceISR_EXIT
+    #define traceISR_EXIT()    traceRECORDER_EVENT( traceRECORDER_EVENT_ISR_EXIT, 0U, 0U )
+#endif
+
+#ifndef traceISR_EXIT_TO_SCHEDULER
+    #define traceISR_EXIT_TO_SCHEDULER()    traceRECORDER_EVENT( traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER, 0U, 0U )
+#endif
+
+#ifndef traceLOW_POWER_IDLE_BEGIN
+    #define traceLOW_POWER_IDLE_BEGIN()    traceRECORDER_EVENT( traceRECORDER_EVENT_LOW_POWER_IDLE_BEGIN, 0U, 0U )
+#endif
+
+#ifndef traceLOW_POWER_IDLE_END
+    #define traceLOW_POWER_IDLE_END()    traceRECORDER_EVENT( traceRECORDER_EVENT_LOW_POWER_IDLE_END, 0U, 0U )
+#endif
+
+/**
+ * trace_recorder.h
+ *
+ * Type of the function vTraceRecorderDump() calls to write out the recorded
+ * trace.  The function is called several times, each call passing the next
+ * xLength bytes of the trace in pvData.  pvContext is the value passed to
+ * vTraceRecorderDump().
+ */
+typedef void (* TraceRecorderWriteFunction_t)( const void * pvData,
+                                               size_t xLength,
+                                               void * pvContext );
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceRecorderStart( void );
+ * @endcode
+ *
+ * Start recording events.  The recorder does not record events until
+ * vTraceRecorderStart() is called, but always records the names of tasks,
+ * timers and queues added to the queue registry, so it can be started at any
+ * time.  Call vTraceRecorderStart() before vTaskStartScheduler() to record
+ * the start of the scheduler.
+ *
+ * \defgroup vTraceRecorderStart vTraceRecorderStart
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceRecorderStop( void );
+ * @endcode
+ *
+ * Stop recording events.  The events already recorded are kept.
+ *
+ * \defgroup vTraceRecorderStop vTraceRecorderStop
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceRecorderClear( void );
+ * @endcode
+ *
+ * Discard the recorded events of all cores.  Recorded object names are kept.
+ * Must only be called while the recorder is stopped.
+ *
+ * \defgroup vTraceRecorderClear vTraceRecorderClear
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderClear( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceRecorderUserEvent( uint32_t ulEventID, uint32_t ulValue );
+ * @endcode
+ *
+ * Record an application defined event.  Can be called from a task or an
+ * interrupt.
+ *
+ * @param ulEventID Identifies the event to the application.
+ *
+ * @param ulValue A value recorded with the event.
+ *
+ * \defgroup vTraceRecorderUserEvent vTraceRecorderUserEvent
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderUserEvent( uint32_t ulEventID,
+                              uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWriteFunction, void * pvContext );
+ * @endcode
+ *
+ * Write out the recorded object names and events by calling pxWriteFunction.
+ * vTraceRecorderStop() must be called before the trace is dumped, otherwise
+ * events recorded during the dump can corrupt it.
+ *
+ * The trace is written in the byte order of the target.  It starts with a
+ * header, followed by the object names, followed by the events of each core
+ * in the order they were recorded.  tools/trace_recorder/decode_trace.py
+ * converts the trace to a Perfetto or Chrome JSON trace.
+ *
+ * @param pxWriteFunction The function called to write each part of the trace.
+ *
+ * @param pvContext Passed to pxWriteFunction.
+ *
+ * Example usage:
+ * @code{c}
+ *
+ *  static void prvWriteToFile( const void * pvData, size_t xLength, void * pvContext )
+ *  {
+ *      fwrite( pvData, 1, xLength, ( FILE * ) pvContext );
+ *  }
+ *
+ *  void vWriteTrace( void )
+ *  {
+ *      FILE * pxFile = fopen( "trace.bin", "wb" );
+ *
+ *      vTraceRecorderStop();
+ *      vTraceRecorderDump( prvWriteToFile, pxFile );
+ *      fclose( pxFile );
+ *  }
+ * @endcode
+ * \defgroup vTraceRecorderDump vTraceRecorderDump
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWriteFunction,
+                         void * pvContext ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record an event.  Used by the trace macros defined above, not intended to be
+ * called directly by the application.
+ */
+void vTraceRecorderEvent( uint8_t ucEventCode,
+                          portPOINTER_SIZE_TYPE uxParameter1,
+                          uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record the name of a task, timer or queue.  Used by the trace macros defined
+ * above, not intended to be called directly by the application.
+ */
+void vTraceRecorderObjectName( const void * pvObject,
+                               const char * pcName ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* TRACE_RECORDER_H */
@@ -42,6 +42,43 @@
  * generate the correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+/* Colours of the items indexed by a list's red-black tree.  Items that are not
+ * indexed hold listTREE_NOT_INDEXED instead. */
+    #define listTREE_RED      ( ( UBaseType_t ) 1U )
+    #define listTREE_BLACK    ( ( UBaseType_t ) 2U )
+
+/* A missing (NULL) child counts as a black leaf. */
+    #define listTREE_IS_BLACK( pxItem )    ( ( ( pxItem ) == NULL ) || ( ( pxItem )->uxTreeColour == listTREE_BLACK ) )
+
+/*
+ * Make pxNewChild take the place of pxOldChild below pxParent, or at the root
+ * of the tree if pxParent is NULL.
+ */
+    static void prvTreeReplaceChild( List_t * const pxList,
+                                     ListItem_t * const pxParent,
+                                     const ListItem_t * const pxOldChild,
+                                     ListItem_t * const pxNewChild ) PRIVILEGED_FUNCTION;
+
+/*
+ * Standard red-black tree rotations.  Rotations change the shape of the tree
+ * but not its in-order sequence, so the linked list order is unaffected.
+ */
+    static void prvTreeRotateLeft( List_t * const pxList,
+                                   ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+    static void prvTreeRotateRight( List_t * const pxList,
+                                    ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Link pxNewListItem into the tree and return the indexed item that should
+ * follow it in the linked list, or NULL if it belongs at the end of the list.
+ */
+    static ListItem_t * prvTreeInsert( List_t * const pxList,
+                                       ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+
 /*-----------------------------------------------------------
 * PUBLIC LIST API documented in list.h
 *----------------------------------------------------------*/
@@ -77,6 +114,12 @@ void vListInitialise( List_t * const pxList )
 
     pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+    {
+        pxList->pxTreeRoot = NULL;
+    }
+    #endif
+
     /* Write known values into the list if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
     listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -92,6 +135,7 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 
     /* Make sure the list item is not recorded as being on a list. */
     pxItem->pxContainer = NULL;
+    listSET_ITEM_NOT_INDEXED( pxItem );
 
     /* Write known values into the list item if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -120,6 +164,7 @@ void vListInsertEnd( List_t * const pxList,
      * listGET_OWNER_OF_NEXT_ENTRY(). */
     pxNewListItem->pxNext = pxIndex;
     pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    listSET_ITEM_NOT_INDEXED( pxNewListItem );
 
     /* Only used during decision coverage testing. */
     mtCOVERAGE_TEST_DELAY();
@@ -140,7 +185,12 @@ void vListInsert( List_t * const pxList,
                   ListItem_t * const pxNewListItem )
 {
     ListItem_t * pxIterator;
-    const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
+        ListItem_t * pxSuccessor;
+    #else
+        const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+    #endif
 
     traceENTER_vListInsert( pxList, pxNewListItem );
 
@@ -150,53 +200,73 @@ void vListInsert( List_t * const pxList,
     listTEST_LIST_INTEGRITY( pxList );
     listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
-    /* Insert the new list item into the list, sorted in xItemValue order.
-     *
-     * If the list already contains a list item with the same item value then the
-     * new list item should be placed after it.  This ensures that TCBs which are
-     * stored in ready lists (all of which have the same xItemValue value) get a
-     * share of the CPU.  However, if the xItemValue is the same as the back marker
-     * the iteration loop below will not end.  Therefore the value is checked
-     * first, and the algorithm slightly modified if necessary. */
-    if( xValueOfInsertion == portMAX_DELAY )
+    #if ( configUSE_ORDERED_LIST_TREE == 1 )
     {
-        pxIterator = pxList->xListEnd.pxPrevious;
+        /* The tree gives the same position as the linear search below: the
+         * new item is placed after any indexed items that have the same item
+         * value, and before the first indexed item with a greater value. */
+        pxSuccessor = prvTreeInsert( pxList, pxNewListItem );
+
+        if( pxSuccessor != NULL )
+        {
+            pxIterator = pxSuccessor->pxPrevious;
+        }
+        else
+        {
+            pxIterator = pxList->xListEnd.pxPrevious;
+        }
     }
-    else
+    #else /* if ( configUSE_ORDERED_LIST_TREE == 1 ) */
     {
-        /* *** NOTE ***********************************************************
-        *  If you find your application is crashing here then likely causes are
-        *  listed below.  In addition see https://www.FreeRTOS.org/FAQHelp.html for
-        *  more tips, and ensure configASSERT() is defined!
-        *  https://www.FreeRTOS.org/a00110.html#configASSERT
-        *
-        *   1) Stack overflow -
-        *      see https://www.FreeRTOS.org/Stacks-and-stack-overflow-checking.html
-        *   2) Incorrect interrupt priority assignment, especially on Cortex-M
-        *      parts where numerically high priority values denote low actual
-        *      interrupt priorities, which can seem counter intuitive.  See
-        *      https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html and the definition
-        *      of configMAX_SYSCALL_INTERRUPT_PRIORITY on
-        *      https://www.FreeRTOS.org/a00110.html
-        *   3) Calling an API function from within a critical section or when
-        *      the scheduler is suspended, or calling an API function that does
-        *      not end in "FromISR" from an interrupt.
-        *   4) Using a queue or semaphore before it has been initialised or
-        *      before the scheduler has been started (are interrupts firing
-        *      before vTaskStartScheduler() has been called?).
-        *   5) If the FreeRTOS port supports interrupt nesting then ensure that
-        *      the priority of the tick interrupt is at or below
-        *      configMAX_SYSCALL_INTERRUPT_PRIORITY.
-        **********************************************************************/
-
-        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
-        {
-            /* There is nothing to do here, just iterating to the wanted
-             * insertion position.
-             * IF YOU FIND YOUR CODE STUCK HERE, SEE THE NOTE JUST ABOVE.
-             */
+        /* Insert the new list item into the list, sorted in xItemValue order.
+         *
+         * If the list already contains a list item with the same item value then the
+         * new list item should be placed after it.  This ensures that TCBs which are
+         * stored in ready lists (all of which have the same xItemValue value) get a
+         * share of the CPU.  However, if the xItemValue is the same as the back marker
+         * the iteration loop below will not end.  Therefore the value is checked
+         * first, and the algorithm slightly modified if necessary. */
+        if( xValueOfInsertion == portMAX_DELAY )
+        {
+            pxIterator = pxList->xListEnd.pxPrevious;
+        }
+        else
+        {
+            /* *** NOTE ***********************************************************
+            *  If you find your application is crashing here then likely causes are
+            *  listed below.  In addition see https://www.FreeRTOS.org/FAQHelp.html for
+            *  more tips, and ensure configASSERT() is defined!
+            *  https://www.FreeRTOS.org/a00110.html#configASSERT
+            *
+            *   1) Stack overflow -
+            *      see https://www.FreeRTOS.org/Stacks-and-stack-overflow-checking.html
+            *   2) Incorrect interrupt priority assignment, especially on Cortex-M
+            *      parts where numerically high priority values denote low actual
+            *      interrupt priorities, which can seem counter intuitive.  See
+            *      https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html and the definition
+            *      of configMAX_SYSCALL_INTERRUPT_PRIORITY on
+            *      https://www.FreeRTOS.org/a00110.html
+            *   3) Calling an API function from within a critical section or when
+            *      the scheduler is suspended, or calling an API function that does
+            *      not end in "FromISR" from an interrupt.
+            *   4) Using a queue or semaphore before it has been initialised or
+            *      before the scheduler has been started (are interrupts firing
+            *      before vTaskStartScheduler() has been called?).
+            *   5) If the FreeRTOS port supports interrupt nesting then ensure that
+            *      the priority of the tick interrupt is at or below
+            *      configMAX_SYSCALL_INTERRUPT_PRIORITY.
+            **********************************************************************/
+
+            for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
+            {
+                /* There is nothing to do here, just iterating to the wanted
+                 * insertion position.
+                 * IF YOU FIND YOUR CODE STUCK HERE, SEE THE NOTE JUST ABOVE.
+                 */
+            }
         }
     }
+    #endif /* if ( configUSE_ORDERED_LIST_TREE == 1 ) */
 
     pxNewListItem->pxNext = pxIterator->pxNext;
     pxNewListItem->pxNext->pxPrevious = pxNewListItem;
@@ -222,6 +292,8 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 
     traceENTER_uxListRemove( pxItemToRemove );
 
+    listREMOVE_ITEM_FROM_TREE( pxList, pxItemToRemove );
+
     pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
     pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -246,3 +318,419 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
     return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+    static void prvTreeReplaceChild( List_t * const pxList,
+                                     ListItem_t * const pxParent,
+                                     const ListItem_t * const pxOldChild,
+                                     ListItem_t * const pxNewChild )
+    {
+        if( pxParent == NULL )
+        {
+            pxList->pxTreeRoot = pxNewChild;
+        }
+        else if( pxParent->pxTreeLeft == pxOldChild )
+        {
+            pxParent->pxTreeLeft = pxNewChild;
+        }
+        else
+        {
+            pxParent->pxTreeRight = pxNewChild;
+        }
+    }
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+    static void prvTreeRotateLeft( List_t * const pxList,
+                                   ListItem_t * const pxItem )
+    {
+        ListItem_t * const pxChild = pxItem->pxTreeRight;
+
+        pxItem->pxTreeRight = pxChild->pxTreeLeft;
+
+        if( pxChild->pxTreeLeft != NULL )
+        {
+            pxChild->pxTreeLeft->pxTreeParent = pxItem;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxChild->pxTreeParent = pxItem->pxTreeParent;
+        prvTreeReplaceChild( pxList, pxItem->pxTreeParent, pxItem, pxChild );
+        pxChild->pxTreeLeft = pxItem;
+        pxItem->pxTreeParent = pxChild;
+    }
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+    static void prvTreeRotateRight( List_t * const pxList,
+                                    ListItem_t * const pxItem )
+    {
+        ListItem_t * const pxChild = pxItem->pxTreeLeft;
+
+        pxItem->pxTreeLeft = pxChild->pxTreeRight;
+
+        if( pxChild->pxTreeRight != NULL )
+        {
+            pxChild->pxTreeRight->pxTreeParent = pxItem;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxChild->pxTreeParent = pxItem->pxTreeParent;
+        prvTreeReplaceChild( pxList, pxItem->pxTreeParent, pxItem, pxChild );
+        pxChild->pxTreeRight = pxItem;
+        pxItem->pxTreeParent = pxChild;
+    }
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+    static ListItem_t * prvTreeInsert( List_t * const pxList,
+                                       ListItem_t * const pxNewListItem )
+    {
+        const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+        ListItem_t * pxItem = pxList->pxTreeRoot;
+        ListItem_t * pxParent = NULL;
+        ListItem_t * pxSuccessor = NULL;
+        ListItem_t * pxGrandparent;
+        ListItem_t * pxUncle;
+
+        /* Descend to a leaf position.  Items with an equal value are passed on
+         * the right so the new item follows them, matching vListInsert().  The
+         * last item passed on the left is the new item's in-order successor. */
+        while( pxItem != NULL )
+        {
+            pxParent = pxItem;
+
+            if( xValueOfInsertion < pxItem->xItemValue )
+            {
+                pxSuccessor = pxItem;
+                pxItem = pxItem->pxTreeLeft;
+            }
+            else
+            {
+                pxItem = pxItem->pxTreeRight;
+            }
+        }
+
+        pxNewListItem->pxTreeParent = pxParent;
+        pxNewListItem->pxTreeLeft = NULL;
+        pxNewListItem->pxTreeRight = NULL;
+        pxNewListItem->uxTreeColour = listTREE_RED;
+
+        if( pxParent == NULL )
+        {
+            pxList->pxTreeRoot = pxNewListItem;
+        }
+        else if( pxParent == pxSuccessor )
+        {
+            pxParent->pxTreeLeft = pxNewListItem;
+        }
+        else
+        {
+            pxParent->pxTreeRight = pxNewListItem;
+        }
+
+        /* Restore the red-black properties.  At most two rotations are needed
+         * however many items the list holds. */
+        pxItem = pxNewListItem;
+
+        while( ( pxItem->pxTreeParent != NULL ) && ( pxItem->pxTreeParent->uxTreeColour == listTREE_RED ) )
+        {
+            pxParent = pxItem->pxTreeParent;
+
+            /* A red item is never the root, so the grandparent exists. */
+            pxGrandparent = pxParent->pxTreeParent;
+
+            if( pxParent == pxGrandparent->pxTreeLeft )
+            {
+                pxUncle = pxGrandparent->pxTreeRight;
+
+                if( listTREE_IS_BLACK( pxUncle ) == pdFALSE )
+                {
+                    pxParent->uxTreeColour = listTREE_BLACK;
+                    pxUncle->uxTreeColour = listTREE_BLACK;
+                    pxGrandparent->uxTreeColour = listTREE_RED;
+                    pxItem = pxGrandparent;
+                }
+                else
+                {
+                    if( pxItem == pxParent->pxTreeRight )
+                    {
+                        prvTreeRotateLeft( pxList, pxParent );
+                        pxItem = pxParent;
+                        pxParent = pxItem->pxTreeParent;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxParent->uxTreeColour = listTREE_BLACK;
+                    pxGrandparent->uxTreeColour = listTREE_RED;
+                    prvTreeRotateRight( pxList, pxGrandparent );
+                }
+            }
+            else
+            {
+                pxUncle = pxGrandparent->pxTreeLeft;
+
+                if( listTREE_IS_BLACK( pxUncle ) == pdFALSE )
+                {
+                    pxParent->uxTreeColour = listTREE_BLACK;
+                    pxUncle->uxTreeColour = listTREE_BLACK;
+                    pxGrandparent->uxTreeColour = listTREE_RED;
+                    pxItem = pxGrandparent;
+                }
+                else
+                {
+                    if( pxItem == pxParent->pxTreeLeft )
+                    {
+                        prvTreeRotateRight( pxList, pxParent );
+                        pxItem = pxParent;
+                        pxParent = pxItem->pxTreeParent;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxParent->uxTreeColour = listTREE_BLACK;
+                    pxGrandparent->uxTreeColour = listTREE_RED;
+                    prvTreeRotateLeft( pxList, pxGrandparent );
+                }
+            }
+        }
+
+        pxList->pxTreeRoot->uxTreeColour = listTREE_BLACK;
+
+        return pxSuccessor;
+    }
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ORDERED_LIST_TREE == 1 )
+
+    void vListTreeRemove( List_t * const pxList,
+                          ListItem_t * const pxItemToRemove )
+    {
+        ListItem_t * pxSpliced;
+        ListItem_t * pxChild;
+        ListItem_t * pxParent;
+        ListItem_t * pxSibling;
+        UBaseType_t uxSplicedColour;
+
+        traceENTER_vListTreeRemove( pxList, pxItemToRemove );
+
+        /* Find the item that is physically unlinked from the tree.  That is the
+         * item itself if it has at most one child, otherwise its in-order
+         * successor, which is then moved into the removed item's place. */
+        if( ( pxItemToRemove->pxTreeLeft == NULL ) || ( pxItemToRemove->pxTreeRight == NULL ) )
+        {
+            pxSpliced = pxItemToRemove;
+        }
+        else
+        {
+            pxSpliced = pxItemToRemove->pxTreeRight;
+
+            while( pxSpliced->pxTreeLeft != NULL )
+            {
+                pxSpliced = pxSpliced->pxTreeLeft;
+            }
+        }
+
+        if( pxSpliced->pxTreeLeft != NULL )
+        {
+            pxChild = pxSpliced->pxTreeLeft;
+        }
+        else
+        {
+            pxChild = pxSpliced->pxTreeRight;
+        }
+
+        pxParent = pxSpliced->pxTreeParent;
+        uxSplicedColour = pxSpliced->uxTreeColour;
+
+        if( pxChild != NULL )
+        {
+            pxChild->pxTreeParent = pxParent;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvTreeReplaceChild( pxList, pxParent, pxSpliced, pxChild );
+
+        if( pxSpliced != pxItemToRemove )
+        {
+            if( pxParent == pxItemToRemove )
+            {
+                pxParent = pxSpliced;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxSpliced->pxTreeLeft = pxItemToRemove->pxTreeLeft;
+            pxSpliced->pxTreeRight = pxItemToRemove->pxTreeRight;
+            pxSpliced->pxTreeParent = pxItemToRemove->pxTreeParent;
+            pxSpliced->uxTreeColour = pxItemToRemove->uxTreeColour;
+
+            if( pxSpliced->pxTreeLeft != NULL )
+            {
+                pxSpliced->pxTreeLeft->pxTreeParent = pxSpliced;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxSpliced->pxTreeRight != NULL )
+            {
+                pxSpliced->pxTreeRight->pxTreeParent = pxSpliced;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvTreeReplaceChild( pxList, pxItemToRemove->pxTreeParent, pxItemToRemove, pxSpliced );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Removing a black item leaves its side one black item short.  Push
+         * the deficit up the tree until it can be absorbed, using at most three
+         * rotations. */
+        if( uxSplicedColour == listTREE_BLACK )
+        {
+            while( ( pxChild != pxList->pxTreeRoot ) && ( listTREE_IS_BLACK( pxChild ) != pdFALSE ) )
+            {
+                if( pxChild == pxParent->pxTreeLeft )
+                {
+                    pxSibling = pxParent->pxTreeRight;
+
+                    if( pxSibling->uxTreeColour == listTREE_RED )
+                    {
+                        pxSibling->uxTreeColour = listTREE_BLACK;
+                        pxParent->uxTreeColour = listTREE_RED;
+                        prvTreeRotateLeft( pxList, pxParent );
+                        pxSibling = pxParent->pxTreeRight;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( ( listTREE_IS_BLACK( pxSibling->pxTreeLeft ) != pdFALSE ) && ( listTREE_IS_BLACK( pxSibling->pxTreeRight ) != pdFALSE ) )
+                    {
+                        pxSibling->uxTreeColour = listTREE_RED;
+                        pxChild = pxParent;
+                        pxParent = pxChild->pxTreeParent;
+                    }
+                    else
+                    {
+                        if( listTREE_IS_BLACK( pxSibling->pxTreeRight ) != pdFALSE )
+                        {
+                            pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+                            pxSibling->uxTreeColour = listTREE_RED;
+                            prvTreeRotateRight( pxList, pxSibling );
+                            pxSibling = pxParent->pxTreeRight;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxSibling->uxTreeColour = pxParent->uxTreeColour;
+                        pxParent->uxTreeColour = listTREE_BLACK;
+                        pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+                        prvTreeRotateLeft( pxList, pxParent );
+                        pxChild = pxList->pxTreeRoot;
+                    }
+                }
+                else
+                {
+                    pxSibling = pxParent->pxTreeLeft;
+
+                    if( pxSibling->uxTreeColour == listTREE_RED )
+                    {
+                        pxSibling->uxTreeColour = listTREE_BLACK;
+                        pxParent->uxTreeColour = listTREE_RED;
+                        prvTreeRotateRight( pxList, pxParent );
+                        pxSibling = pxParent->pxTreeLeft;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( ( listTREE_IS_BLACK( pxSibling->pxTreeLeft ) != pdFALSE ) && ( listTREE_IS_BLACK( pxSibling->pxTreeRight ) != pdFALSE ) )
+                    {
+                        pxSibling->uxTreeColour = listTREE_RED;
+                        pxChild = pxParent;
+                        pxParent = pxChild->pxTreeParent;
+                    }
+                    else
+                    {
+                        if( listTREE_IS_BLACK( pxSibling->pxTreeLeft ) != pdFALSE )
+                        {
+                            pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+                            pxSibling->uxTreeColour = listTREE_RED;
+                            prvTreeRotateLeft( pxList, pxSibling );
+                            pxSibling = pxParent->pxTreeLeft;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxSibling->uxTreeColour = pxParent->uxTreeColour;
+                        pxParent->uxTreeColour = listTREE_BLACK;
+                        pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+                        prvTreeRotateRight( pxList, pxParent );
+                        pxChild = pxList->pxTreeRoot;
+                    }
+                }
+            }
+
+            if( pxChild != NULL )
+            {
+                pxChild->uxTreeColour = listTREE_BLACK;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listSET_ITEM_NOT_INDEXED( pxItemToRemove );
+
+        traceRETURN_vListTreeRemove();
+    }
+
+#endif /* configUSE_ORDERED_LIST_TREE */
+/*-----------------------------------------------------------*/
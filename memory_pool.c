@@ -0,0 +1,625 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "memory_pool.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include memory pool functionality. This #if is closed at the very bottom
+ * of this file. If you want to include memory pools then ensure
+ * configUSE_MEMORY_POOLS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_MEMORY_POOLS == 1 )
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define memorypoolYIELD_IF_USING_PREEMPTION()
+    #else
+        #if ( configNUMBER_OF_CORES == 1 )
+            #define memorypoolYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+            #define memorypoolYIELD_IF_USING_PREEMPTION()    vTaskYieldWithinAPI()
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+    #endif
+
+/* The size of the memory pool structure rounded up so the storage area that
+ * follows it in a dynamically allocated pool is correctly aligned. */
+    #define memorypoolSTRUCT_SIZE    ( ( sizeof( MemoryPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Blocks that have been freed are held in a singly linked list, the link being
+ * stored in the first bytes of the free block itself.  Blocks that have never
+ * been allocated are not placed in the list, so creating a pool takes the same
+ * time regardless of the number of blocks. */
+    typedef struct MemoryPoolDef_t
+    {
+        uint8_t * pucStorage;                  /**< Points to the first block in the pool. */
+        uint8_t * pucNextUnusedBlock;          /**< Points to the first block that has never been allocated. */
+        void * pvFreeList;                     /**< Points to the most recently freed block, or NULL if no freed blocks are available. */
+        size_t xBlockSize;                     /**< The size of each block, rounded by memorypoolBLOCK_SIZE(). */
+        UBaseType_t uxNumberOfBlocks;
+        UBaseType_t uxNumberOfUnusedBlocks;    /**< The number of blocks, starting from pucNextUnusedBlock, that have never been allocated. */
+        UBaseType_t uxNumberOfFreeBlocks;
+        UBaseType_t uxMinimumEverFreeBlocks;
+        List_t xTasksWaitingToAllocate;        /**< List of tasks that are blocked waiting to allocate a block.  Stored in priority order. */
+
+        #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the memory pool is statically allocated to ensure no attempt is made to free the memory. */
+        #endif
+    } MemoryPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the fields of a newly created memory pool.
+ */
+    static void prvInitialiseNewMemoryPool( MemoryPool_t * const pxMemoryPool,
+                                            UBaseType_t uxNumberOfBlocks,
+                                            size_t xBlockSize,
+                                            uint8_t * pucPoolStorageBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a block from the pool, returning NULL if all the blocks are in use.
+ * Must be called from a critical section.
+ */
+    static void * prvTakeBlock( MemoryPool_t * const pxMemoryPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a block to the pool and unblock the highest priority task waiting
+ * to allocate a block, if any.  Returns pdTRUE if the unblocked task has a
+ * priority above that of the calling task.  Must be called from a critical
+ * section.
+ */
+    static BaseType_t prvReturnBlock( MemoryPool_t * const pxMemoryPool,
+                                      void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxNumberOfBlocks,
+                                              size_t xBlockSize )
+        {
+            MemoryPool_t * pxMemoryPool = NULL;
+            size_t xRoundedBlockSize;
+
+            traceENTER_xMemoryPoolCreate( uxNumberOfBlocks, xBlockSize );
+
+            configASSERT( uxNumberOfBlocks > ( UBaseType_t ) 0 );
+
+            xRoundedBlockSize = memorypoolBLOCK_SIZE( xBlockSize );
+
+            /* Check for overflow in the size of the storage area and of the
+             * allocation that holds both it and the pool structure. */
+            if( ( xRoundedBlockSize >= xBlockSize ) &&
+                ( xRoundedBlockSize <= ( ( ( ~( size_t ) 0 ) - memorypoolSTRUCT_SIZE ) / ( size_t ) uxNumberOfBlocks ) ) )
+            {
+                /* The pool structure and the storage area are allocated in a
+                 * single block, the storage area following the structure. */
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxMemoryPool = ( MemoryPool_t * ) pvPortMalloc( memorypoolSTRUCT_SIZE + ( ( size_t ) uxNumberOfBlocks * xRoundedBlockSize ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxMemoryPool != NULL )
+            {
+                prvInitialiseNewMemoryPool( pxMemoryPool, uxNumberOfBlocks, xRoundedBlockSize, ( ( uint8_t * ) pxMemoryPool ) + memorypoolSTRUCT_SIZE );
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * this memory pool was allocated dynamically in case it is
+                     * later deleted. */
+                    pxMemoryPool->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                traceMEMORY_POOL_CREATE( pxMemoryPool );
+            }
+            else
+            {
+                traceMEMORY_POOL_CREATE_FAILED();
+            }
+
+            traceRETURN_xMemoryPoolCreate( pxMemoryPool );
+
+            return pxMemoryPool;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxNumberOfBlocks,
+                                                    size_t xBlockSize,
+                                                    uint8_t * pucPoolStorageBuffer,
+                                                    StaticMemoryPool_t * pxStaticMemoryPool )
+        {
+            MemoryPool_t * pxMemoryPool = NULL;
+
+            traceENTER_xMemoryPoolCreateStatic( uxNumberOfBlocks, xBlockSize, pucPoolStorageBuffer, pxStaticMemoryPool );
+
+            configASSERT( uxNumberOfBlocks > ( UBaseType_t ) 0 );
+            configASSERT( pucPoolStorageBuffer );
+            configASSERT( pxStaticMemoryPool );
+
+            /* The blocks are allocated from the storage area, so it must be
+             * aligned for any type the blocks might hold. */
+            configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorageBuffer ) & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0U );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMemoryPool_t equals the size of the real
+                 * memory pool structure. */
+                volatile size_t xSize = sizeof( StaticMemoryPool_t );
+                configASSERT( xSize == sizeof( MemoryPool_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucPoolStorageBuffer != NULL ) && ( pxStaticMemoryPool != NULL ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxMemoryPool = ( MemoryPool_t * ) pxStaticMemoryPool;
+
+                prvInitialiseNewMemoryPool( pxMemoryPool, uxNumberOfBlocks, memorypoolBLOCK_SIZE( xBlockSize ), pucPoolStorageBuffer );
+
+                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                {
+                    /* Both static and dynamic allocation can be used, so note
+                     * that this memory pool was created statically in case it
+                     * is later deleted. */
+                    pxMemoryPool->ucStaticallyAllocated = pdTRUE;
+                }
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+                traceMEMORY_POOL_CREATE( pxMemoryPool );
+            }
+            else
+            {
+                traceMEMORY_POOL_CREATE_FAILED();
+            }
+
+            traceRETURN_xMemoryPoolCreateStatic( pxMemoryPool );
+
+            return pxMemoryPool;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewMemoryPool( MemoryPool_t * const pxMemoryPool,
+                                            UBaseType_t uxNumberOfBlocks,
+                                            size_t xBlockSize,
+                                            uint8_t * pucPoolStorageBuffer ) /* PRIVILEGED_FUNCTION */
+    {
+        pxMemoryPool->pucStorage = pucPoolStorageBuffer;
+        pxMemoryPool->pucNextUnusedBlock = pucPoolStorageBuffer;
+        pxMemoryPool->pvFreeList = NULL;
+        pxMemoryPool->xBlockSize = xBlockSize;
+        pxMemoryPool->uxNumberOfBlocks = uxNumberOfBlocks;
+        pxMemoryPool->uxNumberOfUnusedBlocks = uxNumberOfBlocks;
+        pxMemoryPool->uxNumberOfFreeBlocks = uxNumberOfBlocks;
+        pxMemoryPool->uxMinimumEverFreeBlocks = uxNumberOfBlocks;
+        vListInitialise( &( pxMemoryPool->xTasksWaitingToAllocate ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvTakeBlock( MemoryPool_t * const pxMemoryPool ) /* PRIVILEGED_FUNCTION */
+    {
+        void * pvBlock = NULL;
+
+        if( pxMemoryPool->pvFreeList != NULL )
+        {
+            /* Reuse the most recently freed block, as it is the most likely to
+             * still be in the cache. */
+            pvBlock = pxMemoryPool->pvFreeList;
+            pxMemoryPool->pvFreeList = *( ( void ** ) pvBlock );
+        }
+        else if( pxMemoryPool->uxNumberOfUnusedBlocks > ( UBaseType_t ) 0 )
+        {
+            pvBlock = ( void * ) pxMemoryPool->pucNextUnusedBlock;
+            pxMemoryPool->pucNextUnusedBlock += pxMemoryPool->xBlockSize;
+            pxMemoryPool->uxNumberOfUnusedBlocks--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvBlock != NULL )
+        {
+            pxMemoryPool->uxNumberOfFreeBlocks--;
+
+            if( pxMemoryPool->uxNumberOfFreeBlocks < pxMemoryPool->uxMinimumEverFreeBlocks )
+            {
+                pxMemoryPool->uxMinimumEverFreeBlocks = pxMemoryPool->uxNumberOfFreeBlocks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReturnBlock( MemoryPool_t * const pxMemoryPool,
+                                      void * pvBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* The block must have been allocated from this pool, and the pool
+         * cannot have more free blocks than it holds. */
+        configASSERT( ( ( uint8_t * ) pvBlock >= pxMemoryPool->pucStorage ) &&
+                      ( ( uint8_t * ) pvBlock < pxMemoryPool->pucNextUnusedBlock ) );
+        configASSERT( ( ( size_t ) ( ( uint8_t * ) pvBlock - pxMemoryPool->pucStorage ) % pxMemoryPool->xBlockSize ) == 0U );
+        configASSERT( pxMemoryPool->uxNumberOfFreeBlocks < pxMemoryPool->uxNumberOfBlocks );
+
+        *( ( void ** ) pvBlock ) = pxMemoryPool->pvFreeList;
+        pxMemoryPool->pvFreeList = pvBlock;
+        pxMemoryPool->uxNumberOfFreeBlocks++;
+
+        /* The unblocked task allocates the block itself when it runs, so it
+         * competes for the block with any other task or interrupt that
+         * allocates from the pool first, in which case it blocks again. */
+        if( listLIST_IS_EMPTY( &( pxMemoryPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+        {
+            xReturn = xTaskRemoveFromEventList( &( pxMemoryPool->xTasksWaitingToAllocate ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool,
+                                 TickType_t xTicksToWait )
+    {
+        MemoryPool_t * const pxMemoryPool = xMemoryPool;
+        void * pvReturn;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xShouldBlock, xAlreadyYielded;
+        TimeOut_t xTimeOut;
+
+        traceENTER_pvMemoryPoolAllocate( xMemoryPool, xTicksToWait );
+
+        configASSERT( pxMemoryPool );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        do
+        {
+            xShouldBlock = pdFALSE;
+
+            /* The scheduler is suspended because placing the task on the
+             * delayed list is non-deterministic, and the critical section
+             * prevents an interrupt freeing a block between the pool being
+             * found empty and the task being placed in the list of waiting
+             * tasks. */
+            vTaskSuspendAll();
+            {
+                taskENTER_CRITICAL();
+                {
+                    pvReturn = prvTakeBlock( pxMemoryPool );
+
+                    if( pvReturn != NULL )
+                    {
+                        traceMEMORY_POOL_ALLOCATE( pxMemoryPool, pvReturn );
+                    }
+                    else if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        traceMEMORY_POOL_ALLOCATE_FAILED( pxMemoryPool );
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The pool is empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                        xShouldBlock = pdTRUE;
+                    }
+                    else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                    {
+                        /* The task was unblocked by a block being freed, but
+                         * another task or interrupt allocated it first. */
+                        xShouldBlock = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Timed out. */
+                        traceMEMORY_POOL_ALLOCATE_FAILED( pxMemoryPool );
+                    }
+
+                    if( xShouldBlock == pdTRUE )
+                    {
+                        traceMEMORY_POOL_ALLOCATE_BLOCK( pxMemoryPool );
+                        vTaskPlaceOnEventList( &( pxMemoryPool->xTasksWaitingToAllocate ), xTicksToWait );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            xAlreadyYielded = xTaskResumeAll();
+
+            if( ( xShouldBlock == pdTRUE ) && ( xAlreadyYielded == pdFALSE ) )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } while( xShouldBlock == pdTRUE );
+
+        traceRETURN_pvMemoryPoolAllocate( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool )
+    {
+        MemoryPool_t * const pxMemoryPool = xMemoryPool;
+        void * pvReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_pvMemoryPoolAllocateFromISR( xMemoryPool );
+
+        configASSERT( pxMemoryPool );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum system call (or maximum API call) interrupt priority.
+         * Interrupts that are above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical
+         * section, but cannot make any calls to FreeRTOS API functions.  If
+         * configASSERT() is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an
+         * assertion failure if a FreeRTOS API function is called from an
+         * interrupt that has been assigned a priority above the configured
+         * maximum system call priority. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            pvReturn = prvTakeBlock( pxMemoryPool );
+
+            if( pvReturn != NULL )
+            {
+                traceMEMORY_POOL_ALLOCATE_FROM_ISR( pxMemoryPool, pvReturn );
+            }
+            else
+            {
+                traceMEMORY_POOL_ALLOCATE_FROM_ISR_FAILED( pxMemoryPool );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_pvMemoryPoolAllocateFromISR( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool,
+                          void * pvBlock )
+    {
+        MemoryPool_t * const pxMemoryPool = xMemoryPool;
+
+        traceENTER_vMemoryPoolFree( xMemoryPool, pvBlock );
+
+        configASSERT( pxMemoryPool );
+        configASSERT( pvBlock );
+
+        taskENTER_CRITICAL();
+        {
+            traceMEMORY_POOL_FREE( pxMemoryPool, pvBlock );
+
+            if( prvReturnBlock( pxMemoryPool, pvBlock ) != pdFALSE )
+            {
+                /* The unblocked task has a priority higher than our own so
+                 * yield immediately.  Yes it is ok to do this from within the
+                 * critical section - the kernel takes care of that. */
+                memorypoolYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vMemoryPoolFree();
+    }
+/*-----------------------------------------------------------*/
+
+    void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                                 void * pvBlock,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        MemoryPool_t * const pxMemoryPool = xMemoryPool;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vMemoryPoolFreeFromISR( xMemoryPool, pvBlock, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxMemoryPool );
+        configASSERT( pvBlock );
+
+        /* See the comments in pvMemoryPoolAllocateFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            traceMEMORY_POOL_FREE_FROM_ISR( pxMemoryPool, pvBlock );
+
+            if( prvReturnBlock( pxMemoryPool, pvBlock ) != pdFALSE )
+            {
+                /* The unblocked task has a priority higher than the task
+                 * that was interrupted, so record that a context switch is
+                 * required. */
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vMemoryPoolFreeFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool )
+    {
+        const MemoryPool_t * const pxMemoryPool = xMemoryPool;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxMemoryPoolGetFreeBlocks( xMemoryPool );
+
+        configASSERT( pxMemoryPool );
+
+        uxReturn = pxMemoryPool->uxNumberOfFreeBlocks;
+
+        traceRETURN_uxMemoryPoolGetFreeBlocks( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxMemoryPoolGetHighWaterMark( MemoryPoolHandle_t xMemoryPool )
+    {
+        const MemoryPool_t * const pxMemoryPool = xMemoryPool;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxMemoryPoolGetHighWaterMark( xMemoryPool );
+
+        configASSERT( pxMemoryPool );
+
+        uxReturn = pxMemoryPool->uxMinimumEverFreeBlocks;
+
+        traceRETURN_uxMemoryPoolGetHighWaterMark( uxReturn );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool )
+    {
+        MemoryPool_t * pxMemoryPool = xMemoryPool;
+
+        traceENTER_vMemoryPoolDelete( xMemoryPool );
+
+        configASSERT( pxMemoryPool );
+
+        /* Tasks blocked on the pool would access it after it was deleted. */
+        configASSERT( listLIST_IS_EMPTY( &( pxMemoryPool->xTasksWaitingToAllocate ) ) != pdFALSE );
+
+        traceMEMORY_POOL_DELETE( pxMemoryPool );
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The memory pool can only have been allocated dynamically - free
+             * it again. */
+            vPortFree( pxMemoryPool );
+        }
+        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The memory pool could have been allocated statically or
+             * dynamically, so check before attempting to free the memory. */
+            if( pxMemoryPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxMemoryPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        traceRETURN_vMemoryPoolDelete();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include memory pool functionality. If you want to include memory pools
+ * then ensure configUSE_MEMORY_POOLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MEMORY_POOLS == 1 */
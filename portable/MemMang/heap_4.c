@@ -55,6 +55,16 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_MUTEXES == 0 ) && ( configNUMBER_OF_CORES == 1 )
+        #error configUSE_HEAP_ALLOCATION_TRACKING requires INCLUDE_xTaskGetCurrentTaskHandle to be set to 1
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 )
+        #error configUSE_HEAP_ALLOCATION_TRACKING requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+#endif
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -101,6 +111,10 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next free block in the list. */
     size_t xBlockSize;                     /**< The size of the free block. */
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+        TaskHandle_t xOwner;               /**< The task that allocated the block, or NULL if the scheduler had not started. */
+        void * pvCaller;                   /**< The address the block was allocated from. */
+    #endif
 } BlockLink_t;
 
 /* Setting configENABLE_HEAP_PROTECTOR to 1 enables heap block pointers
@@ -145,6 +159,40 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
 
+/*
+ * Removes a free block of at least xWantedSize bytes from the list of free
+ * blocks, splitting it if it is larger than required, and marks it as
+ * allocated.  Returns NULL if there is no block of adequate size.  Must be
+ * called with the scheduler suspended.
+ */
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * As prvAllocateBlock(), but the memory following the BlockLink_t structure of
+ * the returned block is aligned to xAlignment bytes, which must be a power of
+ * two greater than portBYTE_ALIGNMENT.  Must be called with the scheduler
+ * suspended.
+ */
+static BlockLink_t * prvAllocateAlignedBlock( size_t xWantedSize,
+                                              size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes pxBlock, which follows pxPreviousBlock in the list of free blocks,
+ * from the list, returning any bytes beyond the first xWantedSize bytes to the
+ * list if there are enough of them to form a block, and marks it as allocated.
+ * Must be called with the scheduler suspended.
+ */
+static void prvClaimFreeBlock( BlockLink_t * pxPreviousBlock,
+                               BlockLink_t * pxBlock,
+                               size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the size of the block needed to hold xWantedSize bytes, including
+ * the BlockLink_t structure and any padding needed to keep blocks aligned, or
+ * 0 if xWantedSize is 0 or the block size would overflow.
+ */
+static size_t prvGetBlockSize( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
@@ -168,40 +216,187 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+/* The first block in the heap, from which the blocks can be walked in address
+ * order. */
+    PRIVILEGED_DATA static BlockLink_t * pxFirstBlock = NULL;
+
+/* The smallest largest free block seen by vPortGetHeapFragmentationStats(). */
+    PRIVILEGED_DATA static size_t xMinimumEverLargestFreeBlock = heapSIZE_MAX;
+
+/* Record the task and call site that allocated a block. */
+    #define heapRECORD_OWNER( pxBlock, pvCallerAddress ) \
+    do {                                                 \
+        ( pxBlock )->xOwner = prvGetAllocatingTask();    \
+        ( pxBlock )->pvCaller = ( pvCallerAddress );     \
+    } while( 0 )
+
+/*
+ * Returns the task that is allocating memory, or NULL if the scheduler has not
+ * been started.
+ */
+    static TaskHandle_t prvGetAllocatingTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the block that follows pxBlock in address order, or NULL if pxBlock
+ * is the last block in the heap.
+ */
+    static BlockLink_t * prvGetNextPhysicalBlock( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxBlock is currently allocated to the application.
+ */
+    static BaseType_t prvBlockIsLive( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#else /* if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 ) */
+
+    #define heapRECORD_OWNER( pxBlock, pvCallerAddress )
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+/* Blocks of up to heapCACHE_MAX_BLOCK_SIZE bytes, including the BlockLink_t
+ * structure, are rounded up to one of heapCACHE_SIZE_CLASSES power of two
+ * sizes so a block freed into a cache can satisfy any later request of the
+ * same size class. */
+    #define heapCACHE_SIZE_CLASSES                   ( ( UBaseType_t ) 4U )
+    #define heapCACHE_MIN_BLOCK_SIZE                 ( ( size_t ) 32U )
+    #define heapCACHE_CLASS_BLOCK_SIZE( uxClass )    ( heapCACHE_MIN_BLOCK_SIZE << ( uxClass ) )
+
+/* The number of blocks moved between a cache and the heap at a time. */
+    #define heapCACHE_BATCH_SIZE                     ( ( UBaseType_t ) ( configHEAP_CORE_CACHE_DEPTH / 2 ) )
+
+    #if ( portBYTE_ALIGNMENT > 32 )
+        #error configUSE_HEAP_CORE_CACHES requires portBYTE_ALIGNMENT to be no more than 32
+    #endif
+
+/* A core's cache is only used by the task running on that core, and interrupt
+ * service routines never use the heap, so the cache is protected by stopping
+ * the calling task being switched out.  In SMP that is done by masking
+ * interrupts on the calling core rather than taking the kernel locks. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #define heapENTER_CORE_CACHE()    uxSavedInterruptStatus = portSET_INTERRUPT_MASK()
+        #define heapEXIT_CORE_CACHE()     portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus )
+    #else
+        #define heapENTER_CORE_CACHE()    taskENTER_CRITICAL()
+        #define heapEXIT_CORE_CACHE()     taskEXIT_CRITICAL()
+    #endif
+
+/* The blocks of each size class held by one core, and the statistics for
+ * that core's cache.  Cached blocks remain marked as allocated so they are
+ * never merged with their neighbours.  They are told apart from blocks that
+ * are allocated to the application by their pxNextFreeBlock member, which
+ * holds heapCACHED_BLOCK_TAG rather than NULL, so vPortFree() rejects a block
+ * that is freed again while it is held in a cache. */
+    typedef struct HEAP_CORE_CACHE
+    {
+        BlockLink_t * pxBlocks[ heapCACHE_SIZE_CLASSES ][ configHEAP_CORE_CACHE_DEPTH ];
+        UBaseType_t uxBlockCount[ heapCACHE_SIZE_CLASSES ];
+        size_t xCachedBytes;
+        size_t xNumberOfHits;
+        size_t xNumberOfMisses;
+        size_t xNumberOfFrees;
+    } HeapCoreCache_t;
+
+    PRIVILEGED_DATA static HeapCoreCache_t xCoreCaches[ configNUMBER_OF_CORES ];
+
+/* The value held in the pxNextFreeBlock member of a cached block.  It is not
+ * the address of a heap block. */
+    #define heapCACHED_BLOCK_TAG    ( ( BlockLink_t * ) xCoreCaches )
+
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+/* Blocks held in a cache are marked as allocated, so are instead identified by
+ * an owner that cannot be a real task. */
+        #define heapCACHED_BLOCK_OWNER    ( ( TaskHandle_t ) xCoreCaches )
+        #define heapRECORD_CACHED( pxBlock )              \
+    do {                                                  \
+        ( pxBlock )->xOwner = heapCACHED_BLOCK_OWNER;     \
+        ( pxBlock )->pvCaller = NULL;                     \
+    } while( 0 )
+    #else
+        #define heapRECORD_CACHED( pxBlock )
+    #endif
+
+/*
+ * Returns the size class that a block of xBlockSize bytes is rounded up to,
+ * or heapCACHE_SIZE_CLASSES if blocks of that size are not cached.
+ */
+    static UBaseType_t prvGetSizeClass( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a block of the given size class from the calling core's cache.
+ * Returns NULL if the cache holds no blocks of that class.
+ */
+    static BlockLink_t * prvAllocateFromCoreCache( UBaseType_t uxSizeClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places a block that is being freed into the calling core's cache, first
+ * returning half of the cached blocks of the same class to the heap if the
+ * cache is full.  Returns pdFALSE if blocks of that size are not cached.
+ */
+    static BaseType_t prvFreeToCoreCache( BlockLink_t * pxLink ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves up to heapCACHE_BATCH_SIZE blocks of the given size class from the
+ * heap into the calling core's cache.  Must be called with the scheduler
+ * suspended.
+ */
+    static void prvRefillCoreCache( UBaseType_t uxSizeClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns blocks of the given size class from a cache to the heap until only
+ * uxBlocksToKeep remain.  Returns pdTRUE if any block was returned.  Must be
+ * called with the scheduler suspended.
+ */
+    static BaseType_t prvFlushCoreCache( HeapCoreCache_t * pxCache,
+                                         UBaseType_t uxSizeClass,
+                                         UBaseType_t uxBlocksToKeep ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_CORE_CACHES */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
 {
-    BlockLink_t * pxBlock;
-    BlockLink_t * pxPreviousBlock;
-    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxBlock = NULL;
     void * pvReturn = NULL;
-    size_t xAdditionalRequiredSize;
     size_t xAllocatedBlockSize = 0;
 
-    if( xWantedSize > 0 )
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        UBaseType_t uxSizeClass = heapCACHE_SIZE_CLASSES;
+        UBaseType_t uxClass;
+    #endif
+
+    xWantedSize = prvGetBlockSize( xWantedSize );
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
     {
-        /* The wanted size must be increased so it can contain a BlockLink_t
-         * structure in addition to the requested amount of bytes. */
-        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        /* Small blocks are rounded up to a size class so they can be taken
+         * from, and later returned to, the calling core's cache without
+         * suspending the scheduler. */
+        if( xWantedSize > 0 )
         {
-            xWantedSize += xHeapStructSize;
+            uxSizeClass = prvGetSizeClass( xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* Ensure that blocks are always aligned to the required number
-             * of bytes. */
-            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
-            {
-                /* Byte alignment required. */
-                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+        if( uxSizeClass < heapCACHE_SIZE_CLASSES )
+        {
+            xWantedSize = heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass );
+            pxBlock = prvAllocateFromCoreCache( uxSizeClass );
 
-                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
-                {
-                    xWantedSize += xAdditionalRequiredSize;
-                }
-                else
-                {
-                    xWantedSize = 0;
-                }
+            if( pxBlock != NULL )
+            {
+                heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                traceMALLOC( pvReturn, xAllocatedBlockSize );
             }
             else
             {
@@ -210,105 +405,77 @@ void * pvPortMalloc( size_t xWantedSize )
         }
         else
         {
-            xWantedSize = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    #endif /* configUSE_HEAP_CORE_CACHES */
 
-    vTaskSuspendAll();
+    if( pvReturn == NULL )
     {
-        /* If this is the first call to malloc then the heap will require
-         * initialisation to setup the list of free blocks. */
-        if( pxEnd == NULL )
-        {
-            prvHeapInit();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+        vTaskSuspendAll();
         {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            /* If this is the first call to malloc then the heap will require
+             * initialisation to setup the list of free blocks. */
+            if( pxEnd == NULL )
+            {
+                prvHeapInit();
+            }
+            else
             {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
-                heapVALIDATE_BLOCK_POINTER( pxBlock );
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+            /* Check the block size we are trying to allocate is not so large that the
+             * top bit is set.  The top bit of the block size member of the BlockLink_t
+             * structure is used to determine who owns the block - the application or
+             * the kernel, so it must be free. */
+            if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+            {
+                if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
                 {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
-                    heapVALIDATE_BLOCK_POINTER( pxBlock );
+                    pxBlock = prvAllocateBlock( xWantedSize );
                 }
-
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if( pxBlock != pxEnd )
+                else
                 {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = ( void * ) ( ( ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxPreviousBlock->pxNextFreeBlock ) ) + xHeapStructSize );
-                    heapVALIDATE_BLOCK_POINTER( pvReturn );
-
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
-
-                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-                    {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
-                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
+                {
+                    if( uxSizeClass < heapCACHE_SIZE_CLASSES )
                     {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        if( pxBlock != NULL )
+                        {
+                            prvRefillCoreCache( uxSizeClass );
+                        }
+                        else
+                        {
+                            /* The heap may only be exhausted because free
+                             * blocks are held in this core's cache. */
+                            for( uxClass = 0; uxClass < heapCACHE_SIZE_CLASSES; uxClass++ )
+                            {
+                                ( void ) prvFlushCoreCache( &( xCoreCaches[ portGET_CORE_ID() ] ), uxClass, 0 );
+                            }
+
+                            pxBlock = prvAllocateBlock( xWantedSize );
+                        }
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+                }
+                #endif /* configUSE_HEAP_CORE_CACHES */
 
-                    xAllocatedBlockSize = pxBlock->xBlockSize;
+                if( pxBlock != NULL )
+                {
+                    heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                    xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
 
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK( pxBlock );
-                    pxBlock->pxNextFreeBlock = NULL;
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
                     xNumberOfSuccessfulAllocations++;
                 }
                 else
@@ -320,18 +487,14 @@ void * pvPortMalloc( size_t xWantedSize )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
 
-        traceMALLOC( pvReturn, xAllocatedBlockSize );
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
 
-        /* Prevent compiler warnings when trace macros are not used. */
-        ( void ) xAllocatedBlockSize;
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
     }
-    ( void ) xTaskResumeAll();
 
     #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
     {
@@ -355,6 +518,7 @@ void vPortFree( void * pv )
 {
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
+    BaseType_t xCached = pdFALSE;
 
     if( pv != NULL )
     {
@@ -373,29 +537,45 @@ void vPortFree( void * pv )
         {
             if( pxLink->pxNextFreeBlock == NULL )
             {
-                /* The block is being returned to the heap - it is no longer
-                 * allocated. */
-                heapFREE_BLOCK( pxLink );
-                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
                 {
-                    /* Check for underflow as this can occur if xBlockSize is
-                     * overwritten in a heap block. */
-                    if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize, xHeapStructSize ) == 0 )
-                    {
-                        ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
-                    }
+                    xCached = prvFreeToCoreCache( pxLink );
                 }
                 #endif
 
-                vTaskSuspendAll();
+                if( xCached == pdFALSE )
                 {
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
-                    xNumberOfSuccessfulFrees++;
+                    #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                    {
+                        /* Check for underflow as this can occur if xBlockSize is
+                         * overwritten in a heap block. */
+                        if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK, xHeapStructSize ) == 0 )
+                        {
+                            ( void ) memset( puc + xHeapStructSize, 0, ( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) - xHeapStructSize );
+                        }
+                    }
+                    #endif
+
+                    vTaskSuspendAll();
+                    {
+                        /* The block is being returned to the heap - it is no
+                         * longer allocated.  This is done with the scheduler
+                         * suspended so pvPortRealloc() never finds a free
+                         * block that is not yet in the list of free blocks. */
+                        heapFREE_BLOCK( pxLink );
+
+                        /* Add this block to the list of free blocks. */
+                        xFreeBytesRemaining += pxLink->xBlockSize;
+                        traceFREE( pv, pxLink->xBlockSize );
+                        prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                        xNumberOfSuccessfulFrees++;
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                ( void ) xTaskResumeAll();
             }
             else
             {
@@ -439,6 +619,10 @@ void * pvPortCalloc( size_t xNum,
 
         if( pv != NULL )
         {
+            /* Attribute the block to the caller of this function rather than
+             * to this function. */
+            heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+
             ( void ) memset( pv, 0, xNum * xSize );
         }
     }
@@ -447,80 +631,777 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
-static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize )
 {
-    BlockLink_t * pxFirstFreeBlock;
-    portPOINTER_SIZE_TYPE uxStartAddress, uxEndAddress;
-    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
-
-    /* Ensure the heap starts on a correctly aligned boundary. */
-    uxStartAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNextBlock;
+    BlockLink_t * pxIterator;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xBlockSize = 0;
+    size_t xNewBlockSize;
 
-    if( ( uxStartAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    if( pv == NULL )
     {
-        uxStartAddress += ( portBYTE_ALIGNMENT - 1 );
-        uxStartAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
-        xTotalHeapSize -= ( size_t ) ( uxStartAddress - ( portPOINTER_SIZE_TYPE ) ucHeap );
+        pvReturn = pvPortMalloc( xWantedSize );
     }
-
-    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    else if( xWantedSize == ( size_t ) 0 )
     {
-        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
+        vPortFree( pv );
     }
-    #endif
+    else
+    {
+        /* The memory being resized will have an BlockLink_t structure
+         * immediately before it. */
+        puc -= xHeapStructSize;
 
-    /* xStart is used to hold a pointer to the first item in the list of free
-     * blocks.  The void cast is used to prevent compiler warnings. */
-    xStart.pxNextFreeBlock = ( void * ) heapPROTECT_BLOCK_POINTER( uxStartAddress );
-    xStart.xBlockSize = ( size_t ) 0;
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
 
-    /* pxEnd is used to mark the end of the list of free blocks and is inserted
-     * at the end of the heap space. */
-    uxEndAddress = uxStartAddress + ( portPOINTER_SIZE_TYPE ) xTotalHeapSize;
-    uxEndAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
-    uxEndAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
-    pxEnd = ( BlockLink_t * ) uxEndAddress;
-    pxEnd->xBlockSize = 0;
-    pxEnd->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
 
-    /* To start with there is a single free block that is sized to take up the
-     * entire heap space, minus the space taken by pxEnd. */
-    pxFirstFreeBlock = ( BlockLink_t * ) uxStartAddress;
-    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxEndAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
-    pxFirstFreeBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxEnd );
+        xNewBlockSize = prvGetBlockSize( xWantedSize );
 
-    /* Only one block exists - and it covers the entire usable heap space. */
-    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
-    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
-}
-/*-----------------------------------------------------------*/
+        if( ( xNewBlockSize > ( size_t ) 0 ) && ( heapBLOCK_SIZE_IS_VALID( xNewBlockSize ) != 0 ) )
+        {
+            vTaskSuspendAll();
+            {
+                xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
 
-static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
-{
-    BlockLink_t * pxIterator;
-    uint8_t * puc;
+                if( xNewBlockSize <= xBlockSize )
+                {
+                    traceFREE( pv, xBlockSize );
+                    pvReturn = pv;
+                }
+                else
+                {
+                    /* The block can grow in place if the block that follows
+                     * it is free and large enough.  The block that follows the
+                     * last block in a region is an end marker of size 0. */
+                    pxNextBlock = ( void * ) ( puc + xBlockSize );
+
+                    if( ( heapBLOCK_IS_ALLOCATED( pxNextBlock ) == 0 ) &&
+                        ( pxNextBlock->xBlockSize > ( size_t ) 0 ) &&
+                        ( ( xBlockSize + pxNextBlock->xBlockSize ) >= xNewBlockSize ) )
+                    {
+                        /* Find the free block that comes before the block
+                         * being absorbed in the list of free blocks. */
+                        for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxNextBlock; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+                        {
+                            /* There is nothing to do here, just iterate to the right
+                             * position. */
+                        }
+
+                        configASSERT( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) == pxNextBlock );
+
+                        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                        xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        traceFREE( pv, xBlockSize );
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        pxLink->xBlockSize = xBlockSize;
+                        heapALLOCATE_BLOCK( pxLink );
+                        pvReturn = pv;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
 
-    /* Iterate through the list until a block is found that has a higher address
-     * than the block being inserted. */
-    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxBlockToInsert; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
-    {
-        /* Nothing to do here, just iterate to the right position. */
-    }
+                if( pvReturn != NULL )
+                {
+                    /* Return any bytes beyond the end of the resized block
+                     * to the heap if there are enough to form a block. */
+                    if( ( xBlockSize - xNewBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( puc + xNewBlockSize );
+                        pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+                        pxLink->xBlockSize = xNewBlockSize;
+                        heapALLOCATE_BLOCK( pxLink );
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-    if( pxIterator != &xStart )
-    {
-        heapVALIDATE_BLOCK_POINTER( pxIterator );
-    }
+                    traceMALLOC( pv, pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
 
-    /* Do the block being inserted, and the block it is being inserted after
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxIterator;
+            if( pvReturn == NULL )
+            {
+                /* The block could not grow in place, so move it.  The
+                 * original block is left untouched if that fails. */
+                pvReturn = pvPortMalloc( xWantedSize );
 
-    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
-    {
-        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
-        pxBlockToInsert = pxIterator;
-    }
+                if( pvReturn != NULL )
+                {
+                    ( void ) memcpy( pvReturn, pv, xBlockSize - xHeapStructSize );
+                    vPortFree( pv );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( pvReturn != NULL )
+    {
+        /* Attribute the block to the caller of this function rather than
+         * to this function. */
+        heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocAligned( size_t xWantedSize,
+                           size_t xAlignment )
+{
+    BlockLink_t * pxBlock = NULL;
+    void * pvReturn = NULL;
+    size_t xAllocatedBlockSize = 0;
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        UBaseType_t uxClass;
+    #endif
+
+    /* The alignment must be a power of two. */
+    configASSERT( ( xAlignment != ( size_t ) 0 ) && ( ( xAlignment & ( xAlignment - 1U ) ) == ( size_t ) 0 ) );
+
+    if( xAlignment <= ( size_t ) portBYTE_ALIGNMENT )
+    {
+        /* All blocks are aligned to at least portBYTE_ALIGNMENT bytes. */
+        pvReturn = pvPortMalloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else if( ( xAlignment & ( xAlignment - 1U ) ) == ( size_t ) 0 )
+    {
+        xWantedSize = prvGetBlockSize( xWantedSize );
+
+        vTaskSuspendAll();
+        {
+            /* If this is the first call to malloc then the heap will require
+             * initialisation to setup the list of free blocks. */
+            if( pxEnd == NULL )
+            {
+                prvHeapInit();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xWantedSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                pxBlock = prvAllocateAlignedBlock( xWantedSize, xAlignment );
+
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
+                {
+                    if( pxBlock == NULL )
+                    {
+                        /* The heap may only be exhausted because free blocks
+                         * are held in this core's cache. */
+                        for( uxClass = 0; uxClass < heapCACHE_SIZE_CLASSES; uxClass++ )
+                        {
+                            ( void ) prvFlushCoreCache( &( xCoreCaches[ portGET_CORE_ID() ] ), uxClass, 0 );
+                        }
+
+                        pxBlock = prvAllocateAlignedBlock( xWantedSize, xAlignment );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_HEAP_CORE_CACHES */
+
+                if( pxBlock != NULL )
+                {
+                    heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                    xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+                    xNumberOfSuccessfulAllocations++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1U ) ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    portPOINTER_SIZE_TYPE uxStartAddress, uxEndAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxStartAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxStartAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxStartAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxStartAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= ( size_t ) ( uxStartAddress - ( portPOINTER_SIZE_TYPE ) ucHeap );
+    }
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    {
+        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
+    }
+    #endif
+
+    /* xStart is used to hold a pointer to the first item in the list of free
+     * blocks.  The void cast is used to prevent compiler warnings. */
+    xStart.pxNextFreeBlock = ( void * ) heapPROTECT_BLOCK_POINTER( uxStartAddress );
+    xStart.xBlockSize = ( size_t ) 0;
+
+    /* pxEnd is used to mark the end of the list of free blocks and is inserted
+     * at the end of the heap space. */
+    uxEndAddress = uxStartAddress + ( portPOINTER_SIZE_TYPE ) xTotalHeapSize;
+    uxEndAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+    uxEndAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+    pxEnd = ( BlockLink_t * ) uxEndAddress;
+    pxEnd->xBlockSize = 0;
+    pxEnd->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( BlockLink_t * ) uxStartAddress;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxEndAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
+    pxFirstFreeBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxEnd );
+
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+    {
+        pxFirstBlock = pxFirstFreeBlock;
+    }
+    #endif
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetBlockSize( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    size_t xAdditionalRequiredSize;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvClaimFreeBlock( BlockLink_t * pxPreviousBlock,
+                               BlockLink_t * pxBlock,
+                               size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxNewBlockLink;
+
+    /* This block is being returned for use so must be taken out
+     * of the list of free blocks. */
+    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+    /* If the block is larger than required it can be split into
+     * two. */
+    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+
+    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+    {
+        /* This block is to be split into two.  Create a new
+         * block following the number of bytes requested. The void
+         * cast is used to prevent byte alignment warnings from the
+         * compiler. */
+        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+        /* Calculate the sizes of two blocks split from the
+         * single block. */
+        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+        pxBlock->xBlockSize = xWantedSize;
+
+        /* Insert the new block into the list of free blocks. */
+        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+    {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The block is being returned - it is allocated and owned
+     * by the application and has no "next" block. */
+    heapALLOCATE_BLOCK( pxBlock );
+    pxBlock->pxNextFreeBlock = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+
+    /* Traverse the list from the start (lowest address) block until
+     * one of adequate size is found. */
+    pxPreviousBlock = &xStart;
+    pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+    while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+    {
+        pxPreviousBlock = pxBlock;
+        pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+        heapVALIDATE_BLOCK_POINTER( pxBlock );
+    }
+
+    /* If the end marker was reached then a block of adequate size
+     * was not found. */
+    if( pxBlock != pxEnd )
+    {
+        prvClaimFreeBlock( pxPreviousBlock, pxBlock, xWantedSize );
+    }
+    else
+    {
+        pxBlock = NULL;
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocateAlignedBlock( size_t xWantedSize,
+                                              size_t xAlignment ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxAlignedBlock;
+    portPOINTER_SIZE_TYPE uxAlignedAddress;
+    size_t xLeadingSize = 0;
+    BaseType_t xFound = pdFALSE;
+
+    /* Traverse the list from the start (lowest address) block until one is
+     * found that holds xWantedSize bytes starting from an address at which the
+     * memory returned to the application is aligned to xAlignment. */
+    pxPreviousBlock = &xStart;
+    pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+    while( ( xFound == pdFALSE ) && ( pxBlock != pxEnd ) )
+    {
+        uxAlignedAddress = ( ( portPOINTER_SIZE_TYPE ) pxBlock ) + ( portPOINTER_SIZE_TYPE ) xHeapStructSize + ( portPOINTER_SIZE_TYPE ) ( xAlignment - 1U );
+        uxAlignedAddress &= ~( ( portPOINTER_SIZE_TYPE ) ( xAlignment - 1U ) );
+        xLeadingSize = ( size_t ) ( uxAlignedAddress - ( portPOINTER_SIZE_TYPE ) xHeapStructSize - ( portPOINTER_SIZE_TYPE ) pxBlock );
+
+        /* Any bytes skipped at the start of the free block remain free, so
+         * must be enough to hold a block of their own. */
+        while( ( xLeadingSize != ( size_t ) 0 ) && ( xLeadingSize < heapMINIMUM_BLOCK_SIZE ) )
+        {
+            xLeadingSize += xAlignment;
+        }
+
+        if( ( xLeadingSize < pxBlock->xBlockSize ) && ( ( pxBlock->xBlockSize - xLeadingSize ) >= xWantedSize ) )
+        {
+            xFound = pdTRUE;
+        }
+        else
+        {
+            pxPreviousBlock = pxBlock;
+            pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+            heapVALIDATE_BLOCK_POINTER( pxBlock );
+        }
+    }
+
+    if( xFound != pdFALSE )
+    {
+        if( xLeadingSize > ( size_t ) 0 )
+        {
+            /* Split off the leading bytes, which stay in the list of free
+             * blocks, so the block that follows them is correctly aligned. */
+            pxAlignedBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingSize );
+            pxAlignedBlock->xBlockSize = pxBlock->xBlockSize - xLeadingSize;
+            pxAlignedBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+            pxBlock->xBlockSize = xLeadingSize;
+            pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxAlignedBlock );
+
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxAlignedBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvClaimFreeBlock( pxPreviousBlock, pxBlock, xWantedSize );
+    }
+    else
+    {
+        pxBlock = NULL;
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+    static UBaseType_t prvGetSizeClass( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxSizeClass = 0;
+
+        while( ( uxSizeClass < heapCACHE_SIZE_CLASSES ) && ( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) < xBlockSize ) )
+        {
+            uxSizeClass++;
+        }
+
+        return uxSizeClass;
+    }
+/*-----------------------------------------------------------*/
+
+    static BlockLink_t * prvAllocateFromCoreCache( UBaseType_t uxSizeClass ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapCoreCache_t * pxCache;
+        BlockLink_t * pxBlock = NULL;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        heapENTER_CORE_CACHE();
+        {
+            pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+            if( pxCache->uxBlockCount[ uxSizeClass ] > ( UBaseType_t ) 0U )
+            {
+                pxCache->uxBlockCount[ uxSizeClass ]--;
+                pxBlock = pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ];
+                pxCache->xCachedBytes -= pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                pxCache->xNumberOfHits++;
+
+                /* The block is allocated to the application again. */
+                configASSERT( pxBlock->pxNextFreeBlock == heapCACHED_BLOCK_TAG );
+                pxBlock->pxNextFreeBlock = NULL;
+            }
+            else
+            {
+                pxCache->xNumberOfMisses++;
+            }
+        }
+        heapEXIT_CORE_CACHE();
+
+        return pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFreeToCoreCache( BlockLink_t * pxLink ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapCoreCache_t * pxCache;
+        UBaseType_t uxSizeClass;
+        size_t xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        /* Only blocks that exactly match a size class are cached.  Blocks that
+         * were not split because the remainder was too small are returned to
+         * the heap. */
+        uxSizeClass = prvGetSizeClass( xBlockSize );
+
+        if( ( uxSizeClass < heapCACHE_SIZE_CLASSES ) && ( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) == xBlockSize ) )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( ( ( uint8_t * ) pxLink ) + xHeapStructSize, 0, xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            traceFREE( ( void * ) ( ( ( uint8_t * ) pxLink ) + xHeapStructSize ), xBlockSize );
+            heapRECORD_CACHED( pxLink );
+            pxLink->pxNextFreeBlock = heapCACHED_BLOCK_TAG;
+
+            heapENTER_CORE_CACHE();
+            {
+                pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+                if( pxCache->uxBlockCount[ uxSizeClass ] < ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH )
+                {
+                    pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxLink;
+                    pxCache->uxBlockCount[ uxSizeClass ]++;
+                    pxCache->xCachedBytes += xBlockSize;
+                    pxCache->xNumberOfFrees++;
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            heapEXIT_CORE_CACHE();
+
+            if( xReturn == pdFALSE )
+            {
+                /* The cache is full, so return a batch of blocks to the heap
+                 * to make room.  The scheduler is suspended so the calling
+                 * task cannot move to another core while it uses the cache. */
+                vTaskSuspendAll();
+                {
+                    pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+                    ( void ) prvFlushCoreCache( pxCache, uxSizeClass, ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH - heapCACHE_BATCH_SIZE );
+
+                    pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxLink;
+                    pxCache->uxBlockCount[ uxSizeClass ]++;
+                    pxCache->xCachedBytes += xBlockSize;
+                    pxCache->xNumberOfFrees++;
+                    xReturn = pdTRUE;
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRefillCoreCache( UBaseType_t uxSizeClass ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapCoreCache_t * pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+        BlockLink_t * pxBlock = NULL;
+        UBaseType_t uxTarget;
+
+        uxTarget = pxCache->uxBlockCount[ uxSizeClass ] + heapCACHE_BATCH_SIZE;
+
+        if( uxTarget > ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH )
+        {
+            uxTarget = ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        while( pxCache->uxBlockCount[ uxSizeClass ] < uxTarget )
+        {
+            pxBlock = prvAllocateBlock( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) );
+
+            if( pxBlock == NULL )
+            {
+                /* Leave the remaining heap for requests that cannot be
+                 * cached. */
+                uxTarget = pxCache->uxBlockCount[ uxSizeClass ];
+            }
+            else
+            {
+                heapRECORD_CACHED( pxBlock );
+                pxBlock->pxNextFreeBlock = heapCACHED_BLOCK_TAG;
+                pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxBlock;
+                pxCache->uxBlockCount[ uxSizeClass ]++;
+                pxCache->xCachedBytes += pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFlushCoreCache( HeapCoreCache_t * pxCache,
+                                         UBaseType_t uxSizeClass,
+                                         UBaseType_t uxBlocksToKeep ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        BaseType_t xReturn = pdFALSE;
+
+        while( pxCache->uxBlockCount[ uxSizeClass ] > uxBlocksToKeep )
+        {
+            pxCache->uxBlockCount[ uxSizeClass ]--;
+            pxBlock = pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ];
+
+            /* The block is returned to the heap exactly as vPortFree() would
+             * have returned it, other than its contents have already been
+             * cleared if configHEAP_CLEAR_MEMORY_ON_FREE is 1. */
+            heapFREE_BLOCK( pxBlock );
+            pxCache->xCachedBytes -= pxBlock->xBlockSize;
+            xFreeBytesRemaining += pxBlock->xBlockSize;
+            prvInsertBlockIntoFreeList( pxBlock );
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_CORE_CACHES */
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxBlockToInsert; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    if( pxIterator != &xStart )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxIterator );
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
     else
     {
         mtCOVERAGE_TEST_MARKER();
@@ -568,6 +1449,10 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     BlockLink_t * pxBlock;
     size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
 
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        BaseType_t xCoreID;
+    #endif
+
     vTaskSuspendAll();
     {
         pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
@@ -610,11 +1495,258 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            /* Allocations and frees satisfied by a cache are counted by the
+             * cache. */
+            pxHeapStats->xNumberOfCacheHits = 0;
+            pxHeapStats->xNumberOfCacheMisses = 0;
+            pxHeapStats->xCachedBytes = 0;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxHeapStats->xNumberOfCacheHits += xCoreCaches[ xCoreID ].xNumberOfHits;
+                pxHeapStats->xNumberOfCacheMisses += xCoreCaches[ xCoreID ].xNumberOfMisses;
+                pxHeapStats->xCachedBytes += xCoreCaches[ xCoreID ].xCachedBytes;
+                pxHeapStats->xNumberOfSuccessfulFrees += xCoreCaches[ xCoreID ].xNumberOfFrees;
+            }
+
+            pxHeapStats->xNumberOfSuccessfulAllocations += pxHeapStats->xNumberOfCacheHits;
+        }
+        #endif /* configUSE_HEAP_CORE_CACHES */
     }
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+    static TaskHandle_t prvGetAllocatingTask( void ) /* PRIVILEGED_FUNCTION */
+    {
+        TaskHandle_t xTask = NULL;
+
+        /* Before the scheduler starts the current task is just the highest
+         * priority task created so far, which is not the one allocating. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static BlockLink_t * prvGetNextPhysicalBlock( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNextBlock;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) );
+
+        if( pxNextBlock == pxEnd )
+        {
+            pxNextBlock = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNextBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBlockIsLive( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            if( pxBlock->xOwner == heapCACHED_BLOCK_OWNER )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapAllocations( HeapAllocationRecord_t * const pxRecords,
+                                          const UBaseType_t uxMaxRecords ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        UBaseType_t uxCount = 0;
+
+        vTaskSuspendAll();
+        {
+            /* pxFirstBlock will be NULL if the heap has not been initialised. */
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( prvBlockIsLive( pxBlock ) != pdFALSE )
+                {
+                    if( uxCount < uxMaxRecords )
+                    {
+                        pxRecords[ uxCount ].pvAddress = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                        pxRecords[ uxCount ].xBlockSizeInBytes = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                        pxRecords[ uxCount ].xOwner = pxBlock->xOwner;
+                        pxRecords[ uxCount ].pvCaller = pxBlock->pvCaller;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPortGetHeapAllocatedBytesForTask( TaskHandle_t xTask,
+                                              UBaseType_t * puxNumberOfBlocks ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        size_t xBytes = 0;
+        UBaseType_t uxBlocks = 0;
+
+        vTaskSuspendAll();
+        {
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( ( prvBlockIsLive( pxBlock ) != pdFALSE ) && ( pxBlock->xOwner == xTask ) )
+                {
+                    xBytes += pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                    uxBlocks++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( puxNumberOfBlocks != NULL )
+        {
+            *puxNumberOfBlocks = uxBlocks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        size_t xMaxSize = 0;
+        size_t xBucketLimit;
+        UBaseType_t uxBucket;
+
+        ( void ) memset( pxFragmentationStats, 0x00, sizeof( HeapFragmentationStats_t ) );
+
+        vTaskSuspendAll();
+        {
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( prvBlockIsLive( pxBlock ) != pdFALSE )
+                {
+                    pxFragmentationStats->xNumberOfLiveAllocations++;
+                }
+                else if( heapBLOCK_IS_ALLOCATED( pxBlock ) == 0 )
+                {
+                    /* Find the power of two bucket the free block falls in. */
+                    uxBucket = 0;
+                    xBucketLimit = ( size_t ) 32U;
+
+                    while( ( ( uxBucket + 1U ) < ( UBaseType_t ) configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS ) &&
+                           ( pxBlock->xBlockSize >= xBucketLimit ) &&
+                           ( heapADD_WILL_OVERFLOW( xBucketLimit, xBucketLimit ) == 0 ) )
+                    {
+                        uxBucket++;
+                        xBucketLimit <<= 1;
+                    }
+
+                    pxFragmentationStats->xFreeBlockHistogram[ uxBucket ]++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The block is held in a core cache. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+
+            if( xMaxSize < xMinimumEverLargestFreeBlock )
+            {
+                xMinimumEverLargestFreeBlock = xMaxSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxFragmentationStats->xMinimumEverLargestFreeBlockInBytes = xMinimumEverLargestFreeBlock;
+        }
+        ( void ) xTaskResumeAll();
+
+        pxFragmentationStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -628,5 +1760,14 @@ void vPortHeapResetState( void )
     xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
     xNumberOfSuccessfulAllocations = ( size_t ) 0U;
     xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        ( void ) memset( xCoreCaches, 0x00, sizeof( xCoreCaches ) );
+    #endif
+
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+        pxFirstBlock = NULL;
+        xMinimumEverLargestFreeBlock = heapSIZE_MAX;
+    #endif
 }
 /*-----------------------------------------------------------*/
@@ -89,6 +89,16 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_MUTEXES == 0 ) && ( configNUMBER_OF_CORES == 1 )
+        #error configUSE_HEAP_ALLOCATION_TRACKING requires INCLUDE_xTaskGetCurrentTaskHandle to be set to 1
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 )
+        #error configUSE_HEAP_ALLOCATION_TRACKING requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+#endif
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -147,13 +157,28 @@
 /*-----------------------------------------------------------*/
 
 /* Define the linked list structure.  This is used to link free blocks in order
- * of their memory address. */
+ * of their memory address.
+ *
+ * When configUSE_HEAP_ALLOCATION_TRACKING is 1 the heap is also walked block by
+ * block, which needs a link from the marker at the end of each region to the
+ * first block of the next region.  The end marker is never allocated, so its
+ * pvCaller member holds that link instead of a caller address.  The link is
+ * only accessed through heapSET_NEXT_REGION() and heapGET_NEXT_REGION(). */
 typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next free block in the list. */
     size_t xBlockSize;                     /**< The size of the free block. */
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+        TaskHandle_t xOwner;               /**< The task that allocated the block, or NULL if the scheduler had not started. */
+        void * pvCaller;                   /**< The address the block was allocated from, or in a region end marker the first block of the next region. */
+    #endif
 } BlockLink_t;
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+    #define heapSET_NEXT_REGION( pxEndMarker, pxFirstBlockInRegion )    ( ( pxEndMarker )->pvCaller = ( void * ) ( pxFirstBlockInRegion ) )
+    #define heapGET_NEXT_REGION( pxEndMarker )                          ( ( BlockLink_t * ) ( pxEndMarker )->pvCaller )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -163,6 +188,40 @@ typedef struct A_BLOCK_LINK
  * adjacent to each other.
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes a free block of at least xWantedSize bytes from the list of free
+ * blocks, splitting it if it is larger than required, and marks it as
+ * allocated.  Returns NULL if there is no block of adequate size.  Must be
+ * called with the scheduler suspended.
+ */
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * As prvAllocateBlock(), but the memory following the BlockLink_t structure of
+ * the returned block is aligned to xAlignment bytes, which must be a power of
+ * two greater than portBYTE_ALIGNMENT.  Must be called with the scheduler
+ * suspended.
+ */
+static BlockLink_t * prvAllocateAlignedBlock( size_t xWantedSize,
+                                              size_t xAlignment ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes pxBlock, which follows pxPreviousBlock in the list of free blocks,
+ * from the list, returning any bytes beyond the first xWantedSize bytes to the
+ * list if there are enough of them to form a block, and marks it as allocated.
+ * Must be called with the scheduler suspended.
+ */
+static void prvClaimFreeBlock( BlockLink_t * pxPreviousBlock,
+                               BlockLink_t * pxBlock,
+                               size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the size of the block needed to hold xWantedSize bytes, including
+ * the BlockLink_t structure and any padding needed to keep blocks aligned, or
+ * 0 if xWantedSize is 0 or the block size would overflow.
+ */
+static size_t prvGetBlockSize( size_t xWantedSize ) PRIVILEGED_FUNCTION;
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
@@ -192,6 +251,147 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+/* The first block in the heap, from which the blocks can be walked in address
+ * order. */
+    PRIVILEGED_DATA static BlockLink_t * pxFirstBlock = NULL;
+
+/* The smallest largest free block seen by vPortGetHeapFragmentationStats(). */
+    PRIVILEGED_DATA static size_t xMinimumEverLargestFreeBlock = heapSIZE_MAX;
+
+/* Record the task and call site that allocated a block. */
+    #define heapRECORD_OWNER( pxBlock, pvCallerAddress ) \
+    do {                                                 \
+        ( pxBlock )->xOwner = prvGetAllocatingTask();    \
+        ( pxBlock )->pvCaller = ( pvCallerAddress );     \
+    } while( 0 )
+
+/*
+ * Returns the task that is allocating memory, or NULL if the scheduler has not
+ * been started.
+ */
+    static TaskHandle_t prvGetAllocatingTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the block that follows pxBlock in address order, or NULL if pxBlock
+ * is the last block in the heap.
+ */
+    static BlockLink_t * prvGetNextPhysicalBlock( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxBlock is currently allocated to the application.
+ */
+    static BaseType_t prvBlockIsLive( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#else /* if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 ) */
+
+    #define heapRECORD_OWNER( pxBlock, pvCallerAddress )
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
+
+/* Blocks of up to heapCACHE_MAX_BLOCK_SIZE bytes, including the BlockLink_t
+ * structure, are rounded up to one of heapCACHE_SIZE_CLASSES power of two
+ * sizes so a block freed into a cache can satisfy any later request of the
+ * same size class. */
+    #define heapCACHE_SIZE_CLASSES                   ( ( UBaseType_t ) 4U )
+    #define heapCACHE_MIN_BLOCK_SIZE                 ( ( size_t ) 32U )
+    #define heapCACHE_CLASS_BLOCK_SIZE( uxClass )    ( heapCACHE_MIN_BLOCK_SIZE << ( uxClass ) )
+
+/* The number of blocks moved between a cache and the heap at a time. */
+    #define heapCACHE_BATCH_SIZE                     ( ( UBaseType_t ) ( configHEAP_CORE_CACHE_DEPTH / 2 ) )
+
+    #if ( portBYTE_ALIGNMENT > 32 )
+        #error configUSE_HEAP_CORE_CACHES requires portBYTE_ALIGNMENT to be no more than 32
+    #endif
+
+/* A core's cache is only used by the task running on that core, and interrupt
+ * service routines never use the heap, so the cache is protected by stopping
+ * the calling task being switched out.  In SMP that is done by masking
+ * interrupts on the calling core rather than taking the kernel locks. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        #define heapENTER_CORE_CACHE()    uxSavedInterruptStatus = portSET_INTERRUPT_MASK()
+        #define heapEXIT_CORE_CACHE()     portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus )
+    #else
+        #define heapENTER_CORE_CACHE()    taskENTER_CRITICAL()
+        #define heapEXIT_CORE_CACHE()     taskEXIT_CRITICAL()
+    #endif
+
+/* The blocks of each size class held by one core, and the statistics for
+ * that core's cache.  Cached blocks remain marked as allocated so they are
+ * never merged with their neighbours.  They are told apart from blocks that
+ * are allocated to the application by their pxNextFreeBlock member, which
+ * holds heapCACHED_BLOCK_TAG rather than NULL, so vPortFree() rejects a block
+ * that is freed again while it is held in a cache. */
+    typedef struct HEAP_CORE_CACHE
+    {
+        BlockLink_t * pxBlocks[ heapCACHE_SIZE_CLASSES ][ configHEAP_CORE_CACHE_DEPTH ];
+        UBaseType_t uxBlockCount[ heapCACHE_SIZE_CLASSES ];
+        size_t xCachedBytes;
+        size_t xNumberOfHits;
+        size_t xNumberOfMisses;
+        size_t xNumberOfFrees;
+    } HeapCoreCache_t;
+
+    PRIVILEGED_DATA static HeapCoreCache_t xCoreCaches[ configNUMBER_OF_CORES ];
+
+/* The value held in the pxNextFreeBlock member of a cached block.  It is not
+ * the address of a heap block. */
+    #define heapCACHED_BLOCK_TAG    ( ( BlockLink_t * ) xCoreCaches )
+
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+/* Blocks held in a cache are marked as allocated, so are instead identified by
+ * an owner that cannot be a real task. */
+        #define heapCACHED_BLOCK_OWNER    ( ( TaskHandle_t ) xCoreCaches )
+        #define heapRECORD_CACHED( pxBlock )              \
+    do {                                                  \
+        ( pxBlock )->xOwner = heapCACHED_BLOCK_OWNER;     \
+        ( pxBlock )->pvCaller = NULL;                     \
+    } while( 0 )
+    #else
+        #define heapRECORD_CACHED( pxBlock )
+    #endif
+
+/*
+ * Returns the size class that a block of xBlockSize bytes is rounded up to,
+ * or heapCACHE_SIZE_CLASSES if blocks of that size are not cached.
+ */
+    static UBaseType_t prvGetSizeClass( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a block of the given size class from the calling core's cache.
+ * Returns NULL if the cache holds no blocks of that class.
+ */
+    static BlockLink_t * prvAllocateFromCoreCache( UBaseType_t uxSizeClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Places a block that is being freed into the calling core's cache, first
+ * returning half of the cached blocks of the same class to the heap if the
+ * cache is full.  Returns pdFALSE if blocks of that size are not cached.
+ */
+    static BaseType_t prvFreeToCoreCache( BlockLink_t * pxLink ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves up to heapCACHE_BATCH_SIZE blocks of the given size class from the
+ * heap into the calling core's cache.  Must be called with the scheduler
+ * suspended.
+ */
+    static void prvRefillCoreCache( UBaseType_t uxSizeClass ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns blocks of the given size class from a cache to the heap until only
+ * uxBlocksToKeep remain.  Returns pdTRUE if any block was returned.  Must be
+ * called with the scheduler suspended.
+ */
+    static BaseType_t prvFlushCoreCache( HeapCoreCache_t * pxCache,
+                                         UBaseType_t uxSizeClass,
+                                         UBaseType_t uxBlocksToKeep ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_CORE_CACHES */
+
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
 
 /* Canary value for protecting internal heap pointers. */
@@ -207,17 +407,547 @@ PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
 void * pvPortMalloc( size_t xWantedSize )
 {
-    BlockLink_t * pxBlock;
-    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxBlock = NULL;
+    void * pvReturn = NULL;
+    size_t xAllocatedBlockSize = 0;
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        UBaseType_t uxSizeClass = heapCACHE_SIZE_CLASSES;
+        UBaseType_t uxClass;
+    #endif
+
+    /* The heap must be initialised before the first call to
+     * pvPortMalloc(). */
+    configASSERT( pxEnd );
+
+    xWantedSize = prvGetBlockSize( xWantedSize );
+
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+    {
+        /* Small blocks are rounded up to a size class so they can be taken
+         * from, and later returned to, the calling core's cache without
+         * suspending the scheduler. */
+        if( xWantedSize > 0 )
+        {
+            uxSizeClass = prvGetSizeClass( xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxSizeClass < heapCACHE_SIZE_CLASSES )
+        {
+            xWantedSize = heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass );
+            pxBlock = prvAllocateFromCoreCache( uxSizeClass );
+
+            if( pxBlock != NULL )
+            {
+                heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                traceMALLOC( pvReturn, xAllocatedBlockSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_HEAP_CORE_CACHES */
+
+    if( pvReturn == NULL )
+    {
+        vTaskSuspendAll();
+        {
+            /* Check the block size we are trying to allocate is not so large that the
+             * top bit is set.  The top bit of the block size member of the BlockLink_t
+             * structure is used to determine who owns the block - the application or
+             * the kernel, so it must be free. */
+            if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+            {
+                if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+                {
+                    pxBlock = prvAllocateBlock( xWantedSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
+                {
+                    if( uxSizeClass < heapCACHE_SIZE_CLASSES )
+                    {
+                        if( pxBlock != NULL )
+                        {
+                            prvRefillCoreCache( uxSizeClass );
+                        }
+                        else
+                        {
+                            /* The heap may only be exhausted because free
+                             * blocks are held in this core's cache. */
+                            for( uxClass = 0; uxClass < heapCACHE_SIZE_CLASSES; uxClass++ )
+                            {
+                                ( void ) prvFlushCoreCache( &( xCoreCaches[ portGET_CORE_ID() ] ), uxClass, 0 );
+                            }
+
+                            pxBlock = prvAllocateBlock( xWantedSize );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_HEAP_CORE_CACHES */
+
+                if( pxBlock != NULL )
+                {
+                    heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                    xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+                    xNumberOfSuccessfulAllocations++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BaseType_t xCached = pdFALSE;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            if( pxLink->pxNextFreeBlock == NULL )
+            {
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
+                {
+                    xCached = prvFreeToCoreCache( pxLink );
+                }
+                #endif
+
+                if( xCached == pdFALSE )
+                {
+                    #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                    {
+                        /* Check for underflow as this can occur if xBlockSize is
+                         * overwritten in a heap block. */
+                        if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK, xHeapStructSize ) == 0 )
+                        {
+                            ( void ) memset( puc + xHeapStructSize, 0, ( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) - xHeapStructSize );
+                        }
+                    }
+                    #endif
+
+                    vTaskSuspendAll();
+                    {
+                        /* The block is being returned to the heap - it is no
+                         * longer allocated.  This is done with the scheduler
+                         * suspended so pvPortRealloc() never finds a free
+                         * block that is not yet in the list of free blocks. */
+                        heapFREE_BLOCK( pxLink );
+
+                        /* Add this block to the list of free blocks. */
+                        xFreeBytesRemaining += pxLink->xBlockSize;
+                        traceFREE( pv, pxLink->xBlockSize );
+                        prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                        xNumberOfSuccessfulFrees++;
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            /* Attribute the block to the caller of this function rather than
+             * to this function. */
+            heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNextBlock;
+    BlockLink_t * pxIterator;
     BlockLink_t * pxNewBlockLink;
     void * pvReturn = NULL;
-    size_t xAdditionalRequiredSize;
+    size_t xBlockSize = 0;
+    size_t xNewBlockSize;
+
+    if( pv == NULL )
+    {
+        pvReturn = pvPortMalloc( xWantedSize );
+    }
+    else if( xWantedSize == ( size_t ) 0 )
+    {
+        vPortFree( pv );
+    }
+    else
+    {
+        /* The memory being resized will have an BlockLink_t structure
+         * immediately before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        xNewBlockSize = prvGetBlockSize( xWantedSize );
+
+        if( ( xNewBlockSize > ( size_t ) 0 ) && ( heapBLOCK_SIZE_IS_VALID( xNewBlockSize ) != 0 ) )
+        {
+            vTaskSuspendAll();
+            {
+                xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+                if( xNewBlockSize <= xBlockSize )
+                {
+                    traceFREE( pv, xBlockSize );
+                    pvReturn = pv;
+                }
+                else
+                {
+                    /* The block can grow in place if the block that follows
+                     * it is free and large enough.  The block that follows the
+                     * last block in a region is an end marker of size 0. */
+                    pxNextBlock = ( void * ) ( puc + xBlockSize );
+
+                    if( ( heapBLOCK_IS_ALLOCATED( pxNextBlock ) == 0 ) &&
+                        ( pxNextBlock->xBlockSize > ( size_t ) 0 ) &&
+                        ( ( xBlockSize + pxNextBlock->xBlockSize ) >= xNewBlockSize ) )
+                    {
+                        /* Find the free block that comes before the block
+                         * being absorbed in the list of free blocks. */
+                        for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxNextBlock; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+                        {
+                            /* There is nothing to do here, just iterate to the right
+                             * position. */
+                        }
+
+                        configASSERT( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) == pxNextBlock );
+
+                        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                        xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        traceFREE( pv, xBlockSize );
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        pxLink->xBlockSize = xBlockSize;
+                        heapALLOCATE_BLOCK( pxLink );
+                        pvReturn = pv;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pvReturn != NULL )
+                {
+                    /* Return any bytes beyond the end of the resized block
+                     * to the heap if there are enough to form a block. */
+                    if( ( xBlockSize - xNewBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( puc + xNewBlockSize );
+                        pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+                        pxLink->xBlockSize = xNewBlockSize;
+                        heapALLOCATE_BLOCK( pxLink );
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceMALLOC( pv, pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( pvReturn == NULL )
+            {
+                /* The block could not grow in place, so move it.  The
+                 * original block is left untouched if that fails. */
+                pvReturn = pvPortMalloc( xWantedSize );
+
+                if( pvReturn != NULL )
+                {
+                    ( void ) memcpy( pvReturn, pv, xBlockSize - xHeapStructSize );
+                    vPortFree( pv );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    if( pvReturn != NULL )
+    {
+        /* Attribute the block to the caller of this function rather than
+         * to this function. */
+        heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocAligned( size_t xWantedSize,
+                           size_t xAlignment )
+{
+    BlockLink_t * pxBlock = NULL;
+    void * pvReturn = NULL;
     size_t xAllocatedBlockSize = 0;
 
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        UBaseType_t uxClass;
+    #endif
+
     /* The heap must be initialised before the first call to
      * pvPortMalloc(). */
     configASSERT( pxEnd );
 
+    /* The alignment must be a power of two. */
+    configASSERT( ( xAlignment != ( size_t ) 0 ) && ( ( xAlignment & ( xAlignment - 1U ) ) == ( size_t ) 0 ) );
+
+    if( xAlignment <= ( size_t ) portBYTE_ALIGNMENT )
+    {
+        /* All blocks are aligned to at least portBYTE_ALIGNMENT bytes. */
+        pvReturn = pvPortMalloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            heapRECORD_OWNER( ( BlockLink_t * ) ( ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) ), portGET_CALLER_ADDRESS() );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else if( ( xAlignment & ( xAlignment - 1U ) ) == ( size_t ) 0 )
+    {
+        xWantedSize = prvGetBlockSize( xWantedSize );
+
+        vTaskSuspendAll();
+        {
+            if( ( xWantedSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                pxBlock = prvAllocateAlignedBlock( xWantedSize, xAlignment );
+
+                #if ( configUSE_HEAP_CORE_CACHES == 1 )
+                {
+                    if( pxBlock == NULL )
+                    {
+                        /* The heap may only be exhausted because free blocks
+                         * are held in this core's cache. */
+                        for( uxClass = 0; uxClass < heapCACHE_SIZE_CLASSES; uxClass++ )
+                        {
+                            ( void ) prvFlushCoreCache( &( xCoreCaches[ portGET_CORE_ID() ] ), uxClass, 0 );
+                        }
+
+                        pxBlock = prvAllocateAlignedBlock( xWantedSize, xAlignment );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_HEAP_CORE_CACHES */
+
+                if( pxBlock != NULL )
+                {
+                    heapRECORD_OWNER( pxBlock, portGET_CALLER_ADDRESS() );
+                    xAllocatedBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+                    xNumberOfSuccessfulAllocations++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1U ) ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetBlockSize( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    size_t xAdditionalRequiredSize;
+
     if( xWantedSize > 0 )
     {
         /* The wanted size must be increased so it can contain a BlockLink_t
@@ -257,93 +987,286 @@ void * pvPortMalloc( size_t xWantedSize )
         mtCOVERAGE_TEST_MARKER();
     }
 
-    vTaskSuspendAll();
+    return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvClaimFreeBlock( BlockLink_t * pxPreviousBlock,
+                               BlockLink_t * pxBlock,
+                               size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxNewBlockLink;
+
+    /* This block is being returned for use so must be taken out
+     * of the list of free blocks. */
+    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+    /* If the block is larger than required it can be split into
+     * two. */
+    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+
+    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+    {
+        /* This block is to be split into two.  Create a new
+         * block following the number of bytes requested. The void
+         * cast is used to prevent byte alignment warnings from the
+         * compiler. */
+        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+        /* Calculate the sizes of two blocks split from the
+         * single block. */
+        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+        pxBlock->xBlockSize = xWantedSize;
+
+        /* Insert the new block into the list of free blocks. */
+        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+    {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+    else
     {
-        /* Check the block size we are trying to allocate is not so large that the
-         * top bit is set.  The top bit of the block size member of the BlockLink_t
-         * structure is used to determine who owns the block - the application or
-         * the kernel, so it must be free. */
-        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The block is being returned - it is allocated and owned
+     * by the application and has no "next" block. */
+    heapALLOCATE_BLOCK( pxBlock );
+    pxBlock->pxNextFreeBlock = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocateBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+
+    /* Traverse the list from the start (lowest address) block until
+     * one of adequate size is found. */
+    pxPreviousBlock = &xStart;
+    pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+    while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+    {
+        pxPreviousBlock = pxBlock;
+        pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+        heapVALIDATE_BLOCK_POINTER( pxBlock );
+    }
+
+    /* If the end marker was reached then a block of adequate size
+     * was not found. */
+    if( pxBlock != pxEnd )
+    {
+        prvClaimFreeBlock( pxPreviousBlock, pxBlock, xWantedSize );
+    }
+    else
+    {
+        pxBlock = NULL;
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvAllocateAlignedBlock( size_t xWantedSize,
+                                              size_t xAlignment ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxAlignedBlock;
+    portPOINTER_SIZE_TYPE uxAlignedAddress;
+    size_t xLeadingSize = 0;
+    BaseType_t xFound = pdFALSE;
+
+    /* Traverse the list from the start (lowest address) block until one is
+     * found that holds xWantedSize bytes starting from an address at which the
+     * memory returned to the application is aligned to xAlignment. */
+    pxPreviousBlock = &xStart;
+    pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+    while( ( xFound == pdFALSE ) && ( pxBlock != pxEnd ) )
+    {
+        uxAlignedAddress = ( ( portPOINTER_SIZE_TYPE ) pxBlock ) + ( portPOINTER_SIZE_TYPE ) xHeapStructSize + ( portPOINTER_SIZE_TYPE ) ( xAlignment - 1U );
+        uxAlignedAddress &= ~( ( portPOINTER_SIZE_TYPE ) ( xAlignment - 1U ) );
+        xLeadingSize = ( size_t ) ( uxAlignedAddress - ( portPOINTER_SIZE_TYPE ) xHeapStructSize - ( portPOINTER_SIZE_TYPE ) pxBlock );
+
+        /* Any bytes skipped at the start of the free block remain free, so
+         * must be enough to hold a block of their own. */
+        while( ( xLeadingSize != ( size_t ) 0 ) && ( xLeadingSize < heapMINIMUM_BLOCK_SIZE ) )
         {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
-            {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
-                heapVALIDATE_BLOCK_POINTER( pxBlock );
+            xLeadingSize += xAlignment;
+        }
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
-                {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
-                    heapVALIDATE_BLOCK_POINTER( pxBlock );
-                }
+        if( ( xLeadingSize < pxBlock->xBlockSize ) && ( ( pxBlock->xBlockSize - xLeadingSize ) >= xWantedSize ) )
+        {
+            xFound = pdTRUE;
+        }
+        else
+        {
+            pxPreviousBlock = pxBlock;
+            pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+            heapVALIDATE_BLOCK_POINTER( pxBlock );
+        }
+    }
 
-                /* If the end marker was reached then a block of adequate size
-                 * was not found. */
-                if( pxBlock != pxEnd )
-                {
-                    /* Return the memory space pointed to - jumping over the
-                     * BlockLink_t structure at its start. */
-                    pvReturn = ( void * ) ( ( ( uint8_t * ) heapPROTECT_BLOCK_POINTER( pxPreviousBlock->pxNextFreeBlock ) ) + xHeapStructSize );
-                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+    if( xFound != pdFALSE )
+    {
+        if( xLeadingSize > ( size_t ) 0 )
+        {
+            /* Split off the leading bytes, which stay in the list of free
+             * blocks, so the block that follows them is correctly aligned. */
+            pxAlignedBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingSize );
+            pxAlignedBlock->xBlockSize = pxBlock->xBlockSize - xLeadingSize;
+            pxAlignedBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+            pxBlock->xBlockSize = xLeadingSize;
+            pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxAlignedBlock );
+
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxAlignedBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                    /* This block is being returned for use so must be taken out
-                     * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+        prvClaimFreeBlock( pxPreviousBlock, pxBlock, xWantedSize );
+    }
+    else
+    {
+        pxBlock = NULL;
+    }
 
-                    /* If the block is larger than required it can be split into
-                     * two. */
-                    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
 
-                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-                    {
-                        /* This block is to be split into two.  Create a new
-                         * block following the number of bytes requested. The void
-                         * cast is used to prevent byte alignment warnings from the
-                         * compiler. */
-                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-                        /* Calculate the sizes of two blocks split from the
-                         * single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
-                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+#if ( configUSE_HEAP_CORE_CACHES == 1 )
 
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+    static UBaseType_t prvGetSizeClass( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxSizeClass = 0;
 
-                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
-                    {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        while( ( uxSizeClass < heapCACHE_SIZE_CLASSES ) && ( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) < xBlockSize ) )
+        {
+            uxSizeClass++;
+        }
+
+        return uxSizeClass;
+    }
+/*-----------------------------------------------------------*/
+
+    static BlockLink_t * prvAllocateFromCoreCache( UBaseType_t uxSizeClass ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapCoreCache_t * pxCache;
+        BlockLink_t * pxBlock = NULL;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        heapENTER_CORE_CACHE();
+        {
+            pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+            if( pxCache->uxBlockCount[ uxSizeClass ] > ( UBaseType_t ) 0U )
+            {
+                pxCache->uxBlockCount[ uxSizeClass ]--;
+                pxBlock = pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ];
+                pxCache->xCachedBytes -= pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                pxCache->xNumberOfHits++;
+
+                /* The block is allocated to the application again. */
+                configASSERT( pxBlock->pxNextFreeBlock == heapCACHED_BLOCK_TAG );
+                pxBlock->pxNextFreeBlock = NULL;
+            }
+            else
+            {
+                pxCache->xNumberOfMisses++;
+            }
+        }
+        heapEXIT_CORE_CACHE();
+
+        return pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFreeToCoreCache( BlockLink_t * pxLink ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapCoreCache_t * pxCache;
+        UBaseType_t uxSizeClass;
+        size_t xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        /* Only blocks that exactly match a size class are cached.  Blocks that
+         * were not split because the remainder was too small are returned to
+         * the heap. */
+        uxSizeClass = prvGetSizeClass( xBlockSize );
+
+        if( ( uxSizeClass < heapCACHE_SIZE_CLASSES ) && ( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) == xBlockSize ) )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( ( ( uint8_t * ) pxLink ) + xHeapStructSize, 0, xBlockSize - xHeapStructSize );
+            }
+            #endif
 
-                    xAllocatedBlockSize = pxBlock->xBlockSize;
+            traceFREE( ( void * ) ( ( ( uint8_t * ) pxLink ) + xHeapStructSize ), xBlockSize );
+            heapRECORD_CACHED( pxLink );
+            pxLink->pxNextFreeBlock = heapCACHED_BLOCK_TAG;
 
-                    /* The block is being returned - it is allocated and owned
-                     * by the application and has no "next" block. */
-                    heapALLOCATE_BLOCK( pxBlock );
-                    pxBlock->pxNextFreeBlock = NULL;
-                    xNumberOfSuccessfulAllocations++;
+            heapENTER_CORE_CACHE();
+            {
+                pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+
+                if( pxCache->uxBlockCount[ uxSizeClass ] < ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH )
+                {
+                    pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxLink;
+                    pxCache->uxBlockCount[ uxSizeClass ]++;
+                    pxCache->xCachedBytes += xBlockSize;
+                    pxCache->xNumberOfFrees++;
+                    xReturn = pdTRUE;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            heapEXIT_CORE_CACHE();
+
+            if( xReturn == pdFALSE )
+            {
+                /* The cache is full, so return a batch of blocks to the heap
+                 * to make room.  The scheduler is suspended so the calling
+                 * task cannot move to another core while it uses the cache. */
+                vTaskSuspendAll();
+                {
+                    pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+                    ( void ) prvFlushCoreCache( pxCache, uxSizeClass, ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH - heapCACHE_BATCH_SIZE );
+
+                    pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxLink;
+                    pxCache->uxBlockCount[ uxSizeClass ]++;
+                    pxCache->xCachedBytes += xBlockSize;
+                    pxCache->xNumberOfFrees++;
+                    xReturn = pdTRUE;
+                }
+                ( void ) xTaskResumeAll();
+            }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
@@ -354,121 +1277,77 @@ void * pvPortMalloc( size_t xWantedSize )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceMALLOC( pvReturn, xAllocatedBlockSize );
-
-        /* Prevent compiler warnings when trace macros are not used. */
-        ( void ) xAllocatedBlockSize;
+        return xReturn;
     }
-    ( void ) xTaskResumeAll();
+/*-----------------------------------------------------------*/
 
-    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    static void prvRefillCoreCache( UBaseType_t uxSizeClass ) /* PRIVILEGED_FUNCTION */
     {
-        if( pvReturn == NULL )
+        HeapCoreCache_t * pxCache = &( xCoreCaches[ portGET_CORE_ID() ] );
+        BlockLink_t * pxBlock = NULL;
+        UBaseType_t uxTarget;
+
+        uxTarget = pxCache->uxBlockCount[ uxSizeClass ] + heapCACHE_BATCH_SIZE;
+
+        if( uxTarget > ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH )
         {
-            vApplicationMallocFailedHook();
+            uxTarget = ( UBaseType_t ) configHEAP_CORE_CACHE_DEPTH;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
-
-    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
-    return pvReturn;
-}
-/*-----------------------------------------------------------*/
-
-void vPortFree( void * pv )
-{
-    uint8_t * puc = ( uint8_t * ) pv;
-    BlockLink_t * pxLink;
-
-    if( pv != NULL )
-    {
-        /* The memory being freed will have an BlockLink_t structure immediately
-         * before it. */
-        puc -= xHeapStructSize;
-
-        /* This casting is to keep the compiler from issuing warnings. */
-        pxLink = ( void * ) puc;
-
-        heapVALIDATE_BLOCK_POINTER( pxLink );
-        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
-        configASSERT( pxLink->pxNextFreeBlock == NULL );
 
-        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        while( pxCache->uxBlockCount[ uxSizeClass ] < uxTarget )
         {
-            if( pxLink->pxNextFreeBlock == NULL )
-            {
-                /* The block is being returned to the heap - it is no longer
-                 * allocated. */
-                heapFREE_BLOCK( pxLink );
-                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
-                {
-                    /* Check for underflow as this can occur if xBlockSize is
-                     * overwritten in a heap block. */
-                    if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize, xHeapStructSize ) == 0 )
-                    {
-                        ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
-                    }
-                }
-                #endif
+            pxBlock = prvAllocateBlock( heapCACHE_CLASS_BLOCK_SIZE( uxSizeClass ) );
 
-                vTaskSuspendAll();
-                {
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
-                    xNumberOfSuccessfulFrees++;
-                }
-                ( void ) xTaskResumeAll();
+            if( pxBlock == NULL )
+            {
+                /* Leave the remaining heap for requests that cannot be
+                 * cached. */
+                uxTarget = pxCache->uxBlockCount[ uxSizeClass ];
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                heapRECORD_CACHED( pxBlock );
+                pxBlock->pxNextFreeBlock = heapCACHED_BLOCK_TAG;
+                pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ] = pxBlock;
+                pxCache->uxBlockCount[ uxSizeClass ]++;
+                pxCache->xCachedBytes += pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
     }
-}
-/*-----------------------------------------------------------*/
-
-size_t xPortGetFreeHeapSize( void )
-{
-    return xFreeBytesRemaining;
-}
-/*-----------------------------------------------------------*/
-
-size_t xPortGetMinimumEverFreeHeapSize( void )
-{
-    return xMinimumEverFreeBytesRemaining;
-}
 /*-----------------------------------------------------------*/
 
-void * pvPortCalloc( size_t xNum,
-                     size_t xSize )
-{
-    void * pv = NULL;
-
-    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    static BaseType_t prvFlushCoreCache( HeapCoreCache_t * pxCache,
+                                         UBaseType_t uxSizeClass,
+                                         UBaseType_t uxBlocksToKeep ) /* PRIVILEGED_FUNCTION */
     {
-        pv = pvPortMalloc( xNum * xSize );
+        BlockLink_t * pxBlock;
+        BaseType_t xReturn = pdFALSE;
 
-        if( pv != NULL )
+        while( pxCache->uxBlockCount[ uxSizeClass ] > uxBlocksToKeep )
         {
-            ( void ) memset( pv, 0, xNum * xSize );
+            pxCache->uxBlockCount[ uxSizeClass ]--;
+            pxBlock = pxCache->pxBlocks[ uxSizeClass ][ pxCache->uxBlockCount[ uxSizeClass ] ];
+
+            /* The block is returned to the heap exactly as vPortFree() would
+             * have returned it, other than its contents have already been
+             * cleared if configHEAP_CLEAR_MEMORY_ON_FREE is 1. */
+            heapFREE_BLOCK( pxBlock );
+            pxCache->xCachedBytes -= pxBlock->xBlockSize;
+            xFreeBytesRemaining += pxBlock->xBlockSize;
+            prvInsertBlockIntoFreeList( pxBlock );
+            xReturn = pdTRUE;
         }
-    }
 
-    return pv;
-}
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_HEAP_CORE_CACHES */
+
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxIterator;
@@ -617,6 +1496,14 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVI
         pxEnd->xBlockSize = 0;
         pxEnd->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
 
+        #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+        {
+            /* This is the last region until another one is added. */
+            pxEnd->xOwner = NULL;
+            heapSET_NEXT_REGION( pxEnd, NULL );
+        }
+        #endif
+
         /* To start with there is a single free block in this region that is
          * sized to take up the entire heap region minus the space taken by the
          * free block structure. */
@@ -629,6 +1516,23 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVI
         if( pxPreviousFreeBlock != NULL )
         {
             pxPreviousFreeBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxFirstFreeBlockInRegion );
+
+            #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+            {
+                /* The free list link above changes as blocks are allocated
+                 * and freed, so the physical link between the regions is
+                 * kept separately. */
+                heapSET_NEXT_REGION( pxPreviousFreeBlock, pxFirstFreeBlockInRegion );
+            }
+            #endif
+        }
+        else
+        {
+            #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+            {
+                pxFirstBlock = pxFirstFreeBlockInRegion;
+            }
+            #endif
         }
 
         xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
@@ -661,6 +1565,10 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     BlockLink_t * pxBlock;
     size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
 
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        BaseType_t xCoreID;
+    #endif
+
     vTaskSuspendAll();
     {
         pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
@@ -709,11 +1617,260 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            /* Allocations and frees satisfied by a cache are counted by the
+             * cache. */
+            pxHeapStats->xNumberOfCacheHits = 0;
+            pxHeapStats->xNumberOfCacheMisses = 0;
+            pxHeapStats->xCachedBytes = 0;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxHeapStats->xNumberOfCacheHits += xCoreCaches[ xCoreID ].xNumberOfHits;
+                pxHeapStats->xNumberOfCacheMisses += xCoreCaches[ xCoreID ].xNumberOfMisses;
+                pxHeapStats->xCachedBytes += xCoreCaches[ xCoreID ].xCachedBytes;
+                pxHeapStats->xNumberOfSuccessfulFrees += xCoreCaches[ xCoreID ].xNumberOfFrees;
+            }
+
+            pxHeapStats->xNumberOfSuccessfulAllocations += pxHeapStats->xNumberOfCacheHits;
+        }
+        #endif /* configUSE_HEAP_CORE_CACHES */
     }
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+
+    static TaskHandle_t prvGetAllocatingTask( void ) /* PRIVILEGED_FUNCTION */
+    {
+        TaskHandle_t xTask = NULL;
+
+        /* Before the scheduler starts the current task is just the highest
+         * priority task created so far, which is not the one allocating. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static BlockLink_t * prvGetNextPhysicalBlock( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNextBlock;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) );
+
+        if( pxNextBlock->xBlockSize == ( size_t ) 0 )
+        {
+            /* pxNextBlock is the marker at the end of a region, which points
+             * to the start of the next region, if any. */
+            pxNextBlock = heapGET_NEXT_REGION( pxNextBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNextBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBlockIsLive( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            if( pxBlock->xOwner == heapCACHED_BLOCK_OWNER )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapAllocations( HeapAllocationRecord_t * const pxRecords,
+                                          const UBaseType_t uxMaxRecords ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        UBaseType_t uxCount = 0;
+
+        vTaskSuspendAll();
+        {
+            /* pxFirstBlock will be NULL if the heap has not been initialised. */
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( prvBlockIsLive( pxBlock ) != pdFALSE )
+                {
+                    if( uxCount < uxMaxRecords )
+                    {
+                        pxRecords[ uxCount ].pvAddress = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                        pxRecords[ uxCount ].xBlockSizeInBytes = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                        pxRecords[ uxCount ].xOwner = pxBlock->xOwner;
+                        pxRecords[ uxCount ].pvCaller = pxBlock->pvCaller;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPortGetHeapAllocatedBytesForTask( TaskHandle_t xTask,
+                                              UBaseType_t * puxNumberOfBlocks ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        size_t xBytes = 0;
+        UBaseType_t uxBlocks = 0;
+
+        vTaskSuspendAll();
+        {
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( ( prvBlockIsLive( pxBlock ) != pdFALSE ) && ( pxBlock->xOwner == xTask ) )
+                {
+                    xBytes += pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                    uxBlocks++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( puxNumberOfBlocks != NULL )
+        {
+            *puxNumberOfBlocks = uxBlocks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats ) /* PRIVILEGED_FUNCTION */
+    {
+        const BlockLink_t * pxBlock;
+        size_t xMaxSize = 0;
+        size_t xBucketLimit;
+        UBaseType_t uxBucket;
+
+        ( void ) memset( pxFragmentationStats, 0x00, sizeof( HeapFragmentationStats_t ) );
+
+        vTaskSuspendAll();
+        {
+            pxBlock = pxFirstBlock;
+
+            while( pxBlock != NULL )
+            {
+                if( prvBlockIsLive( pxBlock ) != pdFALSE )
+                {
+                    pxFragmentationStats->xNumberOfLiveAllocations++;
+                }
+                else if( heapBLOCK_IS_ALLOCATED( pxBlock ) == 0 )
+                {
+                    /* Find the power of two bucket the free block falls in. */
+                    uxBucket = 0;
+                    xBucketLimit = ( size_t ) 32U;
+
+                    while( ( ( uxBucket + 1U ) < ( UBaseType_t ) configHEAP_FREE_BLOCK_HISTOGRAM_BUCKETS ) &&
+                           ( pxBlock->xBlockSize >= xBucketLimit ) &&
+                           ( heapADD_WILL_OVERFLOW( xBucketLimit, xBucketLimit ) == 0 ) )
+                    {
+                        uxBucket++;
+                        xBucketLimit <<= 1;
+                    }
+
+                    pxFragmentationStats->xFreeBlockHistogram[ uxBucket ]++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The block is held in a core cache. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxBlock = prvGetNextPhysicalBlock( pxBlock );
+            }
+
+            if( xMaxSize < xMinimumEverLargestFreeBlock )
+            {
+                xMinimumEverLargestFreeBlock = xMaxSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxFragmentationStats->xMinimumEverLargestFreeBlockInBytes = xMinimumEverLargestFreeBlock;
+        }
+        ( void ) xTaskResumeAll();
+
+        pxFragmentationStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_ALLOCATION_TRACKING */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -728,6 +1885,15 @@ void vPortHeapResetState( void )
     xNumberOfSuccessfulAllocations = ( size_t ) 0U;
     xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
+    #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        ( void ) memset( xCoreCaches, 0x00, sizeof( xCoreCaches ) );
+    #endif
+
+    #if ( configUSE_HEAP_ALLOCATION_TRACKING == 1 )
+        pxFirstBlock = NULL;
+        xMinimumEverLargestFreeBlock = heapSIZE_MAX;
+    #endif
+
     #if ( configENABLE_HEAP_PROTECTOR == 1 )
         pucHeapHighAddress = NULL;
         pucHeapLowAddress = NULL;
@@ -0,0 +1,957 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a
+ * Two-Level Segregated Fit (TLSF) allocator, so both functions execute in
+ * bounded time regardless of the number of free blocks or the degree of
+ * fragmentation.  Adjacent free blocks are combined (coalesced) as they are
+ * freed, and the heap can be defined across multiple non-contiguous memory
+ * regions in the same way as heap_5.c.
+ *
+ * Free blocks are held in a two dimensional array of lists.  The first level
+ * index is the position of the most significant bit set in the block size, and
+ * the second level index subdivides each power of two range into
+ * heapSL_INDEX_COUNT equal ranges.  A bitmap of the non-empty lists at each
+ * level allows a suitable free block to be found without searching.  Blocks
+ * smaller than heapSMALL_BLOCK_SIZE are held in first level list 0, which is
+ * divided linearly.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc().
+ * pvPortMalloc() will be called if any task objects (tasks, queues, event
+ * groups, etc.) are created, therefore vPortDefineHeapRegions() ***must*** be
+ * called before any other objects are defined.
+ *
+ * vPortDefineHeapRegions() takes a single parameter.  The parameter is an array
+ * of HeapRegion_t structures, terminated using a NULL zero sized region
+ * definition, exactly as described for heap_5.c.  Unlike heap_5.c the regions
+ * need not appear in address order, but they must not overlap.
+ *
+ * HeapRegion_t xHeapRegions[] =
+ * {
+ *  { ( uint8_t * ) 0x80000000UL, 0x10000 }, << Defines a block of 0x10000 bytes starting at address 0x80000000
+ *  { ( uint8_t * ) 0x90000000UL, 0xa0000 }, << Defines a block of 0xa0000 bytes starting at address of 0x90000000
+ *  { NULL, 0 }                << Terminates the array.
+ * };
+ *
+ * vPortDefineHeapRegions( xHeapRegions ); << Pass the array into vPortDefineHeapRegions().
+ *
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Free blocks must be large enough to hold the free list links. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )     ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )          ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* Check if the subtraction operation ( a - b ) will result in underflow. */
+#define heapSUBTRACT_WILL_UNDERFLOW( a, b )    ( ( a ) < ( b ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The number of second level lists per first level list, as a power of 2. */
+#define heapSL_INDEX_COUNT_LOG2        ( 4U )
+#define heapSL_INDEX_COUNT             ( ( size_t ) 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in first level list 0,
+ * which is divided linearly into second level lists. */
+#define heapFL_INDEX_SHIFT             ( 8U )
+#define heapSMALL_BLOCK_SIZE           ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The number of first level lists.  The MSB of a block size is never set, so
+ * the most significant bit set in a block size is at most bit
+ * ( bits in size_t - 2 ). */
+#define heapFL_INDEX_COUNT             ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - heapFL_INDEX_SHIFT )
+
+/* Setting configENABLE_HEAP_PROTECTOR to 1 enables heap block pointers
+ * protection using an application supplied canary value to catch heap
+ * corruption should a heap buffer overflow occur.
+ */
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/* Macro to load/store BlockLink_t pointers to memory. By XORing the
+ * pointers with a random canary value, heap overflows will result
+ * in randomly unpredictable pointer values which will be caught by
+ * heapVALIDATE_BLOCK_POINTER assert. */
+    #define heapPROTECT_BLOCK_POINTER( pxBlock )    ( ( BlockLink_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxBlock ) ) ^ xHeapCanary ) )
+
+/* Assert that a heap block pointer is within the heap bounds. */
+    #define heapVALIDATE_BLOCK_POINTER( pxBlock )                       \
+    configASSERT( ( pucHeapHighAddress != NULL ) &&                     \
+                  ( pucHeapLowAddress != NULL ) &&                      \
+                  ( ( uint8_t * ) ( pxBlock ) >= pucHeapLowAddress ) && \
+                  ( ( uint8_t * ) ( pxBlock ) < pucHeapHighAddress ) )
+
+#else /* if ( configENABLE_HEAP_PROTECTOR == 1 ) */
+
+    #define heapPROTECT_BLOCK_POINTER( pxBlock )    ( pxBlock )
+
+    #define heapVALIDATE_BLOCK_POINTER( pxBlock )
+
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/*-----------------------------------------------------------*/
+
+/* The header placed at the start of every block.  The free list links are only
+ * present in free blocks - in allocated blocks the same memory is returned to
+ * the application. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /**< The block immediately below this block in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                             /**< The size of the block, including this header. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /**< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /**< The previous block in the same free list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the least/most significant bit set in xBits, which
+ * must not be 0.  A binary search is used so the execution time is bounded.
+ */
+static UBaseType_t prvFindLowestSetBit( size_t xBits ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvFindHighestSetBit( size_t xBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Calculate the indexes of the free list that holds blocks of xBlockSize
+ * bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevelIndex,
+                             UBaseType_t * puxSecondLevelIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a free block into, or remove a free block from, the free list that
+ * matches its size.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find a free block of at least xWantedSize bytes without searching any free
+ * list.  Returns NULL if there is no such block.
+ */
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
+
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/**
+ * @brief Application provided function to get a random value to be used as canary.
+ *
+ * @param pxHeapCanary [out] Output parameter to return the canary value.
+ */
+    extern void vApplicationGetRandomHeapCanary( portPOINTER_SIZE_TYPE * pxHeapCanary );
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header placed at the beginning of each allocated memory block
+ * must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The heads of the free lists, and bitmaps of the non-empty free lists.  Bit n
+ * of uxFirstLevelBitmap is set if any bit of ulSecondLevelBitmaps[ n ] is set,
+ * and bit m of ulSecondLevelBitmaps[ n ] is set if pxFreeLists[ n ][ m ] is not
+ * empty. */
+PRIVILEGED_DATA static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+PRIVILEGED_DATA static size_t xFirstLevelBitmap = ( size_t ) 0U;
+PRIVILEGED_DATA static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xTotalHeapSize = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+#if ( configENABLE_HEAP_PROTECTOR == 1 )
+
+/* Canary value for protecting internal heap pointers. */
+    PRIVILEGED_DATA static portPOINTER_SIZE_TYPE xHeapCanary;
+
+/* Highest and lowest heap addresses used for heap block bounds checking. */
+    PRIVILEGED_DATA static uint8_t * pucHeapHighAddress = NULL;
+    PRIVILEGED_DATA static uint8_t * pucHeapLowAddress = NULL;
+
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    BlockLink_t * pxNextPhysicalBlock;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    size_t xAllocatedBlockSize = 0;
+
+    /* The heap must be initialised before the first call to
+     * pvPortMalloc(). */
+    configASSERT( xTotalHeapSize );
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * header in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block must be able to hold the free list links once it is
+             * freed again. */
+            if( ( xWantedSize > 0 ) && ( xWantedSize < heapMINIMUM_BLOCK_SIZE ) )
+            {
+                xWantedSize = heapMINIMUM_BLOCK_SIZE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* Check the block size we are trying to allocate is not so large that the
+         * top bit is set.  The top bit of the block size member of the BlockLink_t
+         * structure is used to determine who owns the block - the application or
+         * the kernel, so it must be free. */
+        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+        {
+            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                /* Locate a free block that is known to be large enough from
+                 * the free list bitmaps. */
+                pxBlock = prvFindSuitableBlock( xWantedSize );
+
+                if( pxBlock != NULL )
+                {
+                    /* This block is being returned for use so must be taken out
+                     * of the free lists. */
+                    prvRemoveBlockFromFreeList( pxBlock );
+
+                    /* If the block is larger than required it can be split into
+                     * two. */
+                    configASSERT( heapSUBTRACT_WILL_UNDERFLOW( pxBlock->xBlockSize, xWantedSize ) == 0 );
+
+                    if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+                    {
+                        /* This block is to be split into two.  Create a new
+                         * block following the number of bytes requested. The void
+                         * cast is used to prevent byte alignment warnings from the
+                         * compiler. */
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        /* Calculate the sizes of two blocks split from the
+                         * single block. */
+                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                        pxBlock->xBlockSize = xWantedSize;
+
+                        /* Link the new block into the chain of physical
+                         * blocks. */
+                        pxNewBlockLink->pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( pxBlock );
+                        pxNextPhysicalBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlockLink ) + pxNewBlockLink->xBlockSize );
+                        heapVALIDATE_BLOCK_POINTER( pxNextPhysicalBlock );
+                        pxNextPhysicalBlock->pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+
+                        /* Insert the new block into the free lists. */
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xAllocatedBlockSize = pxBlock->xBlockSize;
+
+                    /* The block is being returned - it is allocated and owned
+                     * by the application. */
+                    heapALLOCATE_BLOCK( pxBlock );
+                    xNumberOfSuccessfulAllocations++;
+
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t header at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+        /* Prevent compiler warnings when trace macros are not used. */
+        ( void ) xAllocatedBlockSize;
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxPreviousPhysicalBlock;
+    BlockLink_t * pxNextPhysicalBlock;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t header immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                /* Check for underflow as this can occur if xBlockSize is
+                 * overwritten in a heap block. */
+                if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK, xHeapStructSize ) == 0 )
+                {
+                    ( void ) memset( puc + xHeapStructSize, 0, ( pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) - xHeapStructSize );
+                }
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                /* The block is being returned to the heap - it is no longer
+                 * allocated.  This is done with the scheduler suspended so a
+                 * free of a neighbouring block never finds a free block that
+                 * is not yet in a free list. */
+                heapFREE_BLOCK( pxLink );
+
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                /* Merge the block with the block above it in memory if that
+                 * block is free.  The end of each region is marked by an
+                 * allocated block, so there is always a block above. */
+                pxNextPhysicalBlock = ( void * ) ( puc + pxLink->xBlockSize );
+                heapVALIDATE_BLOCK_POINTER( pxNextPhysicalBlock );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNextPhysicalBlock ) == 0 )
+                {
+                    prvRemoveBlockFromFreeList( pxNextPhysicalBlock );
+                    pxLink->xBlockSize += pxNextPhysicalBlock->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge the block with the block below it in memory if that
+                 * block is free. */
+                pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( pxLink->pxPreviousPhysicalBlock );
+
+                if( pxPreviousPhysicalBlock != NULL )
+                {
+                    heapVALIDATE_BLOCK_POINTER( pxPreviousPhysicalBlock );
+
+                    if( heapBLOCK_IS_ALLOCATED( pxPreviousPhysicalBlock ) == 0 )
+                    {
+                        prvRemoveBlockFromFreeList( pxPreviousPhysicalBlock );
+                        pxPreviousPhysicalBlock->xBlockSize += pxLink->xBlockSize;
+                        pxLink = pxPreviousPhysicalBlock;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block above the, possibly merged, block must now point
+                 * back to it. */
+                pxNextPhysicalBlock = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+                heapVALIDATE_BLOCK_POINTER( pxNextPhysicalBlock );
+                pxNextPhysicalBlock->pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( pxLink );
+
+                prvInsertBlockIntoFreeList( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLowestSetBit( size_t xBits ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxBit = 0;
+    UBaseType_t uxShift = ( UBaseType_t ) ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1 );
+
+    configASSERT( xBits != ( size_t ) 0 );
+
+    while( uxShift > ( UBaseType_t ) 0 )
+    {
+        if( ( xBits & ( ( ( size_t ) 1 << uxShift ) - ( size_t ) 1 ) ) == ( size_t ) 0 )
+        {
+            xBits >>= uxShift;
+            uxBit += uxShift;
+        }
+
+        uxShift >>= 1;
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindHighestSetBit( size_t xBits ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxBit = 0;
+    UBaseType_t uxShift = ( UBaseType_t ) ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1 );
+
+    configASSERT( xBits != ( size_t ) 0 );
+
+    while( uxShift > ( UBaseType_t ) 0 )
+    {
+        if( ( xBits >> uxShift ) != ( size_t ) 0 )
+        {
+            xBits >>= uxShift;
+            uxBit += uxShift;
+        }
+
+        uxShift >>= 1;
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize,
+                             UBaseType_t * puxFirstLevelIndex,
+                             UBaseType_t * puxSecondLevelIndex ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxHighestBit;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        *puxFirstLevelIndex = ( UBaseType_t ) 0;
+        *puxSecondLevelIndex = ( UBaseType_t ) ( xBlockSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+    }
+    else
+    {
+        /* The second level index is given by the heapSL_INDEX_COUNT_LOG2 bits
+         * below the most significant bit. */
+        uxHighestBit = prvFindHighestSetBit( xBlockSize );
+        *puxFirstLevelIndex = uxHighestBit - ( UBaseType_t ) ( heapFL_INDEX_SHIFT - 1U );
+        *puxSecondLevelIndex = ( UBaseType_t ) ( ( xBlockSize >> ( uxHighestBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock = NULL;
+    UBaseType_t uxFirstLevelIndex, uxSecondLevelIndex;
+    size_t xLargerFirstLevelBitmap;
+    uint32_t ulSecondLevelBitmap;
+
+    /* Round the size up to the next free list boundary so every block in the
+     * list that is found is large enough, and no list needs to be searched. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( prvFindHighestSetBit( xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+    }
+    else
+    {
+        xWantedSize += ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) - ( size_t ) 1;
+    }
+
+    if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+    {
+        prvMapBlockSize( xWantedSize, &uxFirstLevelIndex, &uxSecondLevelIndex );
+
+        /* Look for a non-empty list of equal or larger blocks within the same
+         * first level list. */
+        ulSecondLevelBitmap = ulSecondLevelBitmaps[ uxFirstLevelIndex ] & ( ~( uint32_t ) 0U << uxSecondLevelIndex );
+
+        if( ulSecondLevelBitmap == 0U )
+        {
+            /* There are none, so use the smallest blocks of any larger first
+             * level list. */
+            xLargerFirstLevelBitmap = xFirstLevelBitmap & ( heapSIZE_MAX << ( uxFirstLevelIndex + ( UBaseType_t ) 1 ) );
+
+            if( xLargerFirstLevelBitmap != ( size_t ) 0 )
+            {
+                uxFirstLevelIndex = prvFindLowestSetBit( xLargerFirstLevelBitmap );
+                ulSecondLevelBitmap = ulSecondLevelBitmaps[ uxFirstLevelIndex ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulSecondLevelBitmap != 0U )
+        {
+            uxSecondLevelIndex = prvFindLowestSetBit( ( size_t ) ulSecondLevelBitmap );
+            pxBlock = pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ];
+            heapVALIDATE_BLOCK_POINTER( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevelIndex, uxSecondLevelIndex;
+    BlockLink_t * pxHead;
+
+    prvMapBlockSize( pxBlockToInsert->xBlockSize, &uxFirstLevelIndex, &uxSecondLevelIndex );
+    configASSERT( uxFirstLevelIndex < ( UBaseType_t ) heapFL_INDEX_COUNT );
+
+    /* Insert the block at the head of its free list. */
+    pxHead = pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ];
+    pxBlockToInsert->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxHead );
+    pxBlockToInsert->pxPreviousFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPreviousFreeBlock = heapPROTECT_BLOCK_POINTER( pxBlockToInsert );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ] = pxBlockToInsert;
+
+    /* Mark the list as non-empty. */
+    xFirstLevelBitmap |= ( size_t ) 1 << uxFirstLevelIndex;
+    ulSecondLevelBitmaps[ uxFirstLevelIndex ] |= ( uint32_t ) 1U << uxSecondLevelIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevelIndex, uxSecondLevelIndex;
+    BlockLink_t * pxNext;
+    BlockLink_t * pxPrevious;
+
+    prvMapBlockSize( pxBlockToRemove->xBlockSize, &uxFirstLevelIndex, &uxSecondLevelIndex );
+    configASSERT( uxFirstLevelIndex < ( UBaseType_t ) heapFL_INDEX_COUNT );
+
+    pxNext = heapPROTECT_BLOCK_POINTER( pxBlockToRemove->pxNextFreeBlock );
+    pxPrevious = heapPROTECT_BLOCK_POINTER( pxBlockToRemove->pxPreviousFreeBlock );
+
+    if( pxNext != NULL )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxNext );
+        pxNext->pxPreviousFreeBlock = heapPROTECT_BLOCK_POINTER( pxPrevious );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxPrevious != NULL )
+    {
+        heapVALIDATE_BLOCK_POINTER( pxPrevious );
+        pxPrevious->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNext );
+    }
+    else
+    {
+        /* The block is at the head of its free list. */
+        configASSERT( pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ] == pxBlockToRemove );
+        pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ] = pxNext;
+
+        if( pxNext == NULL )
+        {
+            /* The list is now empty. */
+            ulSecondLevelBitmaps[ uxFirstLevelIndex ] &= ~( ( uint32_t ) 1U << uxSecondLevelIndex );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevelIndex ] == 0U )
+            {
+                xFirstLevelBitmap &= ~( ( size_t ) 1 << uxFirstLevelIndex );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxEndMarker;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xTotalHeapSize == 0 );
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+    {
+        vApplicationGetRandomHeapCanary( &( xHeapCanary ) );
+    }
+    #endif
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* An allocated block with only a header marks the end of the region, so
+         * a block being freed is never merged beyond the region. */
+        xAddress = xAlignedHeap + ( portPOINTER_SIZE_TYPE ) xTotalRegionSize;
+        xAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        pxEndMarker = ( BlockLink_t * ) xAddress;
+
+        /* To start with there is a single free block in this region that is
+         * sized to take up the entire heap region minus the space taken by the
+         * end marker. */
+        pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+        configASSERT( ( size_t ) ( xAddress - xAlignedHeap ) >= heapMINIMUM_BLOCK_SIZE );
+
+        #if ( configENABLE_HEAP_PROTECTOR == 1 )
+        {
+            if( ( pucHeapLowAddress == NULL ) ||
+                ( ( uint8_t * ) xAlignedHeap < pucHeapLowAddress ) )
+            {
+                pucHeapLowAddress = ( uint8_t * ) xAlignedHeap;
+            }
+
+            if( ( pucHeapHighAddress == NULL ) ||
+                ( ( ( uint8_t * ) pxEndMarker ) + xHeapStructSize > pucHeapHighAddress ) )
+            {
+                pucHeapHighAddress = ( ( uint8_t * ) pxEndMarker ) + xHeapStructSize;
+            }
+        }
+        #endif /* configENABLE_HEAP_PROTECTOR */
+
+        pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - xAlignedHeap );
+        pxFirstFreeBlockInRegion->pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( NULL );
+
+        pxEndMarker->xBlockSize = 0;
+        heapALLOCATE_BLOCK( pxEndMarker );
+        pxEndMarker->pxPreviousPhysicalBlock = heapPROTECT_BLOCK_POINTER( pxFirstFreeBlockInRegion );
+
+        prvInsertBlockIntoFreeList( pxFirstFreeBlockInRegion );
+
+        xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxFirstLevelIndex, uxSecondLevelIndex;
+
+    vTaskSuspendAll();
+    {
+        for( uxFirstLevelIndex = 0; uxFirstLevelIndex < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFirstLevelIndex++ )
+        {
+            for( uxSecondLevelIndex = 0; uxSecondLevelIndex < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSecondLevelIndex++ )
+            {
+                pxBlock = pxFreeLists[ uxFirstLevelIndex ][ uxSecondLevelIndex ];
+
+                while( pxBlock != NULL )
+                {
+                    /* Increment the number of blocks and record the largest
+                     * and smallest blocks seen so far. */
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+
+                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+        #if ( configUSE_HEAP_CORE_CACHES == 1 )
+        {
+            /* Core caches are only implemented by heap_4.c and heap_5.c. */
+            pxHeapStats->xNumberOfCacheHits = 0;
+            pxHeapStats->xNumberOfCacheMisses = 0;
+            pxHeapStats->xCachedBytes = 0;
+        }
+        #endif
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    ( void ) memset( pxFreeLists, 0x00, sizeof( pxFreeLists ) );
+    ( void ) memset( ulSecondLevelBitmaps, 0x00, sizeof( ulSecondLevelBitmaps ) );
+    xFirstLevelBitmap = ( size_t ) 0U;
+
+    xTotalHeapSize = ( size_t ) 0U;
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+    #if ( configENABLE_HEAP_PROTECTOR == 1 )
+        pucHeapHighAddress = NULL;
+        pucHeapLowAddress = NULL;
+    #endif /* #if ( configENABLE_HEAP_PROTECTOR == 1 ) */
+}
+/*-----------------------------------------------------------*/
@@ -34,11 +34,32 @@
 * running are blocked in sigwait().
 *
 * Task switch is done by resuming the thread for the next task by
-* signaling the condition variable and then waiting on a condition variable
-* with the current thread.
+* signaling its event and then waiting on the event of the current thread.
+* On Linux an event is a futex, elsewhere a condition variable.
 *
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
+* The tick thread sleeps to absolute deadlines, and the tick handler
+* announces every tick period that has elapsed since the previous
+* tick, so the tick count does not drift from the host clock when
+* signals are delayed or merged.
+*
+* When configUSE_TICKLESS_IDLE is 1 on Linux with a single core, the idle
+* task stops the tick thread and waits for a signal (interrupt) with a
+* timeout that ends at the next task unblock time, then steps the tick count
+* over the time it slept.
+*
+* When configUSE_HIGH_RESOLUTION_TIMERS is 1 the high resolution timer
+* compare is a timerfd read by a dedicated thread, which raises the
+* compare interrupt by sending SIGUSR2 to the thread for the current task.
+*
+* When configNUMBER_OF_CORES is greater than 1 each simulated core is the
+* thread of the task it is running, so tasks on different cores run
+* concurrently.  A thread records the core it was resumed on, and on Linux
+* is pinned to a host CPU chosen for that core.  A yield is requested by
+* sending SIGURG to the thread running on the target core.  The task and ISR
+* locks are recursive spin locks owned by a core.  The tick and high
+* resolution timer interrupts are taken by core 0.
 *
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
@@ -52,10 +73,10 @@
 #ifdef __linux__
     #define _GNU_SOURCE
 #endif
-#include "portmacro.h"
 #include <errno.h>
 #include <pthread.h>
 #include <limits.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -74,9 +95,56 @@
 #include "task.h"
 #include "timers.h"
 #include "utils/wait_for_event.h"
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    #include <sys/timerfd.h>
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME      SIGUSR1
+#define SIG_HR_TIMER    SIGUSR2
+
+/* The port provides tickless idle for a single core on Linux.  With virtual
+ * time the idle task advances the tick count instead. */
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configNUMBER_OF_CORES == 1 ) && defined( __linux__ ) && ( configUSE_VIRTUAL_TIME == 0 ) )
+    #define portTICKLESS_IDLE    1
+#else
+    #define portTICKLESS_IDLE    0
+#endif
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    #if ( configNUMBER_OF_CORES > 1 ) || !defined( __linux__ )
+        #error configUSE_VIRTUAL_TIME is only supported on a single core on Linux
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 1 )
+        #error configUSE_TICKLESS_IDLE must be set to 1 when configUSE_VIRTUAL_TIME is set to 1
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+        #error configUSE_HIGH_RESOLUTION_TIMERS cannot be used with configUSE_VIRTUAL_TIME as the high resolution timers run in host time
+    #endif
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 ) && !defined( __linux__ )
+    #error configUSE_SIMULATED_INTERRUPTS is only supported on Linux
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    #define SIG_YIELD_CORE    SIGURG
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    #define SIG_INTERRUPT     SIGIO
+
+/* The epoll data of the eventfd used to wake the interrupt thread. */
+    #define portINTERRUPT_WAKE_ID    ( ( uint32_t ) portMAX_INTERRUPTS )
+#endif
 
 typedef struct THREAD
 {
@@ -85,8 +153,26 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID;       /* The core the thread was last resumed on. */
+        BaseType_t xPinnedCoreID; /* The core whose host CPU the thread is pinned to, or -1. */
+    #endif
 } Thread_t;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * A recursive spin lock used for the task and ISR locks.  The lock is owned by
+ * a core rather than by a thread as the task that took it can be resumed on a
+ * different thread.
+ */
+    typedef struct PORT_RECURSIVE_LOCK
+    {
+        BaseType_t xOwnerCoreID; /* The core holding the lock, or -1 when the lock is free. */
+        UBaseType_t uxCount;     /* The number of times the owner has taken the lock. */
+    } PortRecursiveLock_t;
+#endif
+
 /*
  * The additional per-thread data is stored at the beginning of the
  * task's stack.
@@ -104,11 +190,68 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile BaseType_t uxCriticalNesting;
+#if ( configNUMBER_OF_CORES == 1 )
+    static volatile BaseType_t uxCriticalNesting;
+#endif
 static BaseType_t xSchedulerEnd = pdFALSE;
-static pthread_t hTimerTickThread;
-static bool xTimerTickThreadShouldRun;
+#if ( configUSE_VIRTUAL_TIME == 0 )
+    static pthread_t hTimerTickThread;
+    static bool xTimerTickThreadShouldRun;
+#endif
 static uint64_t prvStartTimeNs;
+static uint64_t prvTickCount;
+
+#if ( portTICKLESS_IDLE == 1 )
+    static volatile bool xTickSuppressed = false;
+    static struct event * pxTickResumeEvent = NULL; /* Signalled to restart the tick thread after a tickless idle period. */
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    static int iHRTimerFd = -1;
+    static pthread_t hHRTimerThread;
+    static bool xHRTimerThreadShouldRun;
+    static volatile sig_atomic_t xHRTimerInterruptPending;
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+
+/* A simulated interrupt, raised by software or when a host file descriptor
+ * becomes readable. */
+    typedef struct PORT_INTERRUPT
+    {
+        PortInterruptHandler_t pxHandler; /* NULL if no handler is installed. */
+        void * pvParameter;
+        int iFd;                          /* The file descriptor that raises the interrupt, or -1. */
+    } PortInterrupt_t;
+
+    static PortInterrupt_t xInterrupts[ portMAX_INTERRUPTS ];
+    static uint32_t ulPendingInterrupts = 0; /* One bit per interrupt number. */
+    static pthread_once_t hInterruptsCreated = PTHREAD_ONCE_INIT;
+    static int iInterruptEpollFd = -1;
+    static int iInterruptEventFd = -1;
+    static pthread_t hInterruptThread;
+    static bool xInterruptThreadShouldRun;
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    static __thread Thread_t * pxThisThread = NULL;
+
+/* The pthread running each core, written before the thread is resumed.  The
+ * timer and interrupt threads signal core 0 through this rather than through
+ * the TCB of the task running on core 0, as that task can be deleted by another
+ * core. */
+    static pthread_t hCoreThreads[ configNUMBER_OF_CORES ];
+    static PortRecursiveLock_t xPortLocks[ 2 ] = { { -1, 0 }, { -1, 0 } };
+
+/* Set by each core other than the one that ends the scheduler once it has
+ * stopped running kernel code. */
+    static BaseType_t xCoreParked[ configNUMBER_OF_CORES ];
+
+    #ifdef __linux__
+        static int iHostCpuForCore[ configNUMBER_OF_CORES ];
+        static BaseType_t xPinToHostCpus = pdFALSE;
+    #endif
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -121,6 +264,28 @@ static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
+static pthread_t prvGetInterruptThread( void );
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    static void prvHRTimerCreate( void );
+    static void * prvHRTimerHandler( void * arg );
+    static void vPortHRTimerInterruptHandler( int sig );
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    static void prvInterruptsCreate( void );
+    static void * prvInterruptThread( void * arg );
+    static void vPortInterruptHandler( int sig );
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+    static void vPortYieldCoreHandler( int sig );
+    static void prvPinThreadToCore( Thread_t * pxThread );
+    static void prvParkCore( void );
+    #ifdef __linux__
+        static void prvSetupHostCpus( void );
+    #endif
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char * pcCall,
@@ -154,6 +319,7 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 {
     Thread_t * thread;
     pthread_attr_t xThreadAttributes;
+    sigset_t xSavedSignalMask;
     size_t ulStackSize;
     int iRet;
 
@@ -179,6 +345,13 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
     thread->pvParams = pvParameters;
     thread->xDying = pdFALSE;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        thread->xCoreID = 0;
+        thread->xPinnedCoreID = -1;
+    }
+    #endif
+
     /* Ensure ulStackSize is at least PTHREAD_STACK_MIN */
     ulStackSize = (ulStackSize < ( size_t ) ( PTHREAD_STACK_MIN ) ) ? ( size_t ) ( PTHREAD_STACK_MIN ) : ulStackSize;
 
@@ -192,7 +365,9 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
     thread->ev = event_create();
 
-    vPortEnterCritical();
+    /* The new thread inherits the signal mask, and must start with all
+     * signals blocked. */
+    ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xSavedSignalMask );
 
     iRet = pthread_create( &thread->pthread, &xThreadAttributes,
                            prvWaitForStart, thread );
@@ -202,7 +377,7 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
         prvFatalError( "pthread_create", iRet );
     }
 
-    vPortExitCritical();
+    ( void ) pthread_sigmask( SIG_SETMASK, &xSavedSignalMask, NULL );
 
     return pxTopOfStack;
 }
@@ -210,10 +385,27 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
+
+        /* Start the first task on each core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            prvResumeThread( pxFirstThread );
+        }
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -228,10 +420,38 @@ BaseType_t xPortStartScheduler( void )
     hMainThread = pthread_self();
     prvPortSetCurrentThreadName("Scheduler");
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+
+        /* The timer and interrupt threads signal core 0 as soon as they start. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            hCoreThreads[ xCoreID ] = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) )->pthread;
+            xCoreParked[ xCoreID ] = pdFALSE;
+        }
+
+        #ifdef __linux__
+            prvSetupHostCpus();
+        #endif
+    }
+    #endif /* configNUMBER_OF_CORES > 1 */
+
     /* Start the timer that generates the tick ISR(SIGALRM).
      * Interrupts are disabled here already. */
     prvSetupTimerInterrupt();
 
+    #if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    {
+        /* Start the thread that raises the simulated interrupts.  Interrupts
+         * installed or raised before the scheduler started are held until
+         * now. */
+        ( void ) pthread_once( &hInterruptsCreated, prvInterruptsCreate );
+        xInterruptThreadShouldRun = true;
+        pthread_create( &hInterruptThread, NULL, prvInterruptThread, NULL );
+    }
+    #endif
+
     /*
      * Block SIG_RESUME before starting any tasks so the main thread can sigwait on it.
      * To sigwait on an unblocked signal is undefined.
@@ -276,12 +496,82 @@ void vPortEndScheduler( void )
 {
     Thread_t * pxCurrentThread;
 
-    /* Stop the timer tick thread. */
-    xTimerTickThreadShouldRun = false;
-    pthread_join( hTimerTickThread, NULL );
+    #if ( configUSE_VIRTUAL_TIME == 0 )
+    {
+        /* Stop the timer tick thread. */
+        xTimerTickThreadShouldRun = false;
+        pthread_join( hTimerTickThread, NULL );
+    }
+    #endif
+
+    #if ( portTICKLESS_IDLE == 1 )
+    {
+        event_delete( pxTickResumeEvent );
+        pxTickResumeEvent = NULL;
+    }
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    {
+        struct itimerspec xTimerSpec = { { 0, 0 }, { 0, 1 } };
+
+        /* Stop the high resolution timer thread, expiring the timerfd so
+         * the thread is not left blocked reading it. */
+        xHRTimerThreadShouldRun = false;
+        ( void ) timerfd_settime( iHRTimerFd, 0, &xTimerSpec, NULL );
+        pthread_join( hHRTimerThread, NULL );
+        close( iHRTimerFd );
+        iHRTimerFd = -1;
+    }
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
+    #if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    {
+        const uint64_t ullWake = 1;
+
+        /* Stop the interrupt thread, waking it from epoll_wait().  Installed
+         * handlers are kept for when the scheduler is restarted. */
+        xInterruptThreadShouldRun = false;
+        ( void ) write( iInterruptEventFd, &ullWake, sizeof( ullWake ) );
+        pthread_join( hInterruptThread, NULL );
+    }
+    #endif
 
     /* Signal the scheduler to exit its loop. */
-    xSchedulerEnd = pdTRUE;
+    __atomic_store_n( &xSchedulerEnd, pdTRUE, __ATOMIC_SEQ_CST );
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        const BaseType_t xThisCoreID = xPortGetCoreID();
+        BaseType_t xCoreID;
+        BaseType_t xAllParked = pdFALSE;
+
+        /* The other cores are still running kernel code, so signal each of
+         * them until it has parked its thread.  A core can switch threads
+         * before the signal is delivered, so the signal is sent again to the
+         * thread the core is now running. */
+        while( xAllParked == pdFALSE )
+        {
+            xAllParked = pdTRUE;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                if( ( xCoreID != xThisCoreID ) &&
+                    ( __atomic_load_n( &( xCoreParked[ xCoreID ] ), __ATOMIC_ACQUIRE ) == pdFALSE ) )
+                {
+                    xAllParked = pdFALSE;
+                    ( void ) pthread_kill( __atomic_load_n( &( hCoreThreads[ xCoreID ] ), __ATOMIC_ACQUIRE ), SIG_YIELD_CORE );
+                }
+            }
+
+            if( xAllParked == pdFALSE )
+            {
+                ( void ) sched_yield();
+            }
+        }
+    }
+    #endif /* configNUMBER_OF_CORES > 1 */
+
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
     /* Waiting to be deleted here. */
@@ -291,6 +581,8 @@ void vPortEndScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vPortEnterCritical( void )
 {
     if( uxCriticalNesting == 0 )
@@ -314,6 +606,8 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configNUMBER_OF_CORES == 1 */
+
 static void prvPortYieldFromISR( void )
 {
     Thread_t * xThreadToSuspend;
@@ -321,9 +615,35 @@ static void prvPortYieldFromISR( void )
 
     xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    vTaskSwitchContext();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vTaskSwitchContext();
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    }
+    #else
+    {
+        /* Once vTaskSwitchContext() returns, the task being switched out can
+         * be selected by, and its thread's core changed by, another core, so
+         * the core must be read first. */
+        const BaseType_t xCoreID = xPortGetCoreID();
+
+        if( __atomic_load_n( &xSchedulerEnd, __ATOMIC_SEQ_CST ) == pdTRUE )
+        {
+            prvParkCore();
+        }
+
+        vTaskSwitchContext( xCoreID );
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
 
-    xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        if( xThreadToResume != xThreadToSuspend )
+        {
+            xThreadToResume->xCoreID = xCoreID;
+            __atomic_store_n( &( hCoreThreads[ xCoreID ] ), xThreadToResume->pthread, __ATOMIC_RELEASE );
+        }
+    }
+    #endif
 
     prvSwitchThread( xThreadToResume, xThreadToSuspend );
 }
@@ -331,163 +651,1022 @@ static void prvPortYieldFromISR( void )
 
 void vPortYield( void )
 {
-    vPortEnterCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
 
-    prvPortYieldFromISR();
+        prvPortYieldFromISR();
 
-    vPortExitCritical();
+        vPortExitCritical();
+    }
+    #else
+    {
+        UBaseType_t uxSavedInterruptStatus = xPortSetInterruptMask();
+
+        prvPortYieldFromISR();
+
+        vPortClearInterruptMask( uxSavedInterruptStatus );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
-void vPortDisableInterrupts( void )
+#if ( configNUMBER_OF_CORES > 1 )
+
+BaseType_t xPortGetCoreID( void )
 {
-    pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+    BaseType_t xCoreID = 0;
+
+    /* Threads that are not running a task, such as the scheduler thread, are
+     * treated as core 0. */
+    if( pxThisThread != NULL )
+    {
+        xCoreID = pxThisThread->xCoreID;
+    }
+
+    return xCoreID;
 }
 /*-----------------------------------------------------------*/
 
-void vPortEnableInterrupts( void )
+void vPortYieldCore( BaseType_t xCoreID )
 {
-    pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+    Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+    /* The task can be switched out before the signal is delivered.  The signal
+     * then stays pending on its thread, and causes a harmless extra yield of
+     * whichever core the task is next resumed on. */
+    ( void ) pthread_kill( pxThread->pthread, SIG_YIELD_CORE );
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t xPortSetInterruptMask( void )
+void vPortRecursiveLockAcquire( BaseType_t xLockNum )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return ( UBaseType_t ) 0;
+    PortRecursiveLock_t * const pxLock = &( xPortLocks[ xLockNum ] );
+    const BaseType_t xCoreID = xPortGetCoreID();
+    BaseType_t xFree;
+
+    /* Only this core can set the owner to this core, so this core owns the
+     * lock if it is seen as the owner. */
+    if( __atomic_load_n( &( pxLock->xOwnerCoreID ), __ATOMIC_ACQUIRE ) == xCoreID )
+    {
+        pxLock->uxCount++;
+    }
+    else
+    {
+        for( ; ; )
+        {
+            xFree = -1;
+
+            if( __atomic_compare_exchange_n( &( pxLock->xOwnerCoreID ), &xFree, xCoreID,
+                                             false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+            {
+                break;
+            }
+
+            /* The owner can have been parked by vPortEndScheduler() while
+             * holding the lock, in which case this core must park too. */
+            if( __atomic_load_n( &xSchedulerEnd, __ATOMIC_SEQ_CST ) == pdTRUE )
+            {
+                prvParkCore();
+            }
+
+            /* The owner can be sharing a host CPU with this thread. */
+            ( void ) sched_yield();
+        }
+
+        pxLock->uxCount = 1;
+    }
 }
 /*-----------------------------------------------------------*/
 
-void vPortClearInterruptMask( UBaseType_t uxMask )
+void vPortRecursiveLockRelease( BaseType_t xLockNum )
 {
-    ( void ) uxMask;
+    PortRecursiveLock_t * const pxLock = &( xPortLocks[ xLockNum ] );
+
+    configASSERT( pxLock->xOwnerCoreID == xPortGetCoreID() );
+    configASSERT( pxLock->uxCount > 0U );
+
+    pxLock->uxCount--;
+
+    if( pxLock->uxCount == 0U )
+    {
+        __atomic_store_n( &( pxLock->xOwnerCoreID ), -1, __ATOMIC_RELEASE );
+    }
 }
 /*-----------------------------------------------------------*/
 
-static uint64_t prvGetTimeNs( void )
+static void vPortYieldCoreHandler( int sig )
 {
-    struct timespec t;
-
-    clock_gettime( CLOCK_MONOTONIC, &t );
+    ( void ) sig;
 
-    return ( uint64_t ) t.tv_sec * ( uint64_t ) 1000000000UL + ( uint64_t ) t.tv_nsec;
+    prvPortYieldFromISR();
 }
 /*-----------------------------------------------------------*/
 
-/* commented as part of the code below in vPortSystemTickHandler,
- * to adjust timing according to full demo requirements */
-/* static uint64_t prvTickCount; */
-
-static void * prvTimerTickHandler( void * arg )
+static void prvParkCore( void )
 {
-    ( void ) arg;
-    
-    prvPortSetCurrentThreadName("Scheduler timer");
-
-    while( xTimerTickThreadShouldRun )
+    /* Called with all signals blocked once vPortEndScheduler() has been
+     * called on another core.  The thread waits here to be deleted, as the
+     * thread that ended the scheduler does.  Threads that do not run a task,
+     * such as the thread that called vTaskStartScheduler(), are not parked. */
+    if( pxThisThread == NULL )
     {
-        /*
-         * signal to the active task to cause tick handling or
-         * preemption (if enabled)
-         */
-        Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-        pthread_kill( thread->pthread, SIGALRM );
-        usleep( portTICK_RATE_MICROSECONDS );
+        return;
     }
 
-    return NULL;
+    __atomic_store_n( &( xCoreParked[ pxThisThread->xCoreID ] ), pdTRUE, __ATOMIC_RELEASE );
+    event_wait( pxThisThread->ev );
+    pthread_testcancel();
 }
 /*-----------------------------------------------------------*/
 
-/*
- * Setup the systick timer to generate the tick interrupts at the required
- * frequency.
- */
-void prvSetupTimerInterrupt( void )
+static void prvPinThreadToCore( Thread_t * pxThread )
 {
-    xTimerTickThreadShouldRun = true;
-    pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
+    #ifdef __linux__
+    {
+        cpu_set_t xCpus;
 
-    prvStartTimeNs = prvGetTimeNs();
+        if( ( xPinToHostCpus != pdFALSE ) && ( pxThread->xPinnedCoreID != pxThread->xCoreID ) )
+        {
+            CPU_ZERO( &xCpus );
+            CPU_SET( iHostCpuForCore[ pxThread->xCoreID ], &xCpus );
+            ( void ) pthread_setaffinity_np( pthread_self(), sizeof( xCpus ), &xCpus );
+            pxThread->xPinnedCoreID = pxThread->xCoreID;
+        }
+    }
+    #else /* ifdef __linux__ */
+    {
+        ( void ) pxThread;
+    }
+    #endif /* ifdef __linux__ */
 }
 /*-----------------------------------------------------------*/
 
-static void vPortSystemTickHandler( int sig )
-{
-    Thread_t * pxThreadToSuspend;
-    Thread_t * pxThreadToResume;
-
-    ( void ) sig;
+    #ifdef __linux__
 
-/* uint64_t xExpectedTicks; */
+static void prvSetupHostCpus( void )
+{
+    cpu_set_t xCpus;
+    int iCpu;
+    int iCount = 0;
 
-    uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+    /* Map the simulated cores onto the host CPUs this process may run on,
+     * sharing host CPUs between cores if there are not enough of them. */
+    if( sched_getaffinity( 0, sizeof( xCpus ), &xCpus ) == 0 )
+    {
+        for( iCpu = 0; ( iCpu < CPU_SETSIZE ) && ( iCount < configNUMBER_OF_CORES ); iCpu++ )
+        {
+            if( CPU_ISSET( iCpu, &xCpus ) )
+            {
+                iHostCpuForCore[ iCount ] = iCpu;
+                iCount++;
+            }
+        }
+    }
 
-    #if ( configUSE_PREEMPTION == 1 )
-        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-    #endif
+    if( iCount > 0 )
+    {
+        for( iCpu = iCount; iCpu < configNUMBER_OF_CORES; iCpu++ )
+        {
+            iHostCpuForCore[ iCpu ] = iHostCpuForCore[ iCpu % iCount ];
+        }
 
-    /* Tick Increment, accounting for any lost signals or drift in
-     * the timer. */
+        xPinToHostCpus = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
 
-/*
- *      Comment code to adjust timing according to full demo requirements
- *      xExpectedTicks = (prvGetTimeNs() - prvStartTimeNs)
- *        / (portTICK_RATE_MICROSECONDS * 1000);
- * do { */
-    xTaskIncrementTick();
-
-/*        prvTickCount++;
- *    } while (prvTickCount < xExpectedTicks);
- */
+    #endif /* __linux__ */
 
-    #if ( configUSE_PREEMPTION == 1 )
-        /* Select Next Task. */
-        vTaskSwitchContext();
+#endif /* configNUMBER_OF_CORES > 1 */
 
-        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+void vPortDisableInterrupts( void )
+{
+    pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
 
-        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* Once the scheduler has stopped, vTaskExitCritical() leaves
+         * interrupts disabled, so this core would never take the signal
+         * vPortEndScheduler() sends to park it. */
+        if( __atomic_load_n( &xSchedulerEnd, __ATOMIC_SEQ_CST ) == pdTRUE )
+        {
+            prvParkCore();
+        }
+    }
     #endif
+}
+/*-----------------------------------------------------------*/
 
-    uxCriticalNesting--;
+void vPortEnableInterrupts( void )
+{
+    pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
 }
 /*-----------------------------------------------------------*/
 
-void vPortThreadDying( void * pxTaskToDelete,
-                       volatile BaseType_t * pxPendYield )
+UBaseType_t xPortSetInterruptMask( void )
 {
-    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+    sigset_t xPreviousSignals;
 
-    ( void ) pxPendYield;
+    /* Interrupts are always disabled inside ISRs (signals handlers), so
+     * only record whether they were already disabled. */
+    ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
 
-    pxThread->xDying = pdTRUE;
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        if( __atomic_load_n( &xSchedulerEnd, __ATOMIC_SEQ_CST ) == pdTRUE )
+        {
+            prvParkCore();
+        }
+    }
+    #endif
+
+    return ( UBaseType_t ) sigismember( &xPreviousSignals, SIGALRM );
 }
 /*-----------------------------------------------------------*/
 
-void vPortCancelThread( void * pxTaskToDelete )
+void vPortClearInterruptMask( UBaseType_t uxMask )
 {
-    Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
+    if( uxMask == 0U )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
 
-    /*
-     * The thread has already been suspended so it can be safely cancelled.
-     */
-    pthread_cancel( pxThreadToCancel->pthread );
-    event_signal( pxThreadToCancel->ev );
-    pthread_join( pxThreadToCancel->pthread, NULL );
-    event_delete( pxThreadToCancel->ev );
+static pthread_t prvGetInterruptThread( void )
+{
+    #if ( configNUMBER_OF_CORES == 1 )
+        return prvGetThreadFromTask( xTaskGetCurrentTaskHandle() )->pthread;
+    #else
+        return __atomic_load_n( &( hCoreThreads[ 0 ] ), __ATOMIC_ACQUIRE );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
-static void * prvWaitForStart( void * pvParams )
+static uint64_t prvGetTimeNs( void )
 {
-    Thread_t * pxThread = pvParams;
+    struct timespec t;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return ( uint64_t ) t.tv_sec * ( uint64_t ) 1000000000UL + ( uint64_t ) t.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 0 )
+
+static void prvSleepUntilNs( uint64_t ullTimeNs )
+{
+    #ifdef __APPLE__
+    {
+        /* There is no clock_nanosleep() on macOS, so sleep for the time
+         * remaining instead. */
+        const uint64_t ullNowNs = prvGetTimeNs();
+        struct timespec xDelay;
+
+        if( ullTimeNs > ullNowNs )
+        {
+            xDelay.tv_sec = ( time_t ) ( ( ullTimeNs - ullNowNs ) / 1000000000ULL );
+            xDelay.tv_nsec = ( long ) ( ( ullTimeNs - ullNowNs ) % 1000000000ULL );
+            ( void ) nanosleep( &xDelay, NULL );
+        }
+    }
+    #else /* ifdef __APPLE__ */
+    {
+        struct timespec xDeadline;
+
+        xDeadline.tv_sec = ( time_t ) ( ullTimeNs / 1000000000ULL );
+        xDeadline.tv_nsec = ( long ) ( ullTimeNs % 1000000000ULL );
+
+        while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xDeadline, NULL ) == EINTR )
+        {
+        }
+    }
+    #endif /* ifdef __APPLE__ */
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_VIRTUAL_TIME == 0 */
+
+/*
+ * Returns the number of tick periods that have elapsed since the last call.
+ * The tick thread can signal a thread that is already handling a tick, or
+ * that is not scheduled by the host for some time, in which case the signals
+ * are merged and more than one tick is due.
+ */
+static uint64_t prvGetTicksDue( void )
+{
+    const uint64_t ullExpectedTicks = ( prvGetTimeNs() - prvStartTimeNs ) / ( ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL );
+    uint64_t ullTicksDue = 0;
+
+    if( ullExpectedTicks > prvTickCount )
+    {
+        ullTicksDue = ullExpectedTicks - prvTickCount;
+        prvTickCount = ullExpectedTicks;
+    }
+
+    return ullTicksDue;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_VIRTUAL_TIME == 0 )
+
+static void * prvTimerTickHandler( void * arg )
+{
+    const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+    uint64_t ullNextTickNs = prvStartTimeNs;
+    uint64_t ullNowNs;
+
+    ( void ) arg;
+    
+    prvPortSetCurrentThreadName("Scheduler timer");
+
+    while( xTimerTickThreadShouldRun )
+    {
+        #if ( portTICKLESS_IDLE == 1 )
+        {
+            /* The idle task has stopped the tick.  Wait until it restarts
+             * it, then continue from the next tick boundary. */
+            if( __atomic_load_n( &xTickSuppressed, __ATOMIC_ACQUIRE ) )
+            {
+                event_wait( pxTickResumeEvent );
+            }
+            else
+            {
+                pthread_kill( prvGetInterruptThread(), SIGALRM );
+            }
+        }
+        #else /* if ( portTICKLESS_IDLE == 1 ) */
+        {
+            /*
+             * signal to the active task to cause tick handling or
+             * preemption (if enabled)
+             */
+            pthread_kill( prvGetInterruptThread(), SIGALRM );
+        }
+        #endif /* if ( portTICKLESS_IDLE == 1 ) */
+
+        /* Sleep until the next tick is due.  The deadline is absolute so time
+         * spent signalling or waiting for the host to run this thread does not
+         * delay later ticks.  If this thread has fallen more than a tick
+         * behind, skip to the next tick boundary rather than sending a burst of
+         * signals, as the tick handler counts the ticks that were missed. */
+        ullNextTickNs += ullTickPeriodNs;
+        ullNowNs = prvGetTimeNs();
+
+        if( ullNextTickNs < ullNowNs )
+        {
+            ullNextTickNs = ullNowNs - ( ( ullNowNs - prvStartTimeNs ) % ullTickPeriodNs ) + ullTickPeriodNs;
+        }
+
+        prvSleepUntilNs( ullNextTickNs );
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_VIRTUAL_TIME == 0 */
+
+/*
+ * Setup the systick timer to generate the tick interrupts at the required
+ * frequency.
+ */
+void prvSetupTimerInterrupt( void )
+{
+    prvStartTimeNs = prvGetTimeNs();
+    prvTickCount = 0;
+
+    #if ( portTICKLESS_IDLE == 1 )
+    {
+        xTickSuppressed = false;
+        pxTickResumeEvent = event_create();
+    }
+    #endif
+
+    #if ( configUSE_VIRTUAL_TIME == 0 )
+    {
+        xTimerTickThreadShouldRun = true;
+        pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
+    }
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    {
+        prvHRTimerCreate();
+        xHRTimerThreadShouldRun = true;
+        pthread_create( &hHRTimerThread, NULL, prvHRTimerHandler, NULL );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#ifdef __linux__
+
+/* The count is also used by the trace recorder, so is available even when
+ * high resolution timers are not used. */
+uint64_t ullPortHRTimerGetCount( void )
+{
+    return prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* __linux__ */
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+static void prvHRTimerCreate( void )
+{
+    if( iHRTimerFd < 0 )
+    {
+        iHRTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+
+        if( iHRTimerFd < 0 )
+        {
+            prvFatalError( "timerfd_create", errno );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortHRTimerSetCompare( uint64_t ullCount )
+{
+    struct itimerspec xTimerSpec;
+
+    /* High resolution timers can be started before the scheduler. */
+    prvHRTimerCreate();
+
+    /* An absolute time of zero would disarm the timerfd instead.  A time that
+     * has already passed expires the timerfd immediately, as required. */
+    if( ullCount == 0 )
+    {
+        ullCount = 1;
+    }
+
+    xTimerSpec.it_interval.tv_sec = 0;
+    xTimerSpec.it_interval.tv_nsec = 0;
+    xTimerSpec.it_value.tv_sec = ( time_t ) ( ullCount / 1000000000ULL );
+    xTimerSpec.it_value.tv_nsec = ( long ) ( ullCount % 1000000000ULL );
+
+    ( void ) timerfd_settime( iHRTimerFd, TFD_TIMER_ABSTIME, &xTimerSpec, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortHRTimerCancelCompare( void )
+{
+    struct itimerspec xTimerSpec = { { 0, 0 }, { 0, 0 } };
+
+    prvHRTimerCreate();
+    ( void ) timerfd_settime( iHRTimerFd, 0, &xTimerSpec, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvHRTimerHandler( void * arg )
+{
+    uint64_t ullExpirations;
+    const struct timespec xRetryDelay = { 0, 20000 };
+
+    ( void ) arg;
+
+    prvPortSetCurrentThreadName( "HR timer" );
+
+    while( xHRTimerThreadShouldRun )
+    {
+        if( read( iHRTimerFd, &ullExpirations, sizeof( ullExpirations ) ) == ( ssize_t ) sizeof( ullExpirations ) )
+        {
+            /*
+             * Raise the compare interrupt on the thread of the running task.
+             * The task can be switched out before the signal is delivered, in
+             * which case the signal stays pending on a suspended thread, so
+             * keep raising it until the handler has run.
+             */
+            xHRTimerInterruptPending = 1;
+
+            while( ( xHRTimerInterruptPending != 0 ) && xHRTimerThreadShouldRun )
+            {
+                pthread_kill( prvGetInterruptThread(), SIG_HR_TIMER );
+                ( void ) nanosleep( &xRetryDelay, NULL );
+            }
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void vPortHRTimerInterruptHandler( int sig )
+{
+    ( void ) sig;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+    #endif
+
+    xHRTimerInterruptPending = 0;
+
+    if( xHRTimerInterruptHandler() != pdFALSE )
+    {
+        prvPortYieldFromISR();
+    }
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting--;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+
+static void prvInterruptsCreate( void )
+{
+    struct epoll_event xEvent;
+    UBaseType_t uxInterruptNumber;
+
+    for( uxInterruptNumber = 0; uxInterruptNumber < portMAX_INTERRUPTS; uxInterruptNumber++ )
+    {
+        xInterrupts[ uxInterruptNumber ].pxHandler = NULL;
+        xInterrupts[ uxInterruptNumber ].iFd = -1;
+    }
+
+    iInterruptEpollFd = epoll_create1( EPOLL_CLOEXEC );
+
+    if( iInterruptEpollFd < 0 )
+    {
+        prvFatalError( "epoll_create1", errno );
+    }
+
+    iInterruptEventFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+    if( iInterruptEventFd < 0 )
+    {
+        prvFatalError( "eventfd", errno );
+    }
+
+    xEvent.events = EPOLLIN;
+    xEvent.data.u32 = portINTERRUPT_WAKE_ID;
+
+    if( epoll_ctl( iInterruptEpollFd, EPOLL_CTL_ADD, iInterruptEventFd, &xEvent ) != 0 )
+    {
+        prvFatalError( "epoll_ctl", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortInstallInterruptHandler( UBaseType_t uxInterruptNumber,
+                                         int iFd,
+                                         PortInterruptHandler_t pxHandler,
+                                         void * pvParameter )
+{
+    struct epoll_event xEvent;
+    PortInterruptHandler_t pxNoHandler = NULL;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pxHandler != NULL );
+
+    ( void ) pthread_once( &hInterruptsCreated, prvInterruptsCreate );
+
+    if( uxInterruptNumber < portMAX_INTERRUPTS )
+    {
+        /* The handler is installed with a compare and exchange so two callers
+         * cannot both install a handler for the same interrupt number, and
+         * interrupts are masked so the handler is not dispatched before its
+         * parameter is written. */
+        portENTER_CRITICAL();
+        {
+            if( __atomic_compare_exchange_n( &( xInterrupts[ uxInterruptNumber ].pxHandler ), &pxNoHandler, pxHandler,
+                                             false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+            {
+                xInterrupts[ uxInterruptNumber ].pvParameter = pvParameter;
+                xInterrupts[ uxInterruptNumber ].iFd = iFd;
+                xReturn = pdPASS;
+            }
+        }
+        portEXIT_CRITICAL();
+    }
+
+    if( ( xReturn == pdPASS ) && ( iFd >= 0 ) )
+    {
+        /* The file descriptor is one-shot so it does not raise the
+         * interrupt again until the handler has run, and the handler
+         * has had the chance to read it. */
+        xEvent.events = EPOLLIN | EPOLLONESHOT;
+        xEvent.data.u32 = ( uint32_t ) uxInterruptNumber;
+
+        if( epoll_ctl( iInterruptEpollFd, EPOLL_CTL_ADD, iFd, &xEvent ) != 0 )
+        {
+            vPortRemoveInterruptHandler( uxInterruptNumber );
+            xReturn = pdFAIL;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortRemoveInterruptHandler( UBaseType_t uxInterruptNumber )
+{
+    configASSERT( uxInterruptNumber < portMAX_INTERRUPTS );
+
+    ( void ) pthread_once( &hInterruptsCreated, prvInterruptsCreate );
+
+    /* Mask interrupts so the handler cannot be removed while it is being
+     * dispatched. */
+    portENTER_CRITICAL();
+    {
+        if( xInterrupts[ uxInterruptNumber ].iFd >= 0 )
+        {
+            ( void ) epoll_ctl( iInterruptEpollFd, EPOLL_CTL_DEL, xInterrupts[ uxInterruptNumber ].iFd, NULL );
+            xInterrupts[ uxInterruptNumber ].iFd = -1;
+        }
+
+        __atomic_store_n( &( xInterrupts[ uxInterruptNumber ].pxHandler ), NULL, __ATOMIC_RELEASE );
+        ( void ) __atomic_fetch_and( &ulPendingInterrupts, ~( 1U << uxInterruptNumber ), __ATOMIC_ACQ_REL );
+    }
+    portEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPortRaiseInterrupt( UBaseType_t uxInterruptNumber )
+{
+    const uint64_t ullWake = 1;
+
+    configASSERT( uxInterruptNumber < portMAX_INTERRUPTS );
+
+    ( void ) pthread_once( &hInterruptsCreated, prvInterruptsCreate );
+
+    ( void ) __atomic_fetch_or( &ulPendingInterrupts, 1U << uxInterruptNumber, __ATOMIC_ACQ_REL );
+    ( void ) write( iInterruptEventFd, &ullWake, sizeof( ullWake ) );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvInterruptThread( void * arg )
+{
+    struct epoll_event xEvents[ 8 ];
+    const struct timespec xRetryDelay = { 0, 20000 };
+    uint64_t ullValue;
+    int iEvent;
+    int iEvents;
+
+    ( void ) arg;
+
+    prvPortSetCurrentThreadName( "Interrupts" );
+
+    while( xInterruptThreadShouldRun )
+    {
+        iEvents = epoll_wait( iInterruptEpollFd, xEvents, ( int ) ( sizeof( xEvents ) / sizeof( xEvents[ 0 ] ) ), -1 );
+
+        for( iEvent = 0; iEvent < iEvents; iEvent++ )
+        {
+            if( xEvents[ iEvent ].data.u32 == portINTERRUPT_WAKE_ID )
+            {
+                /* Raised by software, the pending bits are already set. */
+                ( void ) read( iInterruptEventFd, &ullValue, sizeof( ullValue ) );
+            }
+            else
+            {
+                ( void ) __atomic_fetch_or( &ulPendingInterrupts, 1U << xEvents[ iEvent ].data.u32, __ATOMIC_ACQ_REL );
+            }
+        }
+
+        /*
+         * Raise the interrupts on the thread of the task running on core 0,
+         * keeping on raising them until the handler has run, in the same way
+         * as the high resolution timer thread.
+         */
+        while( ( __atomic_load_n( &ulPendingInterrupts, __ATOMIC_ACQUIRE ) != 0 ) && xInterruptThreadShouldRun )
+        {
+            pthread_kill( prvGetInterruptThread(), SIG_INTERRUPT );
+            ( void ) nanosleep( &xRetryDelay, NULL );
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void vPortInterruptHandler( int sig )
+{
+    struct epoll_event xEvent;
+    PortInterruptHandler_t pxHandler;
+    void * pvParameter;
+    int iFd;
+    UBaseType_t uxSavedInterruptStatus;
+    UBaseType_t uxInterruptNumber;
+    uint32_t ulPending;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    ( void ) sig;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+    #endif
+
+    ulPending = __atomic_exchange_n( &ulPendingInterrupts, 0, __ATOMIC_ACQ_REL );
+
+    /* Lower interrupt numbers have the higher priority, so are run first.
+     * Handlers do not nest, as all signals are blocked. */
+    for( uxInterruptNumber = 0; ulPending != 0; uxInterruptNumber++, ulPending >>= 1 )
+    {
+        if( ( ulPending & 1U ) != 0 )
+        {
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                pxHandler = xInterrupts[ uxInterruptNumber ].pxHandler;
+                pvParameter = xInterrupts[ uxInterruptNumber ].pvParameter;
+                iFd = xInterrupts[ uxInterruptNumber ].iFd;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( pxHandler != NULL )
+            {
+                pxHandler( pvParameter, &xHigherPriorityTaskWoken );
+
+                if( iFd >= 0 )
+                {
+                    /* Re-arm the file descriptor, which raises the interrupt
+                     * again if the handler did not read all the data. */
+                    xEvent.events = EPOLLIN | EPOLLONESHOT;
+                    xEvent.data.u32 = ( uint32_t ) uxInterruptNumber;
+                    ( void ) epoll_ctl( iInterruptEpollFd, EPOLL_CTL_MOD, iFd, &xEvent );
+                }
+            }
+        }
+    }
+
+    if( xHigherPriorityTaskWoken != pdFALSE )
+    {
+        prvPortYieldFromISR();
+    }
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting--;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_SIMULATED_INTERRUPTS */
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+static void vPortSystemTickHandler( int sig )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+    uint64_t ullTicksDue;
+
+    ( void ) sig;
+
+    uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+    #if ( configUSE_PREEMPTION == 1 )
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #endif
+
+    /* Tick Increment, accounting for any lost signals or drift in
+     * the timer.  xTaskIncrementTick() holds the ticks back in the
+     * pended tick count if the scheduler is suspended. */
+    for( ullTicksDue = prvGetTicksDue(); ullTicksDue > 0; ullTicksDue-- )
+    {
+        xTaskIncrementTick();
+    }
+
+    #if ( configUSE_PREEMPTION == 1 )
+        /* Select Next Task. */
+        vTaskSwitchContext();
+
+        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    #endif
+
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+static void vPortSystemTickHandler( int sig )
+{
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xSwitchRequired = pdFALSE;
+    uint64_t ullTicksDue;
+
+    ( void ) sig;
+
+    /* The tick interrupt is taken by core 0, and switches task only if
+     * the tick unblocked a task that should run on core 0.  A pending tick
+     * can be taken by a thread that has since moved to another core, so
+     * the ticks due are counted inside the critical section. */
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        for( ullTicksDue = prvGetTicksDue(); ullTicksDue > 0; ullTicksDue-- )
+        {
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xSwitchRequired != pdFALSE )
+    {
+        prvPortYieldFromISR();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+#if ( portTICKLESS_IDLE == 1 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+    eSleepModeStatus eSleepStatus;
+    uint64_t ullSleepUntilNs;
+    uint64_t ullNowNs;
+    uint64_t ullTicksElapsed;
+    struct timespec xTimeout;
+    int iSignal;
+
+    /* Stop interrupts (signals) being handled.  A signal raised while
+     * sleeping ends the sleep, and is raised again once the tick count has
+     * been corrected. */
+    vPortEnterCritical();
+
+    eSleepStatus = eTaskConfirmSleepModeStatus();
+
+    if( eSleepStatus == eAbortSleep )
+    {
+        vPortExitCritical();
+        return;
+    }
+
+    /* Stop the tick.  A tick signal sent before the tick thread saw this is
+     * ignored below, as the tick count is corrected from the host clock. */
+    __atomic_store_n( &xTickSuppressed, true, __ATOMIC_RELEASE );
+
+    /* Limit the sleep so the deadline cannot overflow when TickType_t is 64
+     * bits wide. */
+    if( xExpectedIdleTime > ( TickType_t ) UINT32_MAX )
+    {
+        xExpectedIdleTime = ( TickType_t ) UINT32_MAX;
+    }
+
+    ullSleepUntilNs = prvStartTimeNs + ( ( prvTickCount + ( uint64_t ) xExpectedIdleTime ) * ullTickPeriodNs );
+
+    do
+    {
+        if( eSleepStatus == eNoTasksWaitingTimeout )
+        {
+            /* Only an interrupt can make a task ready. */
+            iSignal = sigwaitinfo( &xAllSignals, NULL );
+        }
+        else
+        {
+            ullNowNs = prvGetTimeNs();
+
+            if( ullNowNs >= ullSleepUntilNs )
+            {
+                iSignal = 0;
+                break;
+            }
+
+            xTimeout.tv_sec = ( time_t ) ( ( ullSleepUntilNs - ullNowNs ) / 1000000000ULL );
+            xTimeout.tv_nsec = ( long ) ( ( ullSleepUntilNs - ullNowNs ) % 1000000000ULL );
+            iSignal = sigtimedwait( &xAllSignals, NULL, &xTimeout );
+
+            if( ( iSignal == -1 ) && ( errno == EAGAIN ) )
+            {
+                /* Slept until the next task unblock time. */
+                iSignal = 0;
+            }
+        }
+    } while( ( iSignal == SIGALRM ) || ( ( iSignal == -1 ) && ( errno == EINTR ) ) );
+
+    /* Restart the tick. */
+    __atomic_store_n( &xTickSuppressed, false, __ATOMIC_RELEASE );
+    event_signal( pxTickResumeEvent );
+
+    /* Step the tick count over the complete tick periods slept.  Ticks
+     * beyond the expected idle time are left for the tick interrupt, which
+     * announces every tick period not yet counted. */
+    ullTicksElapsed = ( ( prvGetTimeNs() - prvStartTimeNs ) / ullTickPeriodNs );
+    ullTicksElapsed = ( ullTicksElapsed > prvTickCount ) ? ( ullTicksElapsed - prvTickCount ) : 0U;
+
+    if( ullTicksElapsed > ( uint64_t ) xExpectedIdleTime )
+    {
+        ullTicksElapsed = ( uint64_t ) xExpectedIdleTime;
+    }
+
+    prvTickCount += ullTicksElapsed;
+    vTaskStepTick( ( TickType_t ) ullTicksElapsed );
+
+    /* Raise the interrupt that ended the sleep again, so it is handled when
+     * interrupts are enabled. */
+    if( iSignal > 0 )
+    {
+        ( void ) pthread_kill( pthread_self(), iSignal );
+    }
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* portTICKLESS_IDLE == 1 */
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+    int iSignal;
+
+    /* Called with the scheduler suspended when every task is blocked.  No
+     * time passes while the system is idle, so jump straight to the next
+     * task unblock time. */
+    vPortEnterCritical();
+
+    switch( eTaskConfirmSleepModeStatus() )
+    {
+        case eAbortSleep:
+            break;
+
+        case eNoTasksWaitingTimeout:
+
+            /* Only an interrupt can make a task ready, so wait for one without
+             * advancing the time, then raise it again so it is handled when
+             * interrupts are enabled. */
+            do
+            {
+                iSignal = sigwaitinfo( &xAllSignals, NULL );
+            } while( ( iSignal == -1 ) && ( errno == EINTR ) );
+
+            ( void ) pthread_kill( pthread_self(), iSignal );
+            break;
+
+        default:
+            vTaskStepTick( xExpectedIdleTime );
+            break;
+    }
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortIdleTaskHook( void )
+{
+    /* The idle task only runs when no other task can, so the next tick can be
+     * announced now.  This also moves time on when the next task unblock time
+     * is too close for the idle task to call vPortSuppressTicksAndSleep(). */
+    ( void ) xTaskCatchUpTicks( 1 );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_VIRTUAL_TIME == 1 */
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    ( void ) pxPendYield;
+
+    pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    Thread_t * pxThreadToCancel = prvGetThreadFromTask( pxTaskToDelete );
+
+    /*
+     * The thread has already been suspended so it can be safely cancelled.
+     */
+    pthread_cancel( pxThreadToCancel->pthread );
+    event_signal( pxThreadToCancel->ev );
+    pthread_join( pxThreadToCancel->pthread, NULL );
+    event_delete( pxThreadToCancel->ev );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvWaitForStart( void * pvParams )
+{
+    Thread_t * pxThread = pvParams;
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        pxThisThread = pxThread;
+    #endif
 
     prvSuspendSelf( pxThread );
 
     /* Resumed for the first time, unblocks all signals. */
-    uxCriticalNesting = 0;
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting = 0;
+    #endif
     vPortEnableInterrupts();
 
     /* Set thread name */
@@ -510,7 +1689,9 @@ static void * prvWaitForStart( void * pvParams )
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
-    BaseType_t uxSavedCriticalNesting;
+    #if ( configNUMBER_OF_CORES == 1 )
+        BaseType_t uxSavedCriticalNesting;
+    #endif
 
     if( pxThreadToSuspend != pxThreadToResume )
     {
@@ -519,9 +1700,12 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          *
          * The critical section nesting is per-task, so save it on the
          * stack of the current (suspending thread), restoring it when
-         * we switch back to this task.
+         * we switch back to this task.  With multiple cores the nesting
+         * is held in the TCB instead.
          */
-        uxSavedCriticalNesting = uxCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxSavedCriticalNesting = uxCriticalNesting;
+        #endif
 
         prvResumeThread( pxThreadToResume );
 
@@ -532,7 +1716,9 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
 
         prvSuspendSelf( pxThreadToSuspend );
 
-        uxCriticalNesting = uxSavedCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxCriticalNesting = uxSavedCriticalNesting;
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -554,6 +1740,10 @@ static void prvSuspendSelf( Thread_t * thread )
      */
     event_wait( thread->ev );
     pthread_testcancel();
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        prvPinThreadToCore( thread );
+    #endif
 }
 
 /*-----------------------------------------------------------*/
@@ -602,6 +1792,57 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    {
+        struct sigaction sighrtimer;
+
+        sighrtimer.sa_flags = 0;
+        sighrtimer.sa_handler = vPortHRTimerInterruptHandler;
+        sigfillset( &sighrtimer.sa_mask );
+
+        iRet = sigaction( SIG_HR_TIMER, &sighrtimer, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
+    #if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    {
+        struct sigaction siginterrupt;
+
+        siginterrupt.sa_flags = 0;
+        siginterrupt.sa_handler = vPortInterruptHandler;
+        sigfillset( &siginterrupt.sa_mask );
+
+        iRet = sigaction( SIG_INTERRUPT, &siginterrupt, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configUSE_SIMULATED_INTERRUPTS */
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = vPortYieldCoreHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD_CORE, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES > 1 */
 }
 /*-----------------------------------------------------------*/
 
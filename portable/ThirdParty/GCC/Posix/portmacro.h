@@ -83,13 +83,22 @@ extern void vPortYield( void );
 
 #define portYIELD()                vPortYield()
 
+/* With multiple cores an ISR can be running inside a critical section, so a
+ * yield from an ISR is raised as an interrupt on the current core instead, and
+ * taken once the ISR has returned. */
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portREQUEST_YIELD_FROM_ISR()    vPortYield()
+#else
+    #define portREQUEST_YIELD_FROM_ISR()    vPortYieldCore( portGET_CORE_ID() )
+#endif
+
 #define portEND_SWITCHING_ISR( xSwitchRequired ) \
     do                                           \
     {                                            \
         if( xSwitchRequired != pdFALSE )         \
         {                                        \
             traceISR_EXIT_TO_SCHEDULER();        \
-            vPortYield();                        \
+            portREQUEST_YIELD_FROM_ISR();        \
         }                                        \
         else                                     \
         {                                        \
@@ -102,23 +111,65 @@ extern void vPortYield( void );
 /* Critical section management. */
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
-#define portSET_INTERRUPT_MASK()      ( vPortDisableInterrupts() )
-#define portCLEAR_INTERRUPT_MASK()    ( vPortEnableInterrupts() )
 
 extern UBaseType_t xPortSetInterruptMask( void );
 extern void vPortClearInterruptMask( UBaseType_t xMask );
 
-extern void vPortEnterCritical( void );
-extern void vPortExitCritical( void );
 #define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
-#define portDISABLE_INTERRUPTS()                  portSET_INTERRUPT_MASK()
-#define portENABLE_INTERRUPTS()                   portCLEAR_INTERRUPT_MASK()
-#define portENTER_CRITICAL()                      vPortEnterCritical()
-#define portEXIT_CRITICAL()                       vPortExitCritical()
+#define portDISABLE_INTERRUPTS()                  vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
+
+#if ( configNUMBER_OF_CORES == 1 )
+    extern void vPortEnterCritical( void );
+    extern void vPortExitCritical( void );
+    #define portSET_INTERRUPT_MASK()      ( vPortDisableInterrupts() )
+    #define portCLEAR_INTERRUPT_MASK()    ( vPortEnableInterrupts() )
+    #define portENTER_CRITICAL()          vPortEnterCritical()
+    #define portEXIT_CRITICAL()           vPortExitCritical()
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+/* Each simulated core is the host thread of the task it is running, so the
+ * critical nesting count is kept in the TCB and follows the task from thread to
+ * thread. */
+    #define portCRITICAL_NESTING_IN_TCB    1
+
+    extern void vTaskEnterCritical( void );
+    extern void vTaskExitCritical( void );
+    extern UBaseType_t vTaskEnterCriticalFromISR( void );
+    extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+    #define portSET_INTERRUPT_MASK()                  xPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK( x )             vPortClearInterruptMask( x )
+    #define portENTER_CRITICAL()                      vTaskEnterCritical()
+    #define portEXIT_CRITICAL()                       vTaskExitCritical()
+    #define portENTER_CRITICAL_FROM_ISR()             vTaskEnterCriticalFromISR()
+    #define portEXIT_CRITICAL_FROM_ISR( x )           vTaskExitCriticalFromISR( x )
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Multi-core support.  The core a task is running on is recorded in the task's
+ * thread, a yield is requested by signalling the thread running on the target
+ * core, and the task and ISR locks are recursive spin locks owned by a core. */
+    #define portTASK_LOCK    0
+    #define portISR_LOCK     1
+
+    extern BaseType_t xPortGetCoreID( void );
+    extern void vPortYieldCore( BaseType_t xCoreID );
+    extern void vPortRecursiveLockAcquire( BaseType_t xLockNum );
+    extern void vPortRecursiveLockRelease( BaseType_t xLockNum );
+
+    #define portGET_CORE_ID()              xPortGetCoreID()
+    #define portYIELD_CORE( xCoreID )      vPortYieldCore( xCoreID )
+    #define portGET_TASK_LOCK()            vPortRecursiveLockAcquire( portTASK_LOCK )
+    #define portRELEASE_TASK_LOCK()        vPortRecursiveLockRelease( portTASK_LOCK )
+    #define portGET_ISR_LOCK()             vPortRecursiveLockAcquire( portISR_LOCK )
+    #define portRELEASE_ISR_LOCK()         vPortRecursiveLockRelease( portISR_LOCK )
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
 extern void vPortThreadDying( void * pxTaskToDelete,
                               volatile BaseType_t * pxPendYield );
 extern void vPortCancelThread( void * pxTaskToDelete );
@@ -136,14 +187,97 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  * which also imply a full memory barrier.
  *
  * Thus, only a compilier barrier is needed to prevent the compiler
- * reordering.
+ * reordering on a single core.  With multiple cores, tasks on different
+ * cores run concurrently on different host threads, so a full hardware
+ * barrier is required.
  */
-#define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portMEMORY_BARRIER()                    __asm volatile ( "" ::: "memory" )
+#else
+    #define portMEMORY_BARRIER()                    __sync_synchronize()
+#endif
+
+/* Tickless idle.  The idle task sleeps until the next task unblock time, or
+ * until an interrupt (signal) is raised, so is only available on Linux, where
+ * a thread can wait for a signal with a timeout, and on a single core. */
+#if defined( __linux__ ) && ( configNUMBER_OF_CORES == 1 )
+    #ifndef portSUPPRESS_TICKS_AND_SLEEP
+        extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+        #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vPortSuppressTicksAndSleep( xExpectedIdleTime )
+    #endif
+#endif
+
+/* Virtual time.  Set configUSE_VIRTUAL_TIME to 1 in FreeRTOSConfig.h to
+ * generate the tick from a virtual clock instead of the host clock, which
+ * makes scheduling deterministic and long timeouts complete immediately.
+ * Time only moves on when the idle task runs: when every task is blocked the
+ * tick count jumps straight to the next task unblock time.  A task that never
+ * blocks therefore stops time, and equal priority tasks are not time sliced.
+ * Requires configUSE_TICKLESS_IDLE to be 1, and is only available on a single
+ * core on Linux. */
+#ifndef configUSE_VIRTUAL_TIME
+    #define configUSE_VIRTUAL_TIME    0
+#endif
+
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    extern void vPortIdleTaskHook( void );
+    #define portIDLE_TASK_HOOK()    vPortIdleTaskHook()
+#endif
 
 extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
 
+/* High resolution timer.  The count is CLOCK_MONOTONIC in nanoseconds, and the
+ * compare is implemented with a timerfd, so is only available on Linux. */
+#ifdef __linux__
+    extern uint64_t ullPortHRTimerGetCount( void );
+    extern void vPortHRTimerSetCompare( uint64_t ullCount );
+    extern void vPortHRTimerCancelCompare( void );
+    #define portHR_TIMER_COUNT_TYPE                 uint64_t
+    #define portHR_TIMER_COUNTS_PER_SECOND          ( 1000000000ULL )
+    #define portHR_TIMER_GET_COUNT()                ullPortHRTimerGetCount()
+    #define portHR_TIMER_SET_COMPARE( xCount )      vPortHRTimerSetCompare( xCount )
+    #define portHR_TIMER_CANCEL_COMPARE()           vPortHRTimerCancelCompare()
+#endif /* __linux__ */
+
+/* Simulated interrupts.  Set configUSE_SIMULATED_INTERRUPTS to 1 in
+ * FreeRTOSConfig.h to use them.  Only available on Linux as they are raised by
+ * a host thread waiting in epoll, which signals core 0 with SIGIO, so the
+ * application must not use SIGIO itself.
+ *
+ * xPortInstallInterruptHandler() installs pxHandler for interrupt number
+ * uxInterruptNumber, which must be less than portMAX_INTERRUPTS and not already
+ * have a handler.  If iFd is not -1 the interrupt is raised whenever the host
+ * file descriptor iFd (a socket, pipe, eventfd, etc.) is readable, and the
+ * handler must read it.  Any interrupt can also be raised with
+ * vPortRaiseInterrupt(), which can be called from tasks, ISRs or host threads.
+ * Returns pdPASS if the handler was installed.
+ *
+ * Handlers run on core 0 in interrupt context with all interrupts masked, so
+ * can only use the FromISR API functions.  Pending interrupts are run lowest
+ * number first.  A handler must set *pxHigherPriorityTaskWoken to pdTRUE, but
+ * not call portYIELD_FROM_ISR(), if it unblocks a task that has a higher
+ * priority than the running task - the port yields after the handlers have
+ * run. */
+#ifndef configUSE_SIMULATED_INTERRUPTS
+    #define configUSE_SIMULATED_INTERRUPTS    0
+#endif
+
+#if ( configUSE_SIMULATED_INTERRUPTS == 1 )
+    #define portMAX_INTERRUPTS    ( 32U )
+
+    typedef void ( * PortInterruptHandler_t )( void * pvParameter,
+                                               BaseType_t * pxHigherPriorityTaskWoken );
+
+    extern BaseType_t xPortInstallInterruptHandler( UBaseType_t uxInterruptNumber,
+                                                    int iFd,
+                                                    PortInterruptHandler_t pxHandler,
+                                                    void * pvParameter );
+    extern void vPortRemoveInterruptHandler( UBaseType_t uxInterruptNumber );
+    extern void vPortRaiseInterrupt( UBaseType_t uxInterruptNumber );
+#endif /* configUSE_SIMULATED_INTERRUPTS */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -225,6 +225,7 @@
     #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
     #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
     #define sbFLAGS_IS_BATCHING_BUFFER         ( ( uint8_t ) 4 ) /* Set if the stream buffer was created as a batching buffer, meaning the receiver task will only unblock when the trigger level exceededs. */
+    #define sbFLAGS_IS_PING_PONG_BUFFER        ( ( uint8_t ) 8 ) /* Set if the stream buffer was created as a ping-pong buffer, meaning the storage area is two blocks of xTriggerLevelBytes that are handed between writer and reader whole. */
 
 /*-----------------------------------------------------------*/
 
@@ -256,6 +257,14 @@ typedef struct StreamBufferDef_t
  */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Hands the block the writer has just filled to the reader, provided the
+ * reader has released the other block, and returns a pointer to the block the
+ * writer should fill next.  Returns NULL, without handing anything over, if
+ * the reader still holds the other block.  Only valid for ping-pong buffers.
+ */
+static void * prvSwapPingPongBlock( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
 /*
  * Add xCount bytes from pucData into the pxStreamBuffer's data storage area.
  * This function does not update the buffer's xHead pointer, so multiple writes
@@ -355,6 +364,14 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             ucFlags = sbFLAGS_IS_BATCHING_BUFFER;
             configASSERT( xBufferSizeBytes > 0 );
         }
+        else if( xStreamBufferType == sbTYPE_STREAM_PING_PONG_BUFFER )
+        {
+            /* Is a ping-pong buffer but not statically allocated.  The storage
+             * area must hold exactly two blocks of xTriggerLevelBytes. */
+            ucFlags = sbFLAGS_IS_PING_PONG_BUFFER;
+            configASSERT( xTriggerLevelBytes > 0 );
+            configASSERT( xBufferSizeBytes == ( xTriggerLevelBytes * ( size_t ) 2 ) );
+        }
         else
         {
             /* Not a message buffer and not statically allocated. */
@@ -378,10 +395,19 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
          * incremented so the free space is returned as the user would expect -
          * this is a quirk of the implementation that means otherwise the free
          * space would be reported as one byte smaller than would be logically
-         * expected. */
+         * expected.  Ping-pong buffers never report free space that way and
+         * must keep their two blocks the same size, so are not incremented. */
         if( xBufferSizeBytes < ( xBufferSizeBytes + 1U + sizeof( StreamBuffer_t ) ) )
         {
-            xBufferSizeBytes++;
+            if( ( ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) == ( uint8_t ) 0 )
+            {
+                xBufferSizeBytes++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
             pvAllocatedMemory = pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) );
         }
         else
@@ -469,6 +495,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             ucFlags = sbFLAGS_IS_BATCHING_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
             configASSERT( xBufferSizeBytes > 0 );
         }
+        else if( xStreamBufferType == sbTYPE_STREAM_PING_PONG_BUFFER )
+        {
+            /* Statically allocated ping-pong buffer. */
+            ucFlags = sbFLAGS_IS_PING_PONG_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+            configASSERT( xBufferSizeBytes == ( xTriggerLevelBytes * ( size_t ) 2 ) );
+        }
         else
         {
             /* Statically allocated stream buffer. */
@@ -734,8 +766,10 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
     }
 
     /* The trigger level is the number of bytes that must be in the stream
-     * buffer before a task that is waiting for data is unblocked. */
-    if( xTriggerLevel < pxStreamBuffer->xLength )
+     * buffer before a task that is waiting for data is unblocked.  The trigger
+     * level of a ping-pong buffer is its block size, so cannot be changed. */
+    if( ( xTriggerLevel < pxStreamBuffer->xLength ) &&
+        ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) == ( uint8_t ) 0 ) )
     {
         pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
         xReturn = pdPASS;
@@ -761,25 +795,41 @@ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
 
     configASSERT( pxStreamBuffer );
 
-    /* The code below reads xTail and then xHead.  This is safe if the stream
-     * buffer is updated once between the two reads - but not if the stream buffer
-     * is updated more than once between the two reads - hence the loop. */
-    do
-    {
-        xOriginalTail = pxStreamBuffer->xTail;
-        xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-        xSpace -= pxStreamBuffer->xHead;
-    } while( xOriginalTail != pxStreamBuffer->xTail );
-
-    xSpace -= ( size_t ) 1;
-
-    if( xSpace >= pxStreamBuffer->xLength )
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 )
     {
-        xSpace -= pxStreamBuffer->xLength;
+        /* A ping-pong buffer has room for one more block only once the reader
+         * has released the block it was last handed. */
+        if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+        {
+            xSpace = pxStreamBuffer->xTriggerLevelBytes;
+        }
+        else
+        {
+            xSpace = 0;
+        }
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
+        /* The code below reads xTail and then xHead.  This is safe if the stream
+         * buffer is updated once between the two reads - but not if the stream buffer
+         * is updated more than once between the two reads - hence the loop. */
+        do
+        {
+            xOriginalTail = pxStreamBuffer->xTail;
+            xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+            xSpace -= pxStreamBuffer->xHead;
+        } while( xOriginalTail != pxStreamBuffer->xTail );
+
+        xSpace -= ( size_t ) 1;
+
+        if( xSpace >= pxStreamBuffer->xLength )
+        {
+            xSpace -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
     traceRETURN_xStreamBufferSpacesAvailable( xSpace );
@@ -821,6 +871,10 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    /* Ping-pong buffers are written in place and handed over using
+     * pvStreamBufferSwapPingPongBlock(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) == ( uint8_t ) 0 );
+
     /* The maximum amount of space a stream buffer will ever report is its length
      * minus 1. */
     xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
@@ -954,6 +1008,10 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    /* Ping-pong buffers are written in place and handed over using
+     * pvStreamBufferSwapPingPongBlockFromISR(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) == ( uint8_t ) 0 );
+
     /* This send function is used to write to both message buffers and stream
      * buffers.  If this is a message buffer then the space needed must be
      * increased by the amount of bytes needed to store the length of the
@@ -1305,6 +1363,19 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
             mtCOVERAGE_TEST_MARKER();
         }
     }
+    else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 )
+    {
+        /* A ping-pong block can only be received whole, as reading part of it
+         * would leave the tail pointing into the middle of a block. */
+        if( xBytesAvailable > xBufferLengthBytes )
+        {
+            xNextMessageLength = 0;
+        }
+        else
+        {
+            xNextMessageLength = xBytesAvailable;
+        }
+    }
     else
     {
         /* A stream of bytes is being received (as opposed to a discrete
@@ -1473,6 +1544,216 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
+void * pvStreamBufferGetPingPongWriteBlock( StreamBufferHandle_t xStreamBuffer )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    void * pvReturn;
+
+    traceENTER_pvStreamBufferGetPingPongWriteBlock( xStreamBuffer );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 );
+
+    /* xHead always holds the offset of the block being filled. */
+    pvReturn = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+
+    traceRETURN_pvStreamBufferGetPingPongWriteBlock( pvReturn );
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvSwapPingPongBlock( StreamBuffer_t * const pxStreamBuffer )
+{
+    void * pvReturn;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 );
+
+    /* There is a single writer and a single reader.  The reader only ever moves
+     * xTail up to xHead, and only once it has been handed a block, so when the
+     * two are equal the other block is free and the writer can move xHead on
+     * to it without a critical section - in the same way xStreamBufferSend()
+     * updates xHead.  Moving xHead leaves xTail pointing at the block just
+     * filled, so exactly xTriggerLevelBytes become available to the reader. */
+    if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+    {
+        if( pxStreamBuffer->xHead == ( size_t ) 0 )
+        {
+            pxStreamBuffer->xHead = pxStreamBuffer->xTriggerLevelBytes;
+        }
+        else
+        {
+            pxStreamBuffer->xHead = ( size_t ) 0;
+        }
+
+        pvReturn = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+    }
+    else
+    {
+        /* The reader still holds the other block. */
+        pvReturn = NULL;
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvStreamBufferSwapPingPongBlock( StreamBufferHandle_t xStreamBuffer )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    void * pvReturn;
+
+    traceENTER_pvStreamBufferSwapPingPongBlock( xStreamBuffer );
+
+    pvReturn = prvSwapPingPongBlock( pxStreamBuffer );
+
+    if( pvReturn != NULL )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, pxStreamBuffer->xTriggerLevelBytes );
+        prvSEND_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+
+    traceRETURN_pvStreamBufferSwapPingPongBlock( pvReturn );
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvStreamBufferSwapPingPongBlockFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    void * pvReturn;
+
+    traceENTER_pvStreamBufferSwapPingPongBlockFromISR( xStreamBuffer, pxHigherPriorityTaskWoken );
+
+    pvReturn = prvSwapPingPongBlock( pxStreamBuffer );
+
+    if( pvReturn != NULL )
+    {
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, pxStreamBuffer->xTriggerLevelBytes );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, 0 );
+    }
+
+    traceRETURN_pvStreamBufferSwapPingPongBlockFromISR( pvReturn );
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceivePingPongBlock( StreamBufferHandle_t xStreamBuffer,
+                                          void ** ppvBlock,
+                                          TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable;
+
+    traceENTER_xStreamBufferReceivePingPongBlock( xStreamBuffer, ppvBlock, xTicksToWait );
+
+    configASSERT( ppvBlock );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 );
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable == ( size_t ) 0 )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xBytesAvailable == ( size_t ) 0 )
+        {
+            /* Wait for a block to be handed over. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    if( xBytesAvailable != ( size_t ) 0 )
+    {
+        /* The block is handed to the reader in place.  xTail is not moved
+         * until the block is released, so the writer cannot reuse it. */
+        *ppvBlock = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesAvailable );
+    }
+    else
+    {
+        *ppvBlock = NULL;
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    traceRETURN_xStreamBufferReceivePingPongBlock( xBytesAvailable );
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReleasePingPongBlock( StreamBufferHandle_t xStreamBuffer )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    traceENTER_vStreamBufferReleasePingPongBlock( xStreamBuffer );
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_PING_PONG_BUFFER ) != ( uint8_t ) 0 );
+
+    if( pxStreamBuffer->xTail != pxStreamBuffer->xHead )
+    {
+        /* The writer cannot move xHead while a block is held, so catching
+         * xTail up with it frees the block just read. */
+        pxStreamBuffer->xTail = pxStreamBuffer->xHead;
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_vStreamBufferReleasePingPongBlock();
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
                                      size_t xCount,
@@ -261,6 +261,41 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+
+/*
+ * Read the time used to measure scheduling latency into ulCounter, falling
+ * back to the run time stats counter.
+ */
+    #if defined( configSCHEDULING_LATENCY_TIMESTAMP )
+        #define taskGET_SCHEDULING_LATENCY_TIMESTAMP( ulCounter )    ( ulCounter ) = ( configRUN_TIME_COUNTER_TYPE ) configSCHEDULING_LATENCY_TIMESTAMP()
+    #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+        #define taskGET_SCHEDULING_LATENCY_TIMESTAMP( ulCounter )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounter )
+    #else
+        #define taskGET_SCHEDULING_LATENCY_TIMESTAMP( ulCounter )    ( ulCounter ) = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+
+/*
+ * Record the time at which a task that is not running is made ready, so its
+ * scheduling latency can be measured when it next runs.  A task that is
+ * already waiting to run keeps its original ready time if it is moved between
+ * ready lists by a priority change.
+ */
+    #define taskRECORD_READY_TIME( pxTCB )                                                       \
+    do {                                                                                         \
+        if( ( xSchedulerRunning != pdFALSE ) &&                                                  \
+            ( ( pxTCB )->ucSchedulingLatencyPending == ( uint8_t ) pdFALSE ) &&                  \
+            ( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) == pdFALSE ) )                  \
+        {                                                                                        \
+            taskGET_SCHEDULING_LATENCY_TIMESTAMP( ( pxTCB )->ulReadyTime );                      \
+            ( pxTCB )->ucSchedulingLatencyPending = ( uint8_t ) pdTRUE;                          \
+        }                                                                                        \
+    } while( 0 )
+#else
+    #define taskRECORD_READY_TIME( pxTCB )
+#endif /* configUSE_SCHEDULING_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
@@ -268,6 +303,7 @@
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        taskRECORD_READY_TIME( pxTCB );                                                                    \
         taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
@@ -350,6 +386,34 @@
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_ARENAS == 1 )
+
+/*
+ * Header placed at the start of each chunk of heap memory owned by a task's
+ * arena.  Chunks are linked from the TCB, most recently allocated first, and the
+ * usable space starts tskARENA_HEADER_SIZE bytes after the header.
+ */
+    typedef struct xTASK_ARENA_CHUNK
+    {
+        struct xTASK_ARENA_CHUNK * pxNext; /**< The next (older) chunk owned by the same task. */
+        size_t xSize;                      /**< The number of usable bytes in the chunk. */
+        size_t xUsed;                      /**< The number of usable bytes already handed out. */
+    } TaskArenaChunk_t;
+
+/* The size of the chunk header rounded up so the usable space that follows it
+ * remains correctly aligned. */
+    #define tskARENA_HEADER_SIZE                                                    \
+    ( ( sizeof( TaskArenaChunk_t ) + ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) & \
+      ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The largest request that can be rounded up to the alignment and given a
+ * chunk of its own without the size calculation overflowing. */
+    #define tskARENA_MAX_ALLOCATION                                     \
+    ( ( ~( ( size_t ) 0 ) ) - tskARENA_HEADER_SIZE - ( size_t ) portBYTE_ALIGNMENT_MASK )
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -433,6 +497,17 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_TASK_ARENAS == 1 )
+        struct xTASK_ARENA_CHUNK * pxArenaChunks; /**< The chunks of heap memory backing pvTaskArenaAlloc() for this task, most recent first. */
+    #endif
+
+    #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulReadyTime;                                   /**< The run time stats counter value when the task was last made ready. */
+        configRUN_TIME_COUNTER_TYPE ulMaximumSchedulingLatency;                    /**< The longest time the task has waited to run after being made ready. */
+        uint32_t ulSchedulingLatencyHistogram[ configSCHEDULING_LATENCY_BUCKETS ]; /**< See TaskSchedulingLatency_t. */
+        uint8_t ucSchedulingLatencyPending;                                        /**< Set to pdTRUE while ulReadyTime holds the time at which a task waiting to run was made ready. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -600,7 +675,8 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  * including the stack pointed to by the TCB.
  *
  * This does not free memory allocated by the task itself (i.e. memory
- * allocated by calls to pvPortMalloc from within the tasks application code).
+ * allocated by calls to pvPortMalloc from within the tasks application code),
+ * other than memory obtained from the task's arena by pvTaskArenaAlloc().
  */
 #if ( INCLUDE_vTaskDelete == 1 )
 
@@ -608,6 +684,15 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Return a list of arena chunks to the heap.
+ */
+#if ( configUSE_TASK_ARENAS == 1 )
+
+    static void prvFreeArenaChunks( TaskArenaChunk_t * pxChunk ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -712,6 +797,23 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+
+/*
+ * Called when a task enters the Running state to add the time since it was
+ * made ready to its scheduling latency histogram.
+ */
+    static void prvRecordSchedulingLatency( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the scheduler is started to record the ready time of the tasks
+ * created before it was started, which are made ready before there is a time
+ * to record.
+ */
+    static void prvRecordReadyTimesAtSchedulerStart( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
  * the task if it is created successfully. Otherwise, returns NULL.
@@ -1077,6 +1179,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                             pxTCB->xTaskRunState = xCoreID;
                             pxCurrentTCBs[ xCoreID ] = pxTCB;
                             xTaskScheduled = pdTRUE;
+
+                            #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+                            {
+                                prvRecordSchedulingLatency( pxTCB );
+                            }
+                            #endif
                         }
                     }
                     else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
@@ -3157,6 +3265,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
+            #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+            {
+                /* A task suspended while waiting to run starts a new latency
+                 * measurement when it is resumed. */
+                pxTCB->ucSchedulingLatencyPending = ( uint8_t ) pdFALSE;
+            }
+            #endif
+
             #if ( configUSE_TASK_NOTIFICATIONS == 1 )
             {
                 BaseType_t x;
@@ -3481,6 +3597,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     /* The delayed or ready lists cannot be accessed so the task
                      * is held in the pending ready list until the scheduler is
                      * unsuspended. */
+                    taskRECORD_READY_TIME( pxTCB );
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
@@ -3731,6 +3848,14 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+        {
+            /* The scheduling latency of tasks created before the scheduler
+             * was started is measured from now. */
+            prvRecordReadyTimesAtSchedulerStart();
+        }
+        #endif
+
         traceTASK_SWITCHED_IN();
 
         traceSTARTING_SCHEDULER( xIdleTaskHandles );
@@ -3802,7 +3927,22 @@ void vTaskEndScheduler( void )
      * routine so the original ISRs can be restored if necessary.  The port
      * layer must ensure interrupts enable  bit is left in the correct state. */
     portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        xSchedulerRunning = pdFALSE;
+    }
+    #else
+    {
+        /* The other cores can be switching context, so the scheduler is
+         * stopped while holding the locks vTaskSwitchContext() holds. */
+        portGET_TASK_LOCK();
+        portGET_ISR_LOCK();
+        xSchedulerRunning = pdFALSE;
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
+    }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
     /* This function must be called from a task and the application is
      * responsible for deleting that task after the scheduler is stopped. */
@@ -4463,6 +4603,139 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+
+    static void prvRecordReadyTimesAtSchedulerStart( void )
+    {
+        UBaseType_t uxPriority;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            pxEndMarker = listGET_END_MARKER( &( pxReadyTasksLists[ uxPriority ] ) );
+
+            for( pxIterator = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxPriority ] ) ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                /* The tasks that run first are not stamped, as they enter the
+                 * Running state without being switched in. */
+                taskRECORD_READY_TIME( pxTCB );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordSchedulingLatency( TCB_t * pxTCB )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+        UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+        if( pxTCB->ucSchedulingLatencyPending != ( uint8_t ) pdFALSE )
+        {
+            pxTCB->ucSchedulingLatencyPending = ( uint8_t ) pdFALSE;
+
+            taskGET_SCHEDULING_LATENCY_TIMESTAMP( ulNow );
+
+            /* As with the run time stats there is no overflow protection, so a
+             * latency that spans a wrap of the timestamp is not recorded, and
+             * the guard protects against suspect counter implementations. */
+            if( ulNow >= pxTCB->ulReadyTime )
+            {
+                ulLatency = ulNow - pxTCB->ulReadyTime;
+
+                if( ulLatency > pxTCB->ulMaximumSchedulingLatency )
+                {
+                    pxTCB->ulMaximumSchedulingLatency = ulLatency;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The bucket is the number of significant bits in the latency,
+                 * limited to the last bucket. */
+                while( ( ulLatency != ( configRUN_TIME_COUNTER_TYPE ) 0U ) && ( uxBucket < ( UBaseType_t ) ( configSCHEDULING_LATENCY_BUCKETS - 1 ) ) )
+                {
+                    ulLatency >>= 1;
+                    uxBucket++;
+                }
+
+                pxTCB->ulSchedulingLatencyHistogram[ uxBucket ]++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*----------------------------------------------------------*/
+
+    void vTaskGetSchedulingLatency( TaskHandle_t xTask,
+                                    TaskSchedulingLatency_t * pxSchedulingLatency )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+
+        traceENTER_vTaskGetSchedulingLatency( xTask, pxSchedulingLatency );
+
+        configASSERT( pxSchedulingLatency != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxSchedulingLatency->ulHistogram[ uxBucket ] = pxTCB->ulSchedulingLatencyHistogram[ uxBucket ];
+            }
+
+            pxSchedulingLatency->ulMaximumLatency = pxTCB->ulMaximumSchedulingLatency;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetSchedulingLatency();
+    }
+/*----------------------------------------------------------*/
+
+    void vTaskResetSchedulingLatency( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+
+        traceENTER_vTaskResetSchedulingLatency( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) configSCHEDULING_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxTCB->ulSchedulingLatencyHistogram[ uxBucket ] = 0U;
+            }
+
+            pxTCB->ulMaximumSchedulingLatency = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskResetSchedulingLatency();
+    }
+
+#endif /* configUSE_SCHEDULING_LATENCY_STATS */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -5118,6 +5391,12 @@ BaseType_t xTaskIncrementTick( void )
             taskSELECT_HIGHEST_PRIORITY_TASK();
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_SCHEDULING_LATENCY_STATS == 1 )
+            {
+                prvRecordSchedulingLatency( pxCurrentTCB );
+            }
+            #endif
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5168,6 +5447,12 @@ BaseType_t xTaskIncrementTick( void )
                  * switch. */
                 xYieldPendings[ xCoreID ] = pdTRUE;
             }
+            else if( xSchedulerRunning == pdFALSE )
+            {
+                /* Another core has called vTaskEndScheduler().  This core keeps
+                 * running its current task until the port stops it. */
+                mtCOVERAGE_TEST_MARKER();
+            }
             else
             {
                 xYieldPendings[ xCoreID ] = pdFALSE;
@@ -5391,7 +5676,10 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     else
     {
         /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
+         * pending until the scheduler is resumed.  The task is ready from now,
+         * so its ready time is recorded now rather than when it is moved to a
+         * ready list. */
+        taskRECORD_READY_TIME( pxUnblockedTCB );
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
@@ -5507,6 +5795,92 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_FROM_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue );
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+         * The event group accesses its event lists from critical sections when
+         * configUSE_EVENT_GROUP_DIRECT_FROM_ISR is 1, so exclusive access to the
+         * event list is guaranteed here. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem );
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See the comment in xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed. */
+            taskRECORD_READY_TIME( pxUnblockedTCB );
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+            {
+                xReturn = pdTRUE;
+
+                /* Mark that a yield is pending in case the user is not using the
+                 * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+                 * function. */
+                xYieldPendings[ 0 ] = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+        traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_FROM_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
@@ -5816,6 +6190,8 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
         }
         #endif /* configUSE_IDLE_HOOK */
 
+        portIDLE_TASK_HOOK();
+
         /* This conditional compilation should use inequality to 0, not equality
          * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
          * user defined low power mode  implementations require
@@ -5991,6 +6367,150 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_ARENAS == 1 )
+
+    void * pvTaskArenaAlloc( size_t xWantedSize )
+    {
+        TCB_t * pxTCB;
+        TaskArenaChunk_t * pxChunk;
+        TaskArenaChunk_t * pxNewChunk;
+        size_t xChunkSize;
+        void * pvReturn = NULL;
+
+        traceENTER_pvTaskArenaAlloc( xWantedSize );
+
+        /* The arena belongs to the calling task and is only ever accessed from
+         * that task, or from prvDeleteTCB() once the task can no longer run, so
+         * no critical section is needed to manipulate it. */
+        pxTCB = prvGetTCBFromHandle( NULL );
+        configASSERT( pxTCB != NULL );
+
+        if( ( xWantedSize > 0U ) && ( xWantedSize <= tskARENA_MAX_ALLOCATION ) )
+        {
+            /* Keep every allocation, and therefore the next one, aligned. */
+            xWantedSize = ( xWantedSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+            pxChunk = pxTCB->pxArenaChunks;
+
+            if( ( pxChunk == NULL ) || ( ( pxChunk->xSize - pxChunk->xUsed ) < xWantedSize ) )
+            {
+                if( xWantedSize > ( size_t ) configTASK_ARENA_CHUNK_SIZE )
+                {
+                    xChunkSize = xWantedSize;
+                }
+                else
+                {
+                    xChunkSize = ( size_t ) configTASK_ARENA_CHUNK_SIZE;
+                }
+
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxNewChunk = ( TaskArenaChunk_t * ) pvPortMalloc( tskARENA_HEADER_SIZE + xChunkSize );
+
+                if( pxNewChunk != NULL )
+                {
+                    pxNewChunk->xSize = xChunkSize;
+                    pxNewChunk->xUsed = 0U;
+
+                    if( ( pxChunk != NULL ) && ( xChunkSize > ( size_t ) configTASK_ARENA_CHUNK_SIZE ) )
+                    {
+                        /* An oversized request is given a chunk of its own that
+                         * is linked behind the current chunk, so the space left in
+                         * the current chunk is still used by later requests. */
+                        pxNewChunk->pxNext = pxChunk->pxNext;
+                        pxChunk->pxNext = pxNewChunk;
+                    }
+                    else
+                    {
+                        pxNewChunk->pxNext = pxChunk;
+                        pxTCB->pxArenaChunks = pxNewChunk;
+                    }
+
+                    pxChunk = pxNewChunk;
+                }
+                else
+                {
+                    pxChunk = NULL;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxChunk != NULL )
+            {
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxChunk ) + tskARENA_HEADER_SIZE + pxChunk->xUsed );
+                pxChunk->xUsed += xWantedSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_pvTaskArenaAlloc( pvReturn );
+
+        return pvReturn;
+    }
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ARENAS == 1 )
+
+    void vTaskArenaReset( void )
+    {
+        TCB_t * pxTCB;
+        TaskArenaChunk_t * pxChunk;
+
+        traceENTER_vTaskArenaReset();
+
+        pxTCB = prvGetTCBFromHandle( NULL );
+        configASSERT( pxTCB != NULL );
+
+        pxChunk = pxTCB->pxArenaChunks;
+
+        if( pxChunk != NULL )
+        {
+            /* Keep the most recent chunk so a task that resets its arena once
+             * per unit of work does not go back to the heap every time. */
+            prvFreeArenaChunks( pxChunk->pxNext );
+            pxChunk->pxNext = NULL;
+            pxChunk->xUsed = 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskArenaReset();
+    }
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ARENAS == 1 )
+
+    static void prvFreeArenaChunks( TaskArenaChunk_t * pxChunk )
+    {
+        TaskArenaChunk_t * pxNextChunk;
+
+        while( pxChunk != NULL )
+        {
+            pxNextChunk = pxChunk->pxNext;
+            vPortFree( pxChunk );
+            pxChunk = pxNextChunk;
+        }
+    }
+
+#endif /* configUSE_TASK_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
     void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
@@ -6418,6 +6938,15 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
+        #if ( configUSE_TASK_ARENAS == 1 )
+        {
+            /* Everything the task obtained from its arena is released at once,
+             * whether or not the task freed its allocations before exiting. */
+            prvFreeArenaChunks( pxTCB->pxArenaChunks );
+            pxTCB->pxArenaChunks = NULL;
+        }
+        #endif
+
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
         {
             /* The task can only have been allocated dynamically - free both
@@ -7588,6 +8117,24 @@ TickType_t uxTaskResetEventItemValue( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_BITMAPS == 1 )
+
+    ListItem_t * pxTaskGetEventListItem( void )
+    {
+        ListItem_t * pxReturn;
+
+        traceENTER_pxTaskGetEventListItem();
+
+        pxReturn = &( pxCurrentTCB->xEventListItem );
+
+        traceRETURN_pxTaskGetEventListItem( pxReturn );
+
+        return pxReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_BITMAPS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     TaskHandle_t pvTaskIncrementMutexHeldCount( void )
@@ -8064,6 +8611,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRECORD_READY_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
@@ -8182,6 +8730,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 {
                     /* The delayed and ready lists cannot be accessed, so hold
                      * this task pending until the scheduler is resumed. */
+                    taskRECORD_READY_TIME( pxTCB );
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
@@ -8638,6 +9187,39 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         *puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
     }
 
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+
+        void vApplicationGetPerCoreTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                                    StackType_t ** ppxTimerTaskStackBuffer,
+                                                    configSTACK_DEPTH_TYPE * puxTimerTaskStackSize,
+                                                    BaseType_t xTimerTaskIndex )
+        {
+            static StaticTask_t xTimerTaskTCBs[ configNUMBER_OF_CORES - 1 ];
+            static StackType_t uxTimerTaskStacks[ configNUMBER_OF_CORES - 1 ][ configTIMER_TASK_STACK_DEPTH ];
+
+            *ppxTimerTaskTCBBuffer = &( xTimerTaskTCBs[ xTimerTaskIndex ] );
+            *ppxTimerTaskStackBuffer = &( uxTimerTaskStacks[ xTimerTaskIndex ][ 0 ] );
+            *puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+        }
+
+    #endif /* #if ( configUSE_PER_CORE_TIMER_TASKS == 1 ) */
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+        void vApplicationGetHRTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                               StackType_t ** ppxTimerTaskStackBuffer,
+                                               configSTACK_DEPTH_TYPE * puxTimerTaskStackSize )
+        {
+            static StaticTask_t xHRTimerTaskTCB;
+            static StackType_t uxHRTimerTaskStack[ configHR_TIMER_TASK_STACK_DEPTH ];
+
+            *ppxTimerTaskTCBBuffer = &( xHRTimerTaskTCB );
+            *ppxTimerTaskStackBuffer = &( uxHRTimerTaskStack[ 0 ] );
+            *puxTimerTaskStackSize = configHR_TIMER_TASK_STACK_DEPTH;
+        }
+
+    #endif /* #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) */
+
 #endif /* #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configKERNEL_PROVIDED_STATIC_MEMORY == 1 ) && ( portUSING_MPU_WRAPPERS == 0 ) ) */
 /*-----------------------------------------------------------*/
 
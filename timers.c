@@ -74,6 +74,32 @@
         #endif
     #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Dimensions of the timer wheel.  Level 0 has one slot per tick, and each
+ * slot of level n covers as many ticks as the whole of level n - 1. */
+        #define tmrWHEEL_SLOT_BITS    ( ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOTS        ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK    ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_LEVELS       ( ( UBaseType_t ) configTIMER_WHEEL_LEVELS )
+        #define tmrTICK_TYPE_BITS     ( ( UBaseType_t ) ( sizeof( TickType_t ) * ( size_t ) 8 ) )
+    #endif /* configUSE_TIMER_WHEEL */
+
+/* When configUSE_TIMER_DIRECT_COMMANDS is 1 tasks can update the active timers
+ * directly, so the timer service task must hold the scheduler lock whenever it
+ * accesses them.  The lock is released while timer callbacks execute. */
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+        #define tmrLOCK_ACTIVE_TIMERS()      vTaskSuspendAll()
+        #define tmrUNLOCK_ACTIVE_TIMERS()    ( void ) xTaskResumeAll()
+    #else
+        #define tmrLOCK_ACTIVE_TIMERS()
+        #define tmrUNLOCK_ACTIVE_TIMERS()
+    #endif
+
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        #define tmrGET_CORE_ID()    ( ( BaseType_t ) portGET_CORE_ID() )
+    #endif
+
 /* Bit definitions used in the ucStatus member of a timer structure. */
     #define tmrSTATUS_IS_ACTIVE                  ( 0x01U )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( 0x02U )
@@ -91,12 +117,52 @@
             UBaseType_t uxTimerNumber;                                           /**< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
         uint8_t ucStatus;                                                        /**< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+            BaseType_t xTimerCoreID;                                             /**< The core whose timer service task owns the timer. */
+        #endif
+        #if ( configUSE_TIMER_SLACK == 1 )
+            TickType_t xTimerSlack;                                              /**< The number of ticks by which the expiry of the timer can be delayed. */
+        #endif
     } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
  * name below to enable the use of older kernel aware debuggers. */
     typedef xTIMER Timer_t;
 
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/* The name assigned to the task that executes high resolution timer callbacks.
+ * This can be overridden by defining configHR_TIMER_SERVICE_TASK_NAME in
+ * FreeRTOSConfig.h. */
+        #ifndef configHR_TIMER_SERVICE_TASK_NAME
+            #define configHR_TIMER_SERVICE_TASK_NAME    "HRT Svc"
+        #endif
+
+/* Bit definitions used in the ucStatus member of a high resolution timer
+ * structure. */
+        #define tmrHR_STATUS_IS_ACTIVE                  ( 0x01U )
+        #define tmrHR_STATUS_IS_PENDING                 ( 0x02U )
+        #define tmrHR_STATUS_IS_STATICALLY_ALLOCATED    ( 0x04U )
+        #define tmrHR_STATUS_CALLBACK_FROM_TASK         ( 0x08U )
+
+/* Evaluates to pdTRUE if count xCountA is not after count xCountB.  Counts wrap,
+ * so this is only valid while they are within tmrHR_MAX_DELAY of each other. */
+        #define tmrHR_COUNT_IS_NOT_AFTER( xCountA, xCountB )    ( ( ( HRTimerCount_t ) ( ( xCountB ) - ( xCountA ) ) <= tmrHR_MAX_DELAY ) ? pdTRUE : pdFALSE )
+
+/* The definition of high resolution timers. */
+        typedef struct tmrHRTimerControl
+        {
+            const char * pcTimerName;                     /**< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */
+            struct tmrHRTimerControl * pxNext;            /**< The next timer in the list of active timers. */
+            struct tmrHRTimerControl * pxNextPending;     /**< The next timer in the list of timers whose callbacks are waiting to execute from the high resolution timer task. */
+            HRTimerCount_t xExpiryCount;                  /**< The count of the hardware timer at which the timer expires. */
+            void * pvTimerID;                             /**< An ID to identify the timer. */
+            HRTimerCallbackFunction_t pxCallbackFunction; /**< The function that will be called when the timer expires. */
+            uint8_t ucStatus;                             /**< Holds bits to say if the timer was statically allocated or not, if it is active or pending or not, and where its callback executes. */
+        } HRTimer_t;
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 /* The definition of messages that can be sent and received on the timer queue.
  * Two types of message can be queued - messages that manipulate a software timer,
  * and messages that request the execution of a non-timer related callback.  The
@@ -140,14 +206,104 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 0 )
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 0 )
+            PRIVILEGED_DATA static List_t xActiveTimerList1;
+            PRIVILEGED_DATA static List_t xActiveTimerList2;
+            PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+            PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+        #else
+            PRIVILEGED_DATA static List_t xActiveTimerLists[ configNUMBER_OF_CORES ][ 2 ];
+            PRIVILEGED_DATA static List_t * pxCurrentTimerLists[ configNUMBER_OF_CORES ];
+            PRIVILEGED_DATA static List_t * pxOverflowTimerLists[ configNUMBER_OF_CORES ];
+            #define pxCurrentTimerList     ( pxCurrentTimerLists[ tmrGET_CORE_ID() ] )
+            #define pxOverflowTimerList    ( pxOverflowTimerLists[ tmrGET_CORE_ID() ] )
+        #endif /* configUSE_PER_CORE_TIMER_TASKS */
+    #else
+
+/* When configUSE_TIMER_WHEEL is 1 active timers are instead referenced from a
+ * hierarchical timer wheel.  A timer is placed in the lowest level that spans
+ * its expiry time, in the slot that covers the expiry time, so inserting and
+ * removing a timer is O(1) regardless of how many timers are active.  When
+ * xTimerWheelTime reaches the start of a slot in a higher level the timers in
+ * that slot are cascaded down, so a timer that reaches level 0 expires when
+ * xTimerWheelTime reaches its slot.  Timers are ordered relative to
+ * xTimerWheelTime using wrapping arithmetic, so no list switching is needed
+ * when the tick count overflows.  As with the lists above, only the timer
+ * service task is allowed to access the wheel. */
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 0 )
+            PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ ( size_t ) 1U << configTIMER_WHEEL_SLOT_BITS ];
+            PRIVILEGED_DATA static UBaseType_t uxTimerWheelLevelCount[ configTIMER_WHEEL_LEVELS ];
+            PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+        #else
+            PRIVILEGED_DATA static List_t xTimerWheels[ configNUMBER_OF_CORES ][ configTIMER_WHEEL_LEVELS ][ ( size_t ) 1U << configTIMER_WHEEL_SLOT_BITS ];
+            PRIVILEGED_DATA static UBaseType_t uxTimerWheelLevelCounts[ configNUMBER_OF_CORES ][ configTIMER_WHEEL_LEVELS ];
+            PRIVILEGED_DATA static TickType_t xTimerWheelTimes[ configNUMBER_OF_CORES ];
+            #define xTimerWheel               ( xTimerWheels[ tmrGET_CORE_ID() ] )
+            #define uxTimerWheelLevelCount    ( uxTimerWheelLevelCounts[ tmrGET_CORE_ID() ] )
+            #define xTimerWheelTime           ( xTimerWheelTimes[ tmrGET_CORE_ID() ] )
+        #endif /* configUSE_PER_CORE_TIMER_TASKS */
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 0 )
 
 /* A queue that is used to send commands to the timer service task. */
-    PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
-    PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+        PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
+        PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+
+/* The tick count when the active timers were last sampled, used to detect tick
+ * count overflows. */
+        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U;
+
+/* The queue used to send commands that act on a particular timer. */
+        #define tmrTIMER_QUEUE_FOR( pxTimer )    ( xTimerQueue )
+    #else
+
+/* When configUSE_PER_CORE_TIMER_TASKS is 1 each core has its own timer service
+ * task, active timers and timer queue, and each timer is owned by one core.
+ * The names used to access the timer service task state elsewhere in this file
+ * refer to the state of the core on which they are evaluated, so they can only
+ * be used by a timer service task (which is pinned to its core), with the
+ * scheduler suspended, or with interrupts masked. */
+        PRIVILEGED_DATA static QueueHandle_t xTimerQueues[ configNUMBER_OF_CORES ];
+        PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandles[ configNUMBER_OF_CORES ];
+        PRIVILEGED_DATA static TickType_t xLastTimes[ configNUMBER_OF_CORES ];
+
+        #define xTimerQueue                      ( xTimerQueues[ tmrGET_CORE_ID() ] )
+        #define xTimerTaskHandle                 ( xTimerTaskHandles[ tmrGET_CORE_ID() ] )
+        #define xLastTime                        ( xLastTimes[ tmrGET_CORE_ID() ] )
+        #define tmrTIMER_QUEUE_FOR( pxTimer )    ( xTimerQueues[ ( pxTimer )->xTimerCoreID ] )
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+/* When configUSE_TIMER_SLACK is 1 the timer service task records the time to
+ * which it deferred its wake-up, and how many wake-ups that saved, so the saving
+ * can be counted once the deferred wake-up occurs. */
+    #if ( configUSE_TIMER_SLACK == 1 )
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 0 )
+            PRIVILEGED_DATA static TickType_t xTimerCoalescedWakeTime = ( TickType_t ) 0U;
+            PRIVILEGED_DATA static UBaseType_t uxTimerPendingCoalescedWakes = ( UBaseType_t ) 0U;
+            PRIVILEGED_DATA static uint32_t ulTimerCoalescedWakeCount = ( uint32_t ) 0U;
+        #else
+            PRIVILEGED_DATA static TickType_t xTimerCoalescedWakeTimes[ configNUMBER_OF_CORES ];
+            PRIVILEGED_DATA static UBaseType_t uxTimerPendingCoalescedWakeCounts[ configNUMBER_OF_CORES ];
+            PRIVILEGED_DATA static uint32_t ulTimerCoalescedWakeCounts[ configNUMBER_OF_CORES ];
+            #define xTimerCoalescedWakeTime         ( xTimerCoalescedWakeTimes[ tmrGET_CORE_ID() ] )
+            #define uxTimerPendingCoalescedWakes    ( uxTimerPendingCoalescedWakeCounts[ tmrGET_CORE_ID() ] )
+            #define ulTimerCoalescedWakeCount       ( ulTimerCoalescedWakeCounts[ tmrGET_CORE_ID() ] )
+        #endif /* configUSE_PER_CORE_TIMER_TASKS */
+    #endif /* configUSE_TIMER_SLACK */
+
+/* When configUSE_HIGH_RESOLUTION_TIMERS is 1 active high resolution timers are
+ * referenced from a singly linked list in expiry order, and timers whose
+ * callbacks execute from a task are queued on a second list once they expire.
+ * Both lists are accessed from the hardware timer interrupt, so are only
+ * accessed from within critical sections. */
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+        PRIVILEGED_DATA static HRTimer_t * pxHRTimerListHead = NULL;
+        PRIVILEGED_DATA static HRTimer_t * pxHRTimerPendingHead = NULL;
+        PRIVILEGED_DATA static HRTimer_t * pxHRTimerPendingTail = NULL;
+        PRIVILEGED_DATA static TaskHandle_t xHRTimerTaskHandle = NULL;
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 
 /*-----------------------------------------------------------*/
 
@@ -172,13 +328,50 @@
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow.  When
+ * configUSE_TIMER_WHEEL is 1 the timer is inserted into the timer wheel instead.
  */
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
                                                   const TickType_t xNextExpiryTime,
                                                   const TickType_t xTimeNow,
                                                   const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from whichever active list or wheel slot references it.
+ */
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Insert the timer, the list item value of which holds its expiry time, into
+ * the timer wheel slot that covers its expiry time.
+ */
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if no timers are referenced from any level of the wheel,
+ * otherwise pdFALSE.
+ */
+        static BaseType_t prvIsTimerWheelEmpty( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of ticks from xTimerWheelTime to the next tick at which
+ * the wheel has work to do - either a level 0 slot that holds timers, or a
+ * higher level slot that must be cascaded down.  Returns 0 if timers in the
+ * current level 0 slot are still to be processed, and portMAX_DELAY if the
+ * wheel is empty.
+ */
+        static TickType_t prvGetTicksToNextWheelEvent( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xTimerWheelTime forward to xTimeNow, cascading timers down and
+ * processing expired timers on the way.
+ */
+        static void prvAdvanceTimerWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Reload the specified auto-reload timer.  If the reloading is backlogged,
  * clear the backlog, calling the callback for each additional reload.  When
@@ -192,14 +385,19 @@
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
  */
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+    static void prvProcessExpiredTimer( Timer_t * const pxTimer,
+                                        const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -219,9 +417,95 @@
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+/*
+ * Call the callback function of a timer that has expired.
+ */
+    static void prvExecuteTimerCallback( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called with the current timer list not empty.  Walks the current timer list
+ * from its head, which expires at xNextExpireTime, and returns the latest
+ * expiry time that is still within the slack of every timer that expires
+ * before it, so all those timers can be processed from a single wake-up.  The
+ * number of wake-ups that saves is returned in *puxCoalescedWakes.
+ */
+    #if ( configUSE_TIMER_SLACK == 1 )
+        static TickType_t prvGetCoalescedExpireTime( const TickType_t xNextExpireTime,
+                                                     UBaseType_t * const puxCoalescedWakes ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/*
+ * Called after a high resolution timer structure has been allocated.
+ */
+        static void prvInitialiseNewHRTimer( const char * const pcTimerName,
+                                             const BaseType_t xCallbackContext,
+                                             void * const pvTimerID,
+                                             HRTimerCallbackFunction_t pxCallbackFunction,
+                                             HRTimer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Starts or stops a high resolution timer, and updates the hardware timer
+ * compare if the timer that expires first changes.  Called from within a
+ * critical section.
+ */
+        static void prvHRTimerStart( HRTimer_t * const pxTimer,
+                                     const HRTimerCount_t xDelay ) PRIVILEGED_FUNCTION;
+        static BaseType_t prvHRTimerStop( HRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes a high resolution timer from the list of active timers.  Called from
+ * within a critical section with the timer known to be active.
+ */
+        static void prvHRTimerRemoveFromActiveList( HRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the hardware timer compare to the expiry count of the high resolution
+ * timer that expires first, or cancels it if no timers are active.
+ */
+        static void prvHRTimerSetCompare( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The task that executes the callbacks of high resolution timers created with
+ * tmrHR_CALLBACK_FROM_TASK, and the function that creates it.
+ */
+        static portTASK_FUNCTION_PROTO( prvHRTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
+        static BaseType_t prvCreateHRTimerTask( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+
+/*
+ * Called before a command updates the active timers of the calling core.
+ * Returns pdFALSE if the timer is owned by another core, in which case the
+ * command must be left to the timer service task of that core.  Otherwise, if
+ * the command starts the timer, marks the timer as active so it cannot be
+ * moved to another core by vTimerSetCoreID() while it is being added to the
+ * active timers of this core.
+ */
+        static BaseType_t prvClaimTimerForCommand( Timer_t * const pxTimer,
+                                                   const BaseType_t xCommandID ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+/*
+ * Called by xTimerGenericCommandFromTask() to update the active timers without
+ * sending a command to the timer service task.  Returns pdFAIL if the command
+ * cannot be processed directly, in which case it must be sent on xTimerQueue.
+ */
+        static BaseType_t prvProcessCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
 /*
  * Called after a Timer_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -246,6 +530,71 @@
          * been created then the initialisation will already have been performed. */
         prvCheckForValidListAndQueue();
 
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        {
+            BaseType_t xCoreID;
+
+            /* Create a timer service task pinned to each core. */
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                if( xTimerQueues[ xCoreID ] == NULL )
+                {
+                    xReturn = pdFAIL;
+                    break;
+                }
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    StaticTask_t * pxTimerTaskTCBBuffer = NULL;
+                    StackType_t * pxTimerTaskStackBuffer = NULL;
+                    configSTACK_DEPTH_TYPE uxTimerTaskStackSize;
+
+                    if( xCoreID == ( BaseType_t ) 0 )
+                    {
+                        vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize );
+                    }
+                    else
+                    {
+                        vApplicationGetPerCoreTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize, xCoreID - 1 );
+                    }
+
+                    xTimerTaskHandles[ xCoreID ] = xTaskCreateStaticAffinitySet( prvTimerTask,
+                                                                                 configTIMER_SERVICE_TASK_NAME,
+                                                                                 uxTimerTaskStackSize,
+                                                                                 NULL,
+                                                                                 ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                                                 pxTimerTaskStackBuffer,
+                                                                                 pxTimerTaskTCBBuffer,
+                                                                                 ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID );
+
+                    if( xTimerTaskHandles[ xCoreID ] != NULL )
+                    {
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        xReturn = pdFAIL;
+                    }
+                }
+                #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+                {
+                    xReturn = xTaskCreateAffinitySet( prvTimerTask,
+                                                      configTIMER_SERVICE_TASK_NAME,
+                                                      configTIMER_TASK_STACK_DEPTH,
+                                                      NULL,
+                                                      ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                      ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID,
+                                                      &( xTimerTaskHandles[ xCoreID ] ) );
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                if( xReturn != pdPASS )
+                {
+                    break;
+                }
+            }
+        }
+        #else /* if ( configUSE_PER_CORE_TIMER_TASKS == 1 ) */
         if( xTimerQueue != NULL )
         {
             #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
@@ -322,6 +671,20 @@
         {
             mtCOVERAGE_TEST_MARKER();
         }
+        #endif /* if ( configUSE_PER_CORE_TIMER_TASKS == 1 ) */
+
+        #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+        {
+            if( xReturn == pdPASS )
+            {
+                xReturn = prvCreateHRTimerTask();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 
         configASSERT( xReturn );
 
@@ -414,6 +777,65 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+
+        TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName,
+                                             const TickType_t xTimerPeriodInTicks,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             TimerCallbackFunction_t pxCallbackFunction,
+                                             const TickType_t xTimerSlack )
+        {
+            Timer_t * pxNewTimer;
+
+            traceENTER_xTimerCreateWithSlack( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, xTimerSlack );
+
+            pxNewTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
+
+            if( pxNewTimer != NULL )
+            {
+                /* The timer has not been started yet so is not referenced by
+                 * the timer service task. */
+                pxNewTimer->xTimerSlack = xTimerSlack;
+            }
+
+            traceRETURN_xTimerCreateWithSlack( pxNewTimer );
+
+            return pxNewTimer;
+        }
+
+    #endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+
+        TimerHandle_t xTimerCreateStaticWithSlack( const char * const pcTimerName,
+                                                   const TickType_t xTimerPeriodInTicks,
+                                                   const BaseType_t xAutoReload,
+                                                   void * const pvTimerID,
+                                                   TimerCallbackFunction_t pxCallbackFunction,
+                                                   const TickType_t xTimerSlack,
+                                                   StaticTimer_t * pxTimerBuffer )
+        {
+            Timer_t * pxNewTimer;
+
+            traceENTER_xTimerCreateStaticWithSlack( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, xTimerSlack, pxTimerBuffer );
+
+            pxNewTimer = xTimerCreateStatic( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer );
+
+            if( pxNewTimer != NULL )
+            {
+                pxNewTimer->xTimerSlack = xTimerSlack;
+            }
+
+            traceRETURN_xTimerCreateStaticWithSlack( pxNewTimer );
+
+            return pxNewTimer;
+        }
+
+    #endif /* ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
     static void prvInitialiseNewTimer( const char * const pcTimerName,
                                        const TickType_t xTimerPeriodInTicks,
                                        const BaseType_t xAutoReload,
@@ -436,6 +858,26 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* The timer is owned by the core that creates it until
+             * vTimerSetCoreID() is called. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            {
+                pxNewTimer->xTimerCoreID = tmrGET_CORE_ID();
+            }
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+        }
+        #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+        #if ( configUSE_TIMER_SLACK == 1 )
+        {
+            pxNewTimer->xTimerSlack = ( TickType_t ) 0U;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_AUTORELOAD;
@@ -462,7 +904,7 @@
 
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
-        if( xTimerQueue != NULL )
+        if( tmrTIMER_QUEUE_FOR( xTimer ) != NULL )
         {
             /* Send a command to the timer service task to start the xTimer timer. */
             xMessage.xMessageID = xCommandID;
@@ -471,15 +913,26 @@
 
             configASSERT( xCommandID < tmrFIRST_FROM_ISR_COMMAND );
 
-            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* Try updating the active timers directly, falling back to
+                 * sending the command if that is not possible. */
+                if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+                {
+                    xReturn = prvProcessCommandDirectly( xTimer, xCommandID, xOptionalValue );
+                }
+            }
+            #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+            if( ( xCommandID < tmrFIRST_FROM_ISR_COMMAND ) && ( xReturn == pdFAIL ) )
             {
                 if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    xReturn = xQueueSendToBack( tmrTIMER_QUEUE_FOR( xTimer ), &xMessage, xTicksToWait );
                 }
                 else
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                    xReturn = xQueueSendToBack( tmrTIMER_QUEUE_FOR( xTimer ), &xMessage, tmrNO_DELAY );
                 }
             }
 
@@ -513,7 +966,7 @@
 
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
-        if( xTimerQueue != NULL )
+        if( tmrTIMER_QUEUE_FOR( xTimer ) != NULL )
         {
             /* Send a command to the timer service task to start the xTimer timer. */
             xMessage.xMessageID = xCommandID;
@@ -524,7 +977,7 @@
 
             if( xCommandID >= tmrFIRST_FROM_ISR_COMMAND )
             {
-                xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                xReturn = xQueueSendToBackFromISR( tmrTIMER_QUEUE_FOR( xTimer ), &xMessage, pxHigherPriorityTaskWoken );
             }
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -540,18 +993,47 @@
     }
 /*-----------------------------------------------------------*/
 
-    TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
-    {
-        traceENTER_xTimerGetTimerDaemonTaskHandle();
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 0 )
+
+        TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+        {
+            traceENTER_xTimerGetTimerDaemonTaskHandle();
 
-        /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
-         * started, then xTimerTaskHandle will be NULL. */
-        configASSERT( ( xTimerTaskHandle != NULL ) );
+            /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
+             * started, then xTimerTaskHandle will be NULL. */
+            configASSERT( ( xTimerTaskHandle != NULL ) );
 
-        traceRETURN_xTimerGetTimerDaemonTaskHandle( xTimerTaskHandle );
+            traceRETURN_xTimerGetTimerDaemonTaskHandle( xTimerTaskHandle );
 
-        return xTimerTaskHandle;
-    }
+            return xTimerTaskHandle;
+        }
+
+    #else /* if ( configUSE_PER_CORE_TIMER_TASKS == 0 ) */
+
+        TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xTimerGetTimerDaemonTaskHandle();
+
+            /* Return the timer service task of the calling core. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            {
+                xReturn = xTimerTaskHandle;
+            }
+            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+            /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
+             * started, then the handle will be NULL. */
+            configASSERT( ( xReturn != NULL ) );
+
+            traceRETURN_xTimerGetTimerDaemonTaskHandle( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* if ( configUSE_PER_CORE_TIMER_TASKS == 0 ) */
 /*-----------------------------------------------------------*/
 
     TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
@@ -635,6 +1117,105 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+
+        void vTimerSetCoreID( TimerHandle_t xTimer,
+                              BaseType_t xCoreID )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            traceENTER_vTimerSetCoreID( xTimer, xCoreID );
+
+            configASSERT( xTimer );
+            configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+            taskENTER_CRITICAL();
+            {
+                /* An active timer is referenced from the active timers of its
+                 * current core, so it cannot be moved to another core.  Commands
+                 * still waiting on the queue of the current core are passed on
+                 * to the new core by the timer service task of the current
+                 * core. */
+                configASSERT( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U );
+                pxTimer->xTimerCoreID = xCoreID;
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_vTimerSetCoreID();
+        }
+
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+
+        BaseType_t xTimerGetCoreID( TimerHandle_t xTimer )
+        {
+            const Timer_t * pxTimer = xTimer;
+
+            traceENTER_xTimerGetCoreID( xTimer );
+
+            configASSERT( xTimer );
+
+            traceRETURN_xTimerGetCoreID( pxTimer->xTimerCoreID );
+
+            return pxTimer->xTimerCoreID;
+        }
+
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+        {
+            const Timer_t * pxTimer = xTimer;
+
+            traceENTER_xTimerGetSlack( xTimer );
+
+            configASSERT( xTimer );
+
+            traceRETURN_xTimerGetSlack( pxTimer->xTimerSlack );
+
+            return pxTimer->xTimerSlack;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        uint32_t ulTimerGetCoalescedWakeCount( void )
+        {
+            uint32_t ulReturn;
+
+            traceENTER_ulTimerGetCoalescedWakeCount();
+
+            #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+            {
+                BaseType_t xCoreID;
+
+                ulReturn = ( uint32_t ) 0U;
+
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    ulReturn += ulTimerCoalescedWakeCounts[ xCoreID ];
+                }
+            }
+            #else
+            {
+                ulReturn = ulTimerCoalescedWakeCount;
+            }
+            #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+            traceRETURN_ulTimerGetCoalescedWakeCount( ulReturn );
+
+            return ulReturn;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
     TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
     {
         Timer_t * pxTimer = xTimer;
@@ -709,24 +1290,31 @@
             xExpiredTime += pxTimer->xTimerPeriodInTicks;
 
             /* Call the timer callback. */
-            traceTIMER_EXPIRED( pxTimer );
-            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            prvExecuteTimerCallback( pxTimer );
+
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* A task may have stopped or restarted the timer while the
+                 * callback was executing, in which case the backlog no longer
+                 * applies. */
+                if( ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U ) ||
+                    ( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) )
+                {
+                    break;
+                }
+            }
+            #endif /* configUSE_TIMER_DIRECT_COMMANDS */
         }
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+    static void prvProcessExpiredTimer( Timer_t * const pxTimer,
+                                        const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        /* MISRA Ref 11.5.3 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
-
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
-
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        prvRemoveTimerFromActiveList( pxTimer );
 
         /* If the timer is an auto-reload timer then calculate the next
          * expiry time and re-insert the timer in the list of active timers. */
@@ -740,8 +1328,21 @@
         }
 
         /* Call the timer callback. */
+        prvExecuteTimerCallback( pxTimer );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExecuteTimerCallback( Timer_t * const pxTimer )
+    {
         traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+
+        /* The active timers are not accessed while the callback executes, so
+         * tasks that update them directly do not have to wait for it. */
+        tmrUNLOCK_ACTIVE_TIMERS();
+        {
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
+        tmrLOCK_ACTIVE_TIMERS();
     }
 /*-----------------------------------------------------------*/
 
@@ -758,8 +1359,14 @@
             /* Allow the application writer to execute some code in the context of
              * this task at the point the task starts executing.  This is useful if the
              * application includes initialisation code that would benefit from
-             * executing after the scheduler has been started. */
-            vApplicationDaemonTaskStartupHook();
+             * executing after the scheduler has been started.  When there is a
+             * timer service task per core only the one on core 0 executes it. */
+            #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+                if( tmrGET_CORE_ID() == ( BaseType_t ) 0 )
+            #endif
+            {
+                vApplicationDaemonTaskStartupHook();
+            }
         }
         #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
 
@@ -779,12 +1386,56 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
         TickType_t xTimeNow;
         BaseType_t xTimerListsWereSwitched;
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            vTaskSuspendAll();
+            {
+                /* The wheel orders timers relative to xTimerWheelTime, so there
+                 * are no lists to switch, and whether the next wheel event is
+                 * due is assessed using wrapping arithmetic. */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+                #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+                {
+                    /* A task may have updated the wheel since the next expire
+                     * time was obtained. */
+                    xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+                }
+                #endif
+
+                if( ( xListWasEmpty == pdFALSE ) &&
+                    ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+                {
+                    tmrLOCK_ACTIVE_TIMERS();
+                    ( void ) xTaskResumeAll();
+                    prvAdvanceTimerWheel( xTimeNow );
+                    tmrUNLOCK_ACTIVE_TIMERS();
+                }
+                else
+                {
+                    /* Block to wait for the next wheel event or a command to be
+                     * received - whichever comes first.  If the wheel is empty
+                     * there is no need to wake until a command arrives. */
+                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
         vTaskSuspendAll();
         {
             /* Obtain the time now to make an assessment as to whether the timer
@@ -794,13 +1445,45 @@
              * prvSampleTimeNow() function. */
             xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* A task may have updated the timer lists since the next
+                 * expire time was obtained. */
+                xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+            }
+            #endif
+
             if( xTimerListsWereSwitched == pdFALSE )
             {
                 /* The tick count has not overflowed, has the timer expired? */
                 if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
                 {
+                    #if ( configUSE_TIMER_SLACK == 1 )
+                    {
+                        /* Count the wake-ups saved by deferring this wake-up
+                         * once the deferred wake-up time has been reached. */
+                        if( ( uxTimerPendingCoalescedWakes != ( UBaseType_t ) 0U ) && ( xTimeNow >= xTimerCoalescedWakeTime ) )
+                        {
+                            ulTimerCoalescedWakeCount += ( uint32_t ) uxTimerPendingCoalescedWakes;
+                            uxTimerPendingCoalescedWakes = ( UBaseType_t ) 0U;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_TIMER_SLACK */
+
+                    /* Keep the active timers locked so the timer at the head of
+                     * the list cannot change before it is processed. */
+                    tmrLOCK_ACTIVE_TIMERS();
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    prvProcessExpiredTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), xNextExpireTime, xTimeNow );
+                    tmrUNLOCK_ACTIVE_TIMERS();
                 }
                 else
                 {
@@ -810,6 +1493,22 @@
                      * received - whichever comes first.  The following line cannot
                      * be reached unless xNextExpireTime > xTimeNow, except in the
                      * case when the current timer list is empty. */
+                    #if ( configUSE_TIMER_SLACK == 1 )
+                    {
+                        if( xListWasEmpty == pdFALSE )
+                        {
+                            /* Defer the wake-up for as long as the slack of the
+                             * timers that expire first allows. */
+                            xNextExpireTime = prvGetCoalescedExpireTime( xNextExpireTime, &uxTimerPendingCoalescedWakes );
+                            xTimerCoalescedWakeTime = xNextExpireTime;
+                        }
+                        else
+                        {
+                            uxTimerPendingCoalescedWakes = ( UBaseType_t ) 0U;
+                        }
+                    }
+                    #endif /* configUSE_TIMER_SLACK */
+
                     if( xListWasEmpty != pdFALSE )
                     {
                         /* The current timer list is empty - is the overflow list
@@ -835,34 +1534,134 @@
             }
             else
             {
+                #if ( configUSE_TIMER_SLACK == 1 )
+                {
+                    /* A deferred wake-up time is meaningless once the tick
+                     * count has overflowed. */
+                    uxTimerPendingCoalescedWakes = ( UBaseType_t ) 0U;
+                }
+                #endif
+
                 ( void ) xTaskResumeAll();
             }
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        static TickType_t prvGetCoalescedExpireTime( const TickType_t xNextExpireTime,
+                                                     UBaseType_t * const puxCoalescedWakes )
+        {
+            const ListItem_t * pxListItem;
+            const ListItem_t * const pxListEnd = listGET_END_MARKER( pxCurrentTimerList );
+            const Timer_t * pxTimer;
+            TickType_t xExpireTime, xDeadline;
+            TickType_t xWakeTime = xNextExpireTime;
+            TickType_t xEarliestDeadline = tmrMAX_TIME_BEFORE_OVERFLOW;
+            UBaseType_t uxCoalescedWakes = ( UBaseType_t ) 0U;
+
+            /* Timers are listed in expiry time order, so the walk can stop at
+             * the first timer that expires after the deadline of a timer that
+             * expires before it.  Only the current timer list is considered, so
+             * a wake-up is never deferred past a tick count overflow. */
+            for( pxListItem = listGET_HEAD_ENTRY( pxCurrentTimerList ); pxListItem != pxListEnd; pxListItem = listGET_NEXT( pxListItem ) )
+            {
+                xExpireTime = listGET_LIST_ITEM_VALUE( pxListItem );
+
+                if( xExpireTime > xEarliestDeadline )
+                {
+                    break;
+                }
+
+                if( xExpireTime != xWakeTime )
+                {
+                    /* This timer would otherwise need a wake-up of its own. */
+                    xWakeTime = xExpireTime;
+                    uxCoalescedWakes++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTimer = ( const Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+                xDeadline = xExpireTime + pxTimer->xTimerSlack;
+
+                if( xDeadline < xExpireTime )
+                {
+                    /* The deadline is beyond the tick count overflow. */
+                    xDeadline = tmrMAX_TIME_BEFORE_OVERFLOW;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xDeadline < xEarliestDeadline )
+                {
+                    xEarliestDeadline = xDeadline;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            *puxCoalescedWakes = uxCoalescedWakes;
+
+            return xWakeTime;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
     static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
     {
         TickType_t xNextExpireTime;
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            /* The wheel is not kept in expiry order, so the time returned is
+             * that of the next wheel event, which may be a cascade rather than
+             * an expiry. */
+            if( prvIsTimerWheelEmpty() == pdFALSE )
+            {
+                *pxListWasEmpty = pdFALSE;
+                xNextExpireTime = xTimerWheelTime + prvGetTicksToNextWheelEvent();
+            }
+            else
+            {
+                *pxListWasEmpty = pdTRUE;
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
-        else
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
 
         return xNextExpireTime;
     }
@@ -871,13 +1670,16 @@
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
     {
         TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U;
 
         xTimeNow = xTaskGetTickCount();
 
         if( xTimeNow < xLastTime )
         {
-            prvSwitchTimerLists();
+            #if ( configUSE_TIMER_WHEEL == 0 )
+            {
+                prvSwitchTimerLists();
+            }
+            #endif
             *pxTimerListsWereSwitched = pdTRUE;
         }
         else
@@ -901,6 +1703,24 @@
         listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
         listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* If no timers are referenced from the wheel then there is nothing
+             * to cascade or expire between xTimerWheelTime and now, so bring
+             * xTimerWheelTime up to date.  This also prevents xTimerWheelTime
+             * falling so far behind the tick count that wrapping arithmetic
+             * relative to it would no longer be valid. */
+            if( prvIsTimerWheelEmpty() != pdFALSE )
+            {
+                xTimerWheelTime = xTimeNow;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+
         if( xNextExpiryTime <= xTimeNow )
         {
             /* Has the expiry time elapsed between the command to start/reset a
@@ -913,7 +1733,17 @@
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    /* The expiry time is after the tick count overflows, which
+                     * the wheel accounts for using wrapping arithmetic. */
+                    prvInsertTimerInWheel( pxTimer );
+                }
+                #else
+                {
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
         else
@@ -927,7 +1757,15 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    prvInsertTimerInWheel( pxTimer );
+                }
+                #else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
 
@@ -940,15 +1778,28 @@
         DaemonTaskMessage_t xMessage = { 0 };
         Timer_t * pxTimer;
         BaseType_t xTimerListsWereSwitched;
+        BaseType_t xTimerIsLocal = pdTRUE;
+        BaseType_t xResult;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+        while( xQueuePeek( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
         {
+            /* A timer command is only removed from the queue once the active
+             * timers are locked, so a command processed directly cannot
+             * overtake a command that has been received but not processed. */
+            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+            {
+                tmrLOCK_ACTIVE_TIMERS();
+            }
+
+            ( void ) xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY );
+
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
             {
                 /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
+                 * commands, other than tmrCOMMAND_WAKE_TIMER_TASK which is only
+                 * sent to unblock this task. */
+                if( ( xMessage.xMessageID < ( BaseType_t ) 0 ) && ( xMessage.xMessageID != tmrCOMMAND_WAKE_TIMER_TASK ) )
                 {
                     const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
 
@@ -974,186 +1825,732 @@
                  * software timer. */
                 pxTimer = xMessage.u.xTimerParameters.pxTimer;
 
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+                #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
                 {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    xTimerIsLocal = prvClaimTimerForCommand( pxTimer, xMessage.xMessageID );
                 }
+                #endif
 
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                if( xTimerIsLocal != pdFALSE )
+                {
+                    if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+                    {
+                        /* The timer is in a list, remove it. */
+                        prvRemoveTimerFromActiveList( pxTimer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                    traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
 
-                switch( xMessage.xMessageID )
-                {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                    /* In this case the xTimerListsWereSwitched parameter is not used, but
+                     *  it must be present in the function call.  prvSampleTimeNow() must be
+                     *  called after the message is received from xTimerQueue so there is no
+                     *  possibility of a higher priority task adding a message to the message
+                     *  queue with a time that is ahead of the timer daemon task (because it
+                     *  pre-empted the timer daemon task after the xTimeNow value was set). */
+                    xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                    switch( xMessage.xMessageID )
+                    {
+                        case tmrCOMMAND_START:
+                        case tmrCOMMAND_START_FROM_ISR:
+                        case tmrCOMMAND_RESET:
+                        case tmrCOMMAND_RESET_FROM_ISR:
+                            /* Start or restart a timer. */
+                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+
+                            if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
                             {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                                /* The timer expired before it was added to the active
+                                 * timer list.  Process it now. */
+                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                                {
+                                    prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                                }
+                                else
+                                {
+                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                }
+
+                                /* Call the timer callback. */
+                                prvExecuteTimerCallback( pxTimer );
                             }
                             else
                             {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                mtCOVERAGE_TEST_MARKER();
                             }
 
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-
-                        break;
-
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
+                            break;
 
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                        {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        case tmrCOMMAND_STOP:
+                        case tmrCOMMAND_STOP_FROM_ISR:
+                            /* The timer has already been removed from the active list. */
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                            break;
+
+                        case tmrCOMMAND_CHANGE_PERIOD:
+                        case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                            pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
+                            configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                            /* The new period does not really have a reference, and can
+                             * be longer or shorter than the old one.  The command time is
+                             * therefore set to the current time, and as the period cannot
+                             * be zero the next expiry time can only be in the future,
+                             * meaning (unlike for the xTimerStart() case above) there is
+                             * no fail case that needs to be handled here. */
+                            ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                            break;
+
+                        case tmrCOMMAND_DELETE:
+                            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                             {
-                                vPortFree( pxTimer );
+                                /* The timer has already been removed from the active list,
+                                 * just free up the memory if the memory was dynamically
+                                 * allocated. */
+                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                                {
+                                    vPortFree( pxTimer );
+                                }
+                                else
+                                {
+                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                }
                             }
-                            else
+                            #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
                             {
+                                /* If dynamic allocation is not enabled, the memory
+                                 * could not have been dynamically allocated. So there is
+                                 * no need to free the memory - just mark the timer as
+                                 * "not active". */
                                 pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
                             }
-                        }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                        {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
+                            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                            break;
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
+                        default:
+                            /* Don't expect to get here. */
+                            break;
+                    }
+                }
+                else
+                {
+                    /* The timer was moved to another core after the command
+                     * was sent, so pass the command on to the timer service
+                     * task of that core.  The active timers are locked, so the
+                     * command cannot wait for space on that core's queue. */
+                    xResult = xQueueSendToBack( tmrTIMER_QUEUE_FOR( pxTimer ), &xMessage, tmrNO_DELAY );
+                    traceTIMER_COMMAND_SEND( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue, xResult );
+
+                    /* Avoid compiler warnings when the trace macro is not
+                     * defined. */
+                    ( void ) xResult;
                 }
+
+                tmrUNLOCK_ACTIVE_TIMERS();
             }
         }
     }
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
+    #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static BaseType_t prvClaimTimerForCommand( Timer_t * const pxTimer,
+                                                   const BaseType_t xCommandID )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            BaseType_t xReturn = pdFALSE;
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            /* vTimerSetCoreID() only moves a dormant timer, and does so from
+             * within a critical section, so checking the owner and marking the
+             * timer active within one critical section ensures the timer
+             * cannot be moved once this core has started to update it. */
+            taskENTER_CRITICAL();
+            {
+                if( pxTimer->xTimerCoreID == tmrGET_CORE_ID() )
+                {
+                    xReturn = pdTRUE;
+
+                    switch( xCommandID )
+                    {
+                        case tmrCOMMAND_START:
+                        case tmrCOMMAND_START_FROM_ISR:
+                        case tmrCOMMAND_RESET:
+                        case tmrCOMMAND_RESET_FROM_ISR:
+                        case tmrCOMMAND_CHANGE_PERIOD:
+                        case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                            break;
+
+                        default:
+                            /* Other commands do not add the timer to the
+                             * active timers. */
+                            break;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            return xReturn;
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #endif /* configUSE_PER_CORE_TIMER_TASKS */
 /*-----------------------------------------------------------*/
 
-    static void prvCheckForValidListAndQueue( void )
-    {
-        /* Check that the list from which active timers are referenced, and the
-         * queue used to communicate with the timer service, have been
-         * initialised. */
-        taskENTER_CRITICAL();
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+        static BaseType_t prvProcessCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue )
         {
-            if( xTimerQueue == NULL )
-            {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+            BaseType_t xReturn = pdFAIL;
+            BaseType_t xListWasEmpty, xListIsEmpty;
+            TickType_t xNextExpireTime, xNextExpireTimeNow, xTimeNow;
+            DaemonTaskMessage_t xMessage;
 
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            #if ( configUSE_TIMER_SLACK == 1 )
+                UBaseType_t uxCoalescedWakes;
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xTimeNow = xTaskGetTickCount();
+
+                /* If the tick count has overflowed since the timer service task
+                 * last sampled it then the timer lists must be switched first,
+                 * which may require timer callbacks to execute, so leave the
+                 * command to the timer service task.  Likewise if a timer would
+                 * expire as soon as it is started.  Commands already waiting on
+                 * the timer queue must be processed first, so the command is
+                 * also queued behind them if there are any. */
+                if( ( xTimeNow >= xLastTime ) &&
+                    ( uxQueueMessagesWaiting( tmrTIMER_QUEUE_FOR( pxTimer ) ) == ( UBaseType_t ) 0U ) )
                 {
-                    /* The timer queue is allocated statically in case
-                     * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-                    PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueue;
-                    PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ];
+                    switch( xCommandID )
+                    {
+                        case tmrCOMMAND_START:
+                        case tmrCOMMAND_RESET:
 
-                    xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+                            if( ( ( TickType_t ) ( xTimeNow - xOptionalValue ) ) < pxTimer->xTimerPeriodInTicks )
+                            {
+                                xReturn = pdPASS;
+                            }
+
+                            break;
+
+                        case tmrCOMMAND_STOP:
+                        case tmrCOMMAND_CHANGE_PERIOD:
+                            xReturn = pdPASS;
+                            break;
+
+                        default:
+                            /* Deleting a timer could free it while its callback
+                             * is executing, so is left to the timer service
+                             * task. */
+                            break;
+                    }
                 }
-                #else
+                else
                 {
-                    xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 
-                #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
                 {
-                    if( xTimerQueue != NULL )
+                    /* Only the active timers of this core can be updated, as
+                     * the task cannot move to another core while the scheduler
+                     * is suspended. */
+                    if( ( xReturn == pdPASS ) && ( prvClaimTimerForCommand( pxTimer, xCommandID ) == pdFALSE ) )
                     {
-                        vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+                        xReturn = pdFAIL;
+                    }
+                }
+                #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+                if( xReturn == pdPASS )
+                {
+                    xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+
+                    #if ( configUSE_TIMER_SLACK == 1 )
+                    {
+                        /* The timer service task blocks until the coalesced
+                         * expiry time, which can change whichever timer is
+                         * updated. */
+                        if( xListWasEmpty == pdFALSE )
+                        {
+                            xNextExpireTime = prvGetCoalescedExpireTime( xNextExpireTime, &uxCoalescedWakes );
+                        }
+                    }
+                    #endif /* configUSE_TIMER_SLACK */
+
+                    #if ( configUSE_TIMER_WHEEL == 0 )
+                    {
+                        /* The timer service task does not wake when its current
+                         * timer list is empty unless the overflow list is not. */
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
+                    }
+                    #endif
+
+                    if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+                    {
+                        prvRemoveTimerFromActiveList( pxTimer );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-                }
-                #endif /* configQUEUE_REGISTRY_SIZE */
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+
+                    traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+                    if( xCommandID == tmrCOMMAND_STOP )
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                    else if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
+                    {
+                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                        pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                    }
+                    else
+                    {
+                        /* Already checked that the timer will not expire before
+                         * it is added to the active timers. */
+                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                        ( void ) prvInsertTimerInActiveList( pxTimer, xOptionalValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xOptionalValue );
+                    }
+
+                    /* Only unblock the timer service task if the time at which
+                     * it next needs to run has changed. */
+                    xNextExpireTimeNow = prvGetNextExpireTime( &xListIsEmpty );
+
+                    #if ( configUSE_TIMER_SLACK == 1 )
+                    {
+                        if( xListIsEmpty == pdFALSE )
+                        {
+                            xNextExpireTimeNow = prvGetCoalescedExpireTime( xNextExpireTimeNow, &uxCoalescedWakes );
+                        }
+                    }
+                    #endif /* configUSE_TIMER_SLACK */
+
+                    #if ( configUSE_TIMER_WHEEL == 0 )
+                    {
+                        if( xListIsEmpty != pdFALSE )
+                        {
+                            xListIsEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
+                    }
+                    #endif
+
+                    if( ( xTimerTaskHandle != NULL ) &&
+                        ( ( xNextExpireTimeNow != xNextExpireTime ) || ( xListIsEmpty != xListWasEmpty ) ) )
+                    {
+                        xMessage.xMessageID = tmrCOMMAND_WAKE_TIMER_TASK;
+                        xMessage.u.xTimerParameters.xMessageValue = ( TickType_t ) 0U;
+                        xMessage.u.xTimerParameters.pxTimer = NULL;
+
+                        /* If the queue is full the timer service task is
+                         * already due to run. */
+                        ( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
+    static void prvSwitchTimerLists( void )
+    {
+        TickType_t xNextExpireTime;
+        List_t * pxTemp;
+
+        /* The tick count has overflowed.  The timer lists must be switched.
+         * If there are any timers still referenced from the current timer list
+         * then they must have expired and should be processed before the lists
+         * are switched. */
+        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        {
+            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+            /* Process the expired timer.  For auto-reload timers, be careful to
+             * process only expirations that occur on the current list.  Further
+             * expirations must wait until after the lists are switched. */
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            prvProcessExpiredTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+        }
+
+        pxTemp = pxCurrentTimerList;
+        pxCurrentTimerList = pxOverflowTimerList;
+        pxOverflowTimerList = pxTemp;
+    }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+    {
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        {
+            /* Work out which level the slot containing the timer belongs to
+             * so the count of timers in that level can be updated. */
+            const List_t * const pxSlot = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+            const UBaseType_t uxLevel = ( UBaseType_t ) ( pxSlot - &( xTimerWheel[ 0 ][ 0 ] ) ) / tmrWHEEL_SLOTS;
+
+            configASSERT( uxLevel < tmrWHEEL_LEVELS );
+            configASSERT( uxTimerWheelLevelCount[ uxLevel ] > ( UBaseType_t ) 0U );
+            uxTimerWheelLevelCount[ uxLevel ]--;
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+
+        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            TickType_t xTicksToExpiry;
+            TickType_t xSlotTime;
+            UBaseType_t uxLevel;
+            UBaseType_t uxSpanBits;
+
+            xTicksToExpiry = xExpiryTime - xTimerWheelTime;
+
+            /* Find the lowest level that spans the time to expiry.  A level
+             * whose span is as wide as TickType_t spans all possible times. */
+            for( uxLevel = 0U; uxLevel < ( tmrWHEEL_LEVELS - 1U ); uxLevel++ )
+            {
+                uxSpanBits = ( UBaseType_t ) ( ( uxLevel + 1U ) * tmrWHEEL_SLOT_BITS );
+
+                if( ( uxSpanBits >= tmrTICK_TYPE_BITS ) || ( ( xTicksToExpiry >> uxSpanBits ) == ( TickType_t ) 0U ) )
+                {
+                    break;
+                }
+            }
+
+            /* A timer that expires beyond the span of the top level is parked
+             * in the furthest slot of the top level.  It is re-inserted, using
+             * its real expiry time, when that slot is cascaded. */
+            uxSpanBits = ( UBaseType_t ) ( ( uxLevel + 1U ) * tmrWHEEL_SLOT_BITS );
+
+            if( ( uxSpanBits < tmrTICK_TYPE_BITS ) && ( ( xTicksToExpiry >> uxSpanBits ) != ( TickType_t ) 0U ) )
+            {
+                xTicksToExpiry = ( ( TickType_t ) 1U << uxSpanBits ) - ( TickType_t ) 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xSlotTime = xTimerWheelTime + xTicksToExpiry;
+
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+            vListInsertEnd( &( xTimerWheel[ uxLevel ][ ( xSlotTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK ] ), &( pxTimer->xTimerListItem ) );
+            uxTimerWheelLevelCount[ uxLevel ]++;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static BaseType_t prvIsTimerWheelEmpty( void )
+        {
+            BaseType_t xReturn = pdTRUE;
+            UBaseType_t uxLevel;
+
+            for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                if( uxTimerWheelLevelCount[ uxLevel ] != ( UBaseType_t ) 0U )
+                {
+                    xReturn = pdFALSE;
+                    break;
+                }
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static TickType_t prvGetTicksToNextWheelEvent( void )
+        {
+            TickType_t xTicks = portMAX_DELAY;
+            TickType_t xOffset;
+            UBaseType_t uxLevel;
+
+            /* If any higher level references timers then a slot may need to
+             * be cascaded when level 0 next wraps. */
+            for( uxLevel = 1U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                if( uxTimerWheelLevelCount[ uxLevel ] != ( UBaseType_t ) 0U )
+                {
+                    xTicks = ( TickType_t ) tmrWHEEL_SLOTS - ( xTimerWheelTime & tmrWHEEL_SLOT_MASK );
+                    break;
+                }
+            }
+
+            /* Level 0 only references timers that expire within one
+             * revolution of the wheel, so the first non-empty slot from
+             * xTimerWheelTime onwards holds the timers that expire next.  The
+             * current slot is included as it still holds timers while they
+             * are being processed. */
+            if( uxTimerWheelLevelCount[ 0 ] != ( UBaseType_t ) 0U )
+            {
+                for( xOffset = ( TickType_t ) 0U; ( xOffset < xTicks ) && ( xOffset < ( TickType_t ) tmrWHEEL_SLOTS ); xOffset++ )
+                {
+                    if( listLIST_IS_EMPTY( &( xTimerWheel[ 0 ][ ( xTimerWheelTime + xOffset ) & tmrWHEEL_SLOT_MASK ] ) ) == pdFALSE )
+                    {
+                        xTicks = xOffset;
+                        break;
+                    }
+                }
+            }
+
+            return xTicks;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvAdvanceTimerWheel( const TickType_t xTimeNow )
+        {
+            TickType_t xTicksToNextEvent;
+            UBaseType_t uxLevel;
+            UBaseType_t uxShift;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            /* xTimerWheelTime is re-read each time around the loop because it
+             * is brought forward when a reloaded timer is the only one left in
+             * the wheel. */
+            while( xTimerWheelTime != xTimeNow )
+            {
+                xTicksToNextEvent = prvGetTicksToNextWheelEvent();
+
+                if( xTicksToNextEvent > ( TickType_t ) ( xTimeNow - xTimerWheelTime ) )
+                {
+                    /* Nothing to do between here and now. */
+                    xTimerWheelTime = xTimeNow;
+                    break;
+                }
+
+                xTimerWheelTime += xTicksToNextEvent;
+
+                /* When level n - 1 wraps, cascade the timers in the level n slot
+                 * that is now current down to the levels below. */
+                uxShift = 0U;
+
+                for( uxLevel = 1U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                {
+                    if( ( ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK ) != ( TickType_t ) 0U )
+                    {
+                        break;
+                    }
+
+                    uxShift += tmrWHEEL_SLOT_BITS;
+
+                    if( uxShift >= tmrTICK_TYPE_BITS )
+                    {
+                        break;
+                    }
+
+                    pxSlot = &( xTimerWheel[ uxLevel ][ ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK ] );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+                        prvRemoveTimerFromActiveList( pxTimer );
+                        prvInsertTimerInWheel( pxTimer );
+                    }
+                }
+
+                /* Every timer in the current level 0 slot expires now.  The
+                 * slot is looked up again after each timer is processed as
+                 * xTimerWheelTime is brought forward to xTimeNow if reloading
+                 * the last timer in the wheel left the wheel empty.  The slot
+                 * for xTimerWheelTime then only holds timers that are due. */
+                while( listLIST_IS_EMPTY( &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_SLOT_MASK ] ) ) == pdFALSE )
+                {
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_SLOT_MASK ] ) );
+                    configASSERT( listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) == xTimerWheelTime );
+                    prvProcessExpiredTimer( pxTimer, xTimerWheelTime, xTimeNow );
+                }
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static void prvCheckForValidListAndQueue( void )
+    {
+        /* Check that the list from which active timers are referenced, and the
+         * queue used to communicate with the timer service, have been
+         * initialised. */
+        taskENTER_CRITICAL();
+        {
+            #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+            {
+                BaseType_t xCoreID;
+
+                /* Each core has its own active timers and timer queue, all of
+                 * which are created together. */
+                if( xTimerQueues[ 0 ] == NULL )
+                {
+                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        #if ( configUSE_TIMER_WHEEL == 1 )
+                        {
+                            UBaseType_t uxLevel, uxSlot;
+
+                            for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                            {
+                                for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                                {
+                                    vListInitialise( &( xTimerWheels[ xCoreID ][ uxLevel ][ uxSlot ] ) );
+                                }
+
+                                uxTimerWheelLevelCounts[ xCoreID ][ uxLevel ] = ( UBaseType_t ) 0U;
+                            }
+                        }
+                        #else
+                        {
+                            vListInitialise( &( xActiveTimerLists[ xCoreID ][ 0 ] ) );
+                            vListInitialise( &( xActiveTimerLists[ xCoreID ][ 1 ] ) );
+                            pxCurrentTimerLists[ xCoreID ] = &( xActiveTimerLists[ xCoreID ][ 0 ] );
+                            pxOverflowTimerLists[ xCoreID ] = &( xActiveTimerLists[ xCoreID ][ 1 ] );
+                        }
+                        #endif /* configUSE_TIMER_WHEEL */
+
+                        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                        {
+                            /* The timer queues are allocated statically in case
+                             * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+                            PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueues[ configNUMBER_OF_CORES ];
+                            PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ configNUMBER_OF_CORES ][ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ];
+
+                            xTimerQueues[ xCoreID ] = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ xCoreID ][ 0 ] ), &( xStaticTimerQueues[ xCoreID ] ) );
+                        }
+                        #else
+                        {
+                            xTimerQueues[ xCoreID ] = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
+                        }
+                        #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+                        #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                        {
+                            if( xTimerQueues[ xCoreID ] != NULL )
+                            {
+                                vQueueAddToRegistry( xTimerQueues[ xCoreID ], "TmrQ" );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configQUEUE_REGISTRY_SIZE */
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configUSE_PER_CORE_TIMER_TASKS == 1 ) */
+            if( xTimerQueue == NULL )
+            {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        uxTimerWheelLevelCount[ uxLevel ] = ( UBaseType_t ) 0U;
+                    }
+                }
+                #else
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* The timer queue is allocated statically in case
+                     * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+                    PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueue;
+                    PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ];
+
+                    xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+                }
+                #else
+                {
+                    xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
+                }
+                #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+                #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                {
+                    if( xTimerQueue != NULL )
+                    {
+                        vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configQUEUE_REGISTRY_SIZE */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+            #endif /* if ( configUSE_PER_CORE_TIMER_TASKS == 1 ) */
         }
         taskEXIT_CRITICAL();
     }
@@ -1267,22 +2664,41 @@
         {
             DaemonTaskMessage_t xMessage;
             BaseType_t xReturn;
+            QueueHandle_t xQueue;
 
             traceENTER_xTimerPendFunctionCall( xFunctionToPend, pvParameter1, ulParameter2, xTicksToWait );
 
-            /* This function can only be called after a timer has been created or
-             * after the scheduler has been started because, until then, the timer
-             * queue does not exist. */
-            configASSERT( xTimerQueue );
+            #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+            {
+                UBaseType_t uxSavedInterruptStatus;
 
-            /* Complete the message with the function parameters and post it to the
-             * daemon task. */
-            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+                /* The function is executed by the timer service task of the
+                 * core that pends it. */
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+                {
+                    xQueue = xTimerQueue;
+                }
+                portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+            }
+            #else
+            {
+                xQueue = xTimerQueue;
+            }
+            #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+            /* This function can only be called after a timer has been created or
+             * after the scheduler has been started because, until then, the timer
+             * queue does not exist. */
+            configASSERT( xQueue );
+
+            /* Complete the message with the function parameters and post it to the
+             * daemon task. */
+            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
             xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
             xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
             xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+            xReturn = xQueueSendToBack( xQueue, &xMessage, xTicksToWait );
 
             tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
             traceRETURN_xTimerPendFunctionCall( xReturn );
@@ -1322,6 +2738,624 @@
     #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+        static BaseType_t prvCreateHRTimerTask( void )
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t * pxTimerTaskTCBBuffer = NULL;
+                StackType_t * pxTimerTaskStackBuffer = NULL;
+                configSTACK_DEPTH_TYPE uxTimerTaskStackSize;
+
+                vApplicationGetHRTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &uxTimerTaskStackSize );
+                xHRTimerTaskHandle = xTaskCreateStatic( prvHRTimerTask,
+                                                        configHR_TIMER_SERVICE_TASK_NAME,
+                                                        uxTimerTaskStackSize,
+                                                        NULL,
+                                                        ( ( UBaseType_t ) configHR_TIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                        pxTimerTaskStackBuffer,
+                                                        pxTimerTaskTCBBuffer );
+
+                if( xHRTimerTaskHandle != NULL )
+                {
+                    xReturn = pdPASS;
+                }
+            }
+            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            {
+                xReturn = xTaskCreate( prvHRTimerTask,
+                                       configHR_TIMER_SERVICE_TASK_NAME,
+                                       configHR_TIMER_TASK_STACK_DEPTH,
+                                       NULL,
+                                       ( ( UBaseType_t ) configHR_TIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                       &xHRTimerTaskHandle );
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static portTASK_FUNCTION( prvHRTimerTask, pvParameters )
+        {
+            HRTimer_t * pxTimer;
+
+            /* Just to avoid compiler warnings. */
+            ( void ) pvParameters;
+
+            for( ; configCONTROL_INFINITE_LOOP(); )
+            {
+                /* Execute the callbacks of all the timers that have expired,
+                 * in the order in which they expired, then wait to be notified
+                 * that more have expired.  A timer that is stopped before its
+                 * callback executes is removed from the pending list. */
+                do
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        pxTimer = pxHRTimerPendingHead;
+
+                        if( pxTimer != NULL )
+                        {
+                            pxHRTimerPendingHead = pxTimer->pxNextPending;
+
+                            if( pxHRTimerPendingHead == NULL )
+                            {
+                                pxHRTimerPendingTail = NULL;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            pxTimer->pxNextPending = NULL;
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrHR_STATUS_IS_PENDING );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+
+                    if( pxTimer != NULL )
+                    {
+                        pxTimer->pxCallbackFunction( pxTimer, NULL );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                } while( pxTimer != NULL );
+
+                ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvInitialiseNewHRTimer( const char * const pcTimerName,
+                                             const BaseType_t xCallbackContext,
+                                             void * const pvTimerID,
+                                             HRTimerCallbackFunction_t pxCallbackFunction,
+                                             HRTimer_t * pxNewTimer )
+        {
+            configASSERT( ( xCallbackContext == tmrHR_CALLBACK_FROM_ISR ) || ( xCallbackContext == tmrHR_CALLBACK_FROM_TASK ) );
+            configASSERT( pxCallbackFunction );
+
+            pxNewTimer->pcTimerName = pcTimerName;
+            pxNewTimer->pxNext = NULL;
+            pxNewTimer->pxNextPending = NULL;
+            pxNewTimer->xExpiryCount = ( HRTimerCount_t ) 0U;
+            pxNewTimer->pvTimerID = pvTimerID;
+            pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+
+            if( xCallbackContext == tmrHR_CALLBACK_FROM_TASK )
+            {
+                pxNewTimer->ucStatus |= ( uint8_t ) tmrHR_STATUS_CALLBACK_FROM_TASK;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+            HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName,
+                                            const BaseType_t xCallbackContext,
+                                            void * const pvTimerID,
+                                            HRTimerCallbackFunction_t pxCallbackFunction )
+            {
+                HRTimer_t * pxNewTimer;
+
+                traceENTER_xHRTimerCreate( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction );
+
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxNewTimer = ( HRTimer_t * ) pvPortMalloc( sizeof( HRTimer_t ) );
+
+                if( pxNewTimer != NULL )
+                {
+                    pxNewTimer->ucStatus = 0x00;
+                    prvInitialiseNewHRTimer( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction, pxNewTimer );
+                }
+
+                traceRETURN_xHRTimerCreate( pxNewTimer );
+
+                return pxNewTimer;
+            }
+
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+            HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName,
+                                                  const BaseType_t xCallbackContext,
+                                                  void * const pvTimerID,
+                                                  HRTimerCallbackFunction_t pxCallbackFunction,
+                                                  StaticHRTimer_t * pxTimerBuffer )
+            {
+                HRTimer_t * pxNewTimer;
+
+                traceENTER_xHRTimerCreateStatic( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction, pxTimerBuffer );
+
+                #if ( configASSERT_DEFINED == 1 )
+                {
+                    /* Sanity check that the size of the structure used to
+                     * declare a variable of type StaticHRTimer_t equals the size
+                     * of the real timer structure. */
+                    volatile size_t xSize = sizeof( StaticHRTimer_t );
+                    configASSERT( xSize == sizeof( HRTimer_t ) );
+                    ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not defined. */
+                }
+                #endif /* configASSERT_DEFINED */
+
+                configASSERT( pxTimerBuffer );
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxNewTimer = ( HRTimer_t * ) pxTimerBuffer;
+
+                if( pxNewTimer != NULL )
+                {
+                    pxNewTimer->ucStatus = ( uint8_t ) tmrHR_STATUS_IS_STATICALLY_ALLOCATED;
+                    prvInitialiseNewHRTimer( pcTimerName, xCallbackContext, pvTimerID, pxCallbackFunction, pxNewTimer );
+                }
+
+                traceRETURN_xHRTimerCreateStatic( pxNewTimer );
+
+                return pxNewTimer;
+            }
+
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+        void vHRTimerDelete( HRTimerHandle_t xTimer )
+        {
+            HRTimer_t * const pxTimer = xTimer;
+
+            traceENTER_vHRTimerDelete( xTimer );
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                ( void ) prvHRTimerStop( pxTimer );
+            }
+            taskEXIT_CRITICAL();
+
+            #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+            {
+                vPortFree( pxTimer );
+            }
+            #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+            {
+                if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_STATICALLY_ALLOCATED ) == 0U )
+                {
+                    vPortFree( pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            traceRETURN_vHRTimerDelete();
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvHRTimerRemoveFromActiveList( HRTimer_t * const pxTimer )
+        {
+            HRTimer_t ** ppxLink = &pxHRTimerListHead;
+
+            while( *ppxLink != pxTimer )
+            {
+                configASSERT( *ppxLink );
+                ppxLink = &( ( *ppxLink )->pxNext );
+            }
+
+            *ppxLink = pxTimer->pxNext;
+            pxTimer->pxNext = NULL;
+            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrHR_STATUS_IS_ACTIVE );
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvHRTimerSetCompare( void )
+        {
+            if( pxHRTimerListHead != NULL )
+            {
+                portHR_TIMER_SET_COMPARE( pxHRTimerListHead->xExpiryCount );
+            }
+            else
+            {
+                portHR_TIMER_CANCEL_COMPARE();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvHRTimerStart( HRTimer_t * const pxTimer,
+                                     const HRTimerCount_t xDelay )
+        {
+            HRTimer_t ** ppxLink = &pxHRTimerListHead;
+            const HRTimer_t * const pxOldHead = pxHRTimerListHead;
+
+            if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_ACTIVE ) != 0U )
+            {
+                prvHRTimerRemoveFromActiveList( pxTimer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTimer->xExpiryCount = portHR_TIMER_GET_COUNT() + xDelay;
+
+            /* Insert the timer after all the timers that expire at the same
+             * time or before it, so timers with the same expiry count expire in
+             * the order in which they were started. */
+            while( ( *ppxLink != NULL ) && ( tmrHR_COUNT_IS_NOT_AFTER( ( *ppxLink )->xExpiryCount, pxTimer->xExpiryCount ) != pdFALSE ) )
+            {
+                ppxLink = &( ( *ppxLink )->pxNext );
+            }
+
+            pxTimer->pxNext = *ppxLink;
+            *ppxLink = pxTimer;
+            pxTimer->ucStatus |= ( uint8_t ) tmrHR_STATUS_IS_ACTIVE;
+
+            /* The compare only needs updating if the timer that expires first
+             * has changed, or is this timer with a new expiry count. */
+            if( ( pxHRTimerListHead != pxOldHead ) || ( pxHRTimerListHead == pxTimer ) )
+            {
+                prvHRTimerSetCompare();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvHRTimerStop( HRTimer_t * const pxTimer )
+        {
+            BaseType_t xReturn = pdFALSE;
+            HRTimer_t ** ppxLink;
+            HRTimer_t * pxPrevious = NULL;
+
+            if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_ACTIVE ) != 0U )
+            {
+                if( pxHRTimerListHead == pxTimer )
+                {
+                    prvHRTimerRemoveFromActiveList( pxTimer );
+                    prvHRTimerSetCompare();
+                }
+                else
+                {
+                    prvHRTimerRemoveFromActiveList( pxTimer );
+                }
+
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_PENDING ) != 0U )
+            {
+                /* The timer has expired but its callback has not executed yet,
+                 * so remove it from the pending list. */
+                ppxLink = &pxHRTimerPendingHead;
+
+                while( *ppxLink != pxTimer )
+                {
+                    configASSERT( *ppxLink );
+                    pxPrevious = *ppxLink;
+                    ppxLink = &( ( *ppxLink )->pxNextPending );
+                }
+
+                *ppxLink = pxTimer->pxNextPending;
+
+                if( pxHRTimerPendingTail == pxTimer )
+                {
+                    pxHRTimerPendingTail = pxPrevious;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTimer->pxNextPending = NULL;
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrHR_STATUS_IS_PENDING );
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerStart( HRTimerHandle_t xTimer,
+                                  const HRTimerCount_t xDelay )
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            traceENTER_xHRTimerStart( xTimer, xDelay );
+
+            configASSERT( xTimer );
+
+            if( xDelay <= tmrHR_MAX_DELAY )
+            {
+                taskENTER_CRITICAL();
+                {
+                    prvHRTimerStart( xTimer, xDelay );
+                }
+                taskEXIT_CRITICAL();
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xHRTimerStart( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer,
+                                         const HRTimerCount_t xDelay )
+        {
+            BaseType_t xReturn = pdFAIL;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xHRTimerStartFromISR( xTimer, xDelay );
+
+            configASSERT( xTimer );
+
+            if( xDelay <= tmrHR_MAX_DELAY )
+            {
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    prvHRTimerStart( xTimer, xDelay );
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xHRTimerStartFromISR( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerStop( HRTimerHandle_t xTimer )
+        {
+            BaseType_t xReturn;
+
+            traceENTER_xHRTimerStop( xTimer );
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvHRTimerStop( xTimer );
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_xHRTimerStop( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer )
+        {
+            BaseType_t xReturn;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xHRTimerStopFromISR( xTimer );
+
+            configASSERT( xTimer );
+
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                xReturn = prvHRTimerStop( xTimer );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xHRTimerStopFromISR( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer )
+        {
+            BaseType_t xReturn;
+            const HRTimer_t * pxTimer = xTimer;
+
+            traceENTER_xHRTimerIsTimerActive( xTimer );
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_ACTIVE ) == 0U )
+                {
+                    xReturn = pdFALSE;
+                }
+                else
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_xHRTimerIsTimerActive( xReturn );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        void * pvHRTimerGetTimerID( HRTimerHandle_t xTimer )
+        {
+            const HRTimer_t * const pxTimer = xTimer;
+
+            traceENTER_pvHRTimerGetTimerID( xTimer );
+
+            configASSERT( xTimer );
+
+            traceRETURN_pvHRTimerGetTimerID( pxTimer->pvTimerID );
+
+            return pxTimer->pvTimerID;
+        }
+/*-----------------------------------------------------------*/
+
+        HRTimerCount_t xHRTimerGetCount( void )
+        {
+            HRTimerCount_t xCount;
+
+            traceENTER_xHRTimerGetCount();
+
+            xCount = portHR_TIMER_GET_COUNT();
+
+            traceRETURN_xHRTimerGetCount( xCount );
+
+            return xCount;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xHRTimerInterruptHandler( void )
+        {
+            HRTimer_t * pxTimer;
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+            BaseType_t xNotifyTask = pdFALSE;
+            BaseType_t xTimerExpired;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xHRTimerInterruptHandler();
+
+            do
+            {
+                pxTimer = NULL;
+
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    if( ( pxHRTimerListHead != NULL ) &&
+                        ( tmrHR_COUNT_IS_NOT_AFTER( pxHRTimerListHead->xExpiryCount, portHR_TIMER_GET_COUNT() ) != pdFALSE ) )
+                    {
+                        xTimerExpired = pdTRUE;
+                        pxTimer = pxHRTimerListHead;
+                        prvHRTimerRemoveFromActiveList( pxTimer );
+
+                        if( ( pxTimer->ucStatus & tmrHR_STATUS_CALLBACK_FROM_TASK ) != 0U )
+                        {
+                            /* Queue the callback for the high resolution timer
+                             * task, unless it is already queued. */
+                            if( ( pxTimer->ucStatus & tmrHR_STATUS_IS_PENDING ) == 0U )
+                            {
+                                if( pxHRTimerPendingTail == NULL )
+                                {
+                                    pxHRTimerPendingHead = pxTimer;
+                                }
+                                else
+                                {
+                                    pxHRTimerPendingTail->pxNextPending = pxTimer;
+                                }
+
+                                pxHRTimerPendingTail = pxTimer;
+                                pxTimer->ucStatus |= ( uint8_t ) tmrHR_STATUS_IS_PENDING;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            xNotifyTask = pdTRUE;
+                            pxTimer = NULL;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        /* No more timers have expired, so set the compare for
+                         * the timer that expires next. */
+                        xTimerExpired = pdFALSE;
+                        prvHRTimerSetCompare();
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                /* Callbacks execute outside of the critical section so they
+                 * can use the interrupt safe API, including restarting their
+                 * own timer. */
+                if( pxTimer != NULL )
+                {
+                    pxTimer->pxCallbackFunction( pxTimer, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            } while( xTimerExpired != pdFALSE );
+
+            if( ( xNotifyTask != pdFALSE ) && ( xHRTimerTaskHandle != NULL ) )
+            {
+                vTaskNotifyGiveFromISR( xHRTimerTaskHandle, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xHRTimerInterruptHandler( xHigherPriorityTaskWoken );
+
+            return xHigherPriorityTaskWoken;
+        }
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+/*-----------------------------------------------------------*/
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -1329,8 +3363,47 @@
  */
     void vTimerResetState( void )
     {
-        xTimerQueue = NULL;
-        xTimerTaskHandle = NULL;
+        #if ( configUSE_PER_CORE_TIMER_TASKS == 1 )
+        {
+            BaseType_t xCoreID;
+
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                xTimerQueues[ xCoreID ] = NULL;
+                xTimerTaskHandles[ xCoreID ] = NULL;
+                xLastTimes[ xCoreID ] = ( TickType_t ) 0U;
+
+                #if ( configUSE_TIMER_SLACK == 1 )
+                {
+                    uxTimerPendingCoalescedWakeCounts[ xCoreID ] = ( UBaseType_t ) 0U;
+                    ulTimerCoalescedWakeCounts[ xCoreID ] = ( uint32_t ) 0U;
+                }
+                #endif
+            }
+        }
+        #else
+        {
+            xTimerQueue = NULL;
+            xTimerTaskHandle = NULL;
+            xLastTime = ( TickType_t ) 0U;
+
+            #if ( configUSE_TIMER_SLACK == 1 )
+            {
+                uxTimerPendingCoalescedWakes = ( UBaseType_t ) 0U;
+                ulTimerCoalescedWakeCount = ( uint32_t ) 0U;
+            }
+            #endif
+        }
+        #endif /* configUSE_PER_CORE_TIMER_TASKS */
+
+        #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+        {
+            pxHRTimerListHead = NULL;
+            pxHRTimerPendingHead = NULL;
+            pxHRTimerPendingTail = NULL;
+            xHRTimerTaskHandle = NULL;
+        }
+        #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
     }
 /*-----------------------------------------------------------*/
 
@@ -0,0 +1,364 @@
+#!/usr/bin/env python3
+#/*
+# * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+# * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+# *
+# * SPDX-License-Identifier: MIT
+# *
+# * Permission is hereby granted, free of charge, to any person obtaining a copy of
+# * this software and associated documentation files (the "Software"), to deal in
+# * the Software without restriction, including without limitation the rights to
+# * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# * the Software, and to permit persons to whom the Software is furnished to do so,
+# * subject to the following conditions:
+# *
+# * The above copyright notice and this permission notice shall be included in all
+# * copies or substantial portions of the Software.
+# *
+# * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+# *
+# * https://www.FreeRTOS.org
+# * https://github.com/FreeRTOS
+# *
+# */
+
+"""Decode a trace written by vTraceRecorderDump().
+
+The trace is converted to the Chrome JSON trace format, which can be opened in
+https://ui.perfetto.dev or chrome://tracing, or printed as text.  Each core is
+shown as a thread of a single process.  The time each task runs, interrupts
+and low power idle periods are shown as slices, and all other events as
+instant events on the core on which they occurred.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x52545246
+TRACE_VERSION = 2
+TIMESTAMP_BITS = 48
+
+# Struct format characters of the handle sizes a trace can have.
+HANDLE_FORMATS = {2: 'H', 4: 'I', 8: 'Q'}
+
+# Kinds of event parameter, used to format the parameters.
+TASK = 'task'
+OBJECT = 'object'
+ADDRESS = 'address'
+VALUE = 'value'
+BITS = 'bits'
+
+# Event code: (name, parameter 1 name and kind, parameter 2 name and kind).
+# Must match the traceRECORDER_EVENT_ values in include/trace_recorder.h.
+EVENTS = {
+    1: ('Task switched in', ('task', TASK), ('priority', VALUE)),
+    2: ('Task switched out', ('task', TASK), None),
+    3: ('Task create', ('task', TASK), ('priority', VALUE)),
+    4: ('Task delete', ('task', TASK), None),
+    5: ('Task ready', ('task', TASK), None),
+    6: ('Task delay', ('ticks', VALUE), None),
+    7: ('Task delay until', ('wake tick', VALUE), None),
+    8: ('Task priority set', ('task', TASK), ('priority', VALUE)),
+    9: ('Task suspend', ('task', TASK), None),
+    10: ('Task resume', ('task', TASK), None),
+    11: ('Task resume from ISR', ('task', TASK), None),
+    12: ('Priority inherit', ('task', TASK), ('priority', VALUE)),
+    13: ('Priority disinherit', ('task', TASK), ('priority', VALUE)),
+    14: ('Tick', ('tick', VALUE), None),
+    20: ('Queue create', ('queue', OBJECT), ('length', VALUE)),
+    21: ('Mutex create', ('mutex', OBJECT), None),
+    22: ('Queue send', ('queue', OBJECT), ('waiting', VALUE)),
+    23: ('Queue send failed', ('queue', OBJECT), ('waiting', VALUE)),
+    24: ('Queue receive', ('queue', OBJECT), ('waiting', VALUE)),
+    25: ('Queue receive failed', ('queue', OBJECT), ('waiting', VALUE)),
+    26: ('Queue send from ISR', ('queue', OBJECT), ('waiting', VALUE)),
+    27: ('Queue receive from ISR', ('queue', OBJECT), ('waiting', VALUE)),
+    28: ('Queue block on send', ('queue', OBJECT), None),
+    29: ('Queue block on receive', ('queue', OBJECT), None),
+    30: ('Queue delete', ('queue', OBJECT), None),
+    40: ('Notify', ('task', TASK), ('index', VALUE)),
+    41: ('Notify from ISR', ('task', TASK), ('index', VALUE)),
+    42: ('Notify give from ISR', ('task', TASK), ('index', VALUE)),
+    43: ('Notify block', ('index', VALUE), None),
+    44: ('Notify received', ('index', VALUE), None),
+    50: ('Malloc', ('address', ADDRESS), ('size', VALUE)),
+    51: ('Free', ('address', ADDRESS), ('size', VALUE)),
+    60: ('Timer create', ('timer', OBJECT), None),
+    61: ('Timer command', ('timer', OBJECT), ('command', VALUE)),
+    62: ('Timer expired', ('timer', OBJECT), None),
+    70: ('Event group create', ('event group', OBJECT), None),
+    71: ('Event group set bits', ('event group', OBJECT), ('bits', BITS)),
+    72: ('Event group set bits from ISR', ('event group', OBJECT), ('bits', BITS)),
+    73: ('Event group block', ('event group', OBJECT), ('bits', BITS)),
+    80: ('Stream buffer create', ('stream buffer', OBJECT), ('type', VALUE)),
+    81: ('Stream buffer send', ('stream buffer', OBJECT), ('bytes', VALUE)),
+    82: ('Stream buffer send from ISR', ('stream buffer', OBJECT), ('bytes', VALUE)),
+    83: ('Stream buffer receive', ('stream buffer', OBJECT), ('bytes', VALUE)),
+    84: ('Stream buffer receive from ISR', ('stream buffer', OBJECT), ('bytes', VALUE)),
+    85: ('Stream buffer block on send', ('stream buffer', OBJECT), None),
+    86: ('Stream buffer block on receive', ('stream buffer', OBJECT), None),
+    90: ('ISR enter', None, None),
+    91: ('ISR exit', None, None),
+    92: ('ISR exit to scheduler', None, None),
+    100: ('Low power idle begin', None, None),
+    101: ('Low power idle end', None, None),
+    200: ('User event', ('id', VALUE), ('value', VALUE)),
+}
+
+EVENT_TASK_SWITCHED_IN = 1
+EVENT_TASK_SWITCHED_OUT = 2
+EVENT_TICK = 14
+EVENT_ISR_ENTER = 90
+EVENT_ISR_EXIT = 91
+EVENT_ISR_EXIT_TO_SCHEDULER = 92
+EVENT_LOW_POWER_IDLE_BEGIN = 100
+EVENT_LOW_POWER_IDLE_END = 101
+
+# Events shown as slices rather than instant events: start code, end codes,
+# slice name.  Task slices are named after the task.
+SLICES = [
+    (EVENT_TASK_SWITCHED_IN, (EVENT_TASK_SWITCHED_OUT,), None),
+    (EVENT_ISR_ENTER, (EVENT_ISR_EXIT, EVENT_ISR_EXIT_TO_SCHEDULER), 'ISR'),
+    (EVENT_LOW_POWER_IDLE_BEGIN, (EVENT_LOW_POWER_IDLE_END,), 'Low power idle'),
+]
+
+
+class Trace:
+    """The contents of a dumped trace."""
+
+    def __init__(self, data):
+        self.endian = self._find_endian(data)
+        header = struct.Struct(self.endian + 'IHHIHHIHHQ')
+        (_, version, cores, self.events_per_core, event_size, name_length,
+         names, self.handle_size, name_entry_size, self.frequency) = header.unpack_from(data, 0)
+
+        if version != TRACE_VERSION:
+            raise ValueError('unsupported trace version %d' % version)
+
+        if self.frequency == 0:
+            raise ValueError('the trace has a timestamp frequency of 0')
+
+        if self.handle_size not in HANDLE_FORMATS:
+            raise ValueError('unsupported handle size %d' % self.handle_size)
+
+        # A name entry is the handle followed by the name, padded to
+        # name_entry_size.
+        handle_format = HANDLE_FORMATS[self.handle_size]
+        name = struct.Struct(self.endian + handle_format + '%ds' % name_length)
+
+        if name_entry_size < name.size:
+            raise ValueError('unsupported name entry size %d' % name_entry_size)
+
+        offset = header.size
+        self.names = {}
+
+        for _ in range(names):
+            handle, text = name.unpack_from(data, offset)
+            self.names[handle] = text.split(b'\0', 1)[0].decode('ascii', 'replace')
+            offset += name_entry_size
+
+        # An event is the first parameter, padded to at least 4 bytes, followed
+        # by the second parameter, the timestamp and the event code, and padded
+        # to event_size.
+        core_header = struct.Struct(self.endian + 'II')
+        padding = max(self.handle_size, 4) - self.handle_size
+        event = struct.Struct(self.endian + handle_format + '%dxIIHBx' % padding)
+
+        if event_size < event.size:
+            raise ValueError('unsupported event size %d' % event_size)
+
+        # Per core: (events written, events dropped, decoded events).
+        self.cores = {}
+
+        for _ in range(cores):
+            core, written = core_header.unpack_from(data, offset)
+            offset += core_header.size
+            held = min(written, self.events_per_core)
+            events = []
+            last = None
+            wraps = 0
+
+            for _ in range(held):
+                p1, p2, low, high, code = event.unpack_from(data, offset)
+                offset += event_size
+                timestamp = (high << 32) | low
+
+                # Only 48 bits of the timestamp are recorded.
+                if last is not None and timestamp < last:
+                    wraps += 1
+                last = timestamp
+                events.append(((wraps << TIMESTAMP_BITS) + timestamp, code, p1, p2))
+
+            self.cores[core] = (written, written - held, events)
+
+    @staticmethod
+    def _find_endian(data):
+        for endian in ('<', '>'):
+            if struct.unpack_from(endian + 'I', data, 0)[0] == TRACE_MAGIC:
+                return endian
+        raise ValueError('not a FreeRTOS trace recorder dump')
+
+    def first_timestamp(self):
+        timestamps = [events[0][0] for (_, _, events) in self.cores.values() if events]
+        return min(timestamps) if timestamps else 0
+
+    def to_us(self, timestamp, origin):
+        return (timestamp - origin) * 1e6 / self.frequency
+
+    def address(self, value):
+        return '0x%0*x' % (self.handle_size * 2, value)
+
+    def name(self, handle):
+        return self.names.get(handle, self.address(handle))
+
+    def format_parameter(self, parameter, value):
+        name, kind = parameter
+
+        if kind in (TASK, OBJECT):
+            text = self.name(value)
+        elif kind == ADDRESS:
+            text = self.address(value)
+        elif kind == BITS:
+            text = '0x%08x' % value
+        else:
+            text = value
+
+        return name, text
+
+    def arguments(self, code, p1, p2):
+        _, parameter1, parameter2 = EVENTS.get(code, (None, ('p1', VALUE), ('p2', VALUE)))
+        arguments = {}
+
+        for parameter, value in ((parameter1, p1), (parameter2, p2)):
+            if parameter is not None:
+                name, text = self.format_parameter(parameter, value)
+                arguments[name] = text
+
+        return arguments
+
+    def event_name(self, code):
+        if code in EVENTS:
+            return EVENTS[code][0]
+        return 'Unknown event %d' % code
+
+
+def to_chrome(trace, include_ticks):
+    origin = trace.first_timestamp()
+    output = [{'name': 'process_name', 'ph': 'M', 'pid': 0, 'args': {'name': 'FreeRTOS'}}]
+    end = max([events[-1][0] for (_, _, events) in trace.cores.values() if events] or [origin])
+
+    for core in sorted(trace.cores):
+        written, dropped, events = trace.cores[core]
+        output.append({'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': core,
+                       'args': {'name': 'Core %d' % core}})
+        output.append({'name': 'thread_sort_index', 'ph': 'M', 'pid': 0, 'tid': core,
+                       'args': {'sort_index': core}})
+
+        if dropped:
+            output.append({'name': 'Events dropped', 'ph': 'i', 's': 't', 'pid': 0, 'tid': core,
+                           'ts': trace.to_us(events[0][0], origin) if events else 0,
+                           'args': {'dropped': dropped, 'written': written}})
+
+        # Slices that have started but not ended, by start code.
+        open_slices = {}
+
+        def close(start_code, timestamp):
+            start, name, arguments = open_slices.pop(start_code)
+            output.append({'name': name, 'ph': 'X', 'pid': 0, 'tid': core,
+                           'ts': trace.to_us(start, origin),
+                           'dur': trace.to_us(timestamp, start), 'args': arguments})
+
+        for timestamp, code, p1, p2 in events:
+            handled = False
+
+            for start_code, end_codes, slice_name in SLICES:
+                if code == start_code:
+                    if start_code in open_slices:
+                        close(start_code, timestamp)
+                    name = slice_name if slice_name is not None else trace.name(p1)
+                    open_slices[start_code] = (timestamp, name, trace.arguments(code, p1, p2))
+                    handled = True
+                elif code in end_codes:
+                    # An end without a start happens when the start was
+                    # overwritten or recorded before the recorder started.
+                    if start_code in open_slices:
+                        close(start_code, timestamp)
+                    handled = code != EVENT_ISR_EXIT_TO_SCHEDULER
+
+            if handled or (code == EVENT_TICK and not include_ticks):
+                continue
+
+            output.append({'name': trace.event_name(code), 'ph': 'i', 's': 't', 'pid': 0,
+                           'tid': core, 'ts': trace.to_us(timestamp, origin),
+                           'args': trace.arguments(code, p1, p2)})
+
+        for start_code in list(open_slices):
+            close(start_code, end)
+
+    return {'traceEvents': output, 'displayTimeUnit': 'ns'}
+
+
+def to_text(trace, include_ticks, out):
+    origin = trace.first_timestamp()
+    merged = []
+
+    for core in sorted(trace.cores):
+        written, dropped, events = trace.cores[core]
+        out.write('Core %d: %d events written, %d dropped\n' % (core, written, dropped))
+        merged.extend((timestamp, core, code, p1, p2) for (timestamp, code, p1, p2) in events)
+
+    merged.sort(key=lambda event: (event[0], event[1]))
+
+    for timestamp, core, code, p1, p2 in merged:
+        if code == EVENT_TICK and not include_ticks:
+            continue
+
+        arguments = ' '.join('%s=%s' % item for item in trace.arguments(code, p1, p2).items())
+        out.write('%14.3f us  core %d  %-30s %s\n' % (trace.to_us(timestamp, origin), core,
+                                                      trace.event_name(code), arguments))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace', help='Trace written by vTraceRecorderDump().')
+    parser.add_argument('-o', '--output', help='Output file, standard output if omitted.')
+    parser.add_argument('-f', '--format', choices=('chrome', 'text'), default='chrome',
+                        help='Output format (default: chrome).')
+    parser.add_argument('--ticks', action='store_true',
+                        help='Include tick events, which are omitted by default.')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        trace = Trace(f.read())
+
+    for core in sorted(trace.cores):
+        written, dropped, _ = trace.cores[core]
+        if dropped:
+            sys.stderr.write('Core %d: %d of %d events were overwritten before the trace was dumped.\n'
+                             % (core, dropped, written))
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+
+    try:
+        if args.format == 'chrome':
+            json.dump(to_chrome(trace, args.ticks), out)
+            out.write('\n')
+        else:
+            to_text(trace, args.ticks, out)
+    finally:
+        if args.output:
+            out.close()
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,367 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder. This #if is closed at the very bottom of this
+ * file. If you want to include the trace recorder then ensure
+ * configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* Identifies the start of a dumped trace, and the version of its format. */
+    #define tracerecorderMAGIC      ( ( uint32_t ) 0x52545246UL ) /* "FRTR" when written little endian. */
+    #define tracerecorderVERSION    ( ( uint16_t ) 2U )
+
+/* Mask used to convert the number of events written to a core's buffer to the
+ * index of the next event in the buffer. */
+    #define tracerecorderINDEX_MASK    ( ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS - 1UL )
+
+/* An event as held in the buffer and written out by vTraceRecorderDump().
+ * The first parameter comes first so it is aligned without padding before it,
+ * and the timestamp is split so the event is 16 bytes when the first parameter
+ * is no more than 32 bits. */
+    typedef struct TraceRecorderEvent
+    {
+        portPOINTER_SIZE_TYPE uxParameter1; /**< Event specific, a handle for most events. */
+        uint32_t ulParameter2;              /**< Event specific. */
+        uint32_t ulTimestampLow;            /**< Low 32 bits of the timestamp. */
+        uint16_t usTimestampHigh;           /**< Bits 32 to 47 of the timestamp. */
+        uint8_t ucEventCode;                /**< One of the traceRECORDER_EVENT_ values. */
+        uint8_t ucReserved;                 /**< Always 0. */
+    } TraceRecorderEvent_t;
+
+/* The events recorded by one core.  ulEventsWritten counts every event ever
+ * written to the buffer, so it also gives the number of events overwritten. */
+    typedef struct TraceRecorderCoreBuffer
+    {
+        uint32_t ulEventsWritten;
+        TraceRecorderEvent_t xEvents[ configTRACE_RECORDER_BUFFER_EVENTS ];
+    } TraceRecorderCoreBuffer_t;
+
+/* The name of a task, timer or queue. */
+    typedef struct TraceRecorderObjectName
+    {
+        portPOINTER_SIZE_TYPE uxObject;        /**< Handle of the object, or 0 if the entry is free. */
+        char cName[ configMAX_TASK_NAME_LEN ]; /**< Name of the object, NUL terminated unless it fills the array. */
+    } TraceRecorderObjectName_t;
+
+/* The header written at the start of a dumped trace. */
+    typedef struct TraceRecorderHeader
+    {
+        uint32_t ulMagic;
+        uint16_t usVersion;
+        uint16_t usNumberOfCores;
+        uint32_t ulEventsPerCore;
+        uint16_t usEventSize;
+        uint16_t usNameLength;
+        uint32_t ulNumberOfNames;
+        uint16_t usHandleSize;    /**< Size of a handle, and of the first event parameter. */
+        uint16_t usNameEntrySize; /**< Size of an object name entry, including the handle and any padding. */
+        uint64_t ullTimestampFrequency;
+    } TraceRecorderHeader_t;
+
+/* The header written before the events of each core in a dumped trace. */
+    typedef struct TraceRecorderCoreHeader
+    {
+        uint32_t ulCoreID;
+        uint32_t ulEventsWritten;
+    } TraceRecorderCoreHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/* Each core only writes to its own buffer. */
+    PRIVILEGED_DATA static TraceRecorderCoreBuffer_t xCoreBuffers[ configNUMBER_OF_CORES ];
+
+/* Names are written under a critical section as they are rare and shared by
+ * all cores.  When the table is full the entry at uxNextNameToReplace is
+ * replaced. */
+    PRIVILEGED_DATA static TraceRecorderObjectName_t xObjectNames[ configTRACE_RECORDER_OBJECT_NAMES ];
+    PRIVILEGED_DATA static UBaseType_t uxNextNameToReplace = ( UBaseType_t ) 0U;
+
+    PRIVILEGED_DATA static volatile BaseType_t xRecording = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderEvent( uint8_t ucEventCode,
+                              portPOINTER_SIZE_TYPE uxParameter1,
+                              uint32_t ulParameter2 )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        TraceRecorderCoreBuffer_t * pxCoreBuffer;
+        TraceRecorderEvent_t * pxEvent;
+        uint64_t ullTimestamp;
+
+        if( xRecording != pdFALSE )
+        {
+            /* Masking interrupts stops the writer being interrupted or moved to
+             * another core, and as each core has its own buffer that is all the
+             * protection needed. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                pxCoreBuffer = &( xCoreBuffers[ portGET_CORE_ID() ] );
+                pxEvent = &( pxCoreBuffer->xEvents[ pxCoreBuffer->ulEventsWritten & tracerecorderINDEX_MASK ] );
+                ullTimestamp = configTRACE_RECORDER_TIMESTAMP();
+
+                pxEvent->ulTimestampLow = ( uint32_t ) ullTimestamp;
+                pxEvent->usTimestampHigh = ( uint16_t ) ( ullTimestamp >> 32 );
+                pxEvent->ucEventCode = ucEventCode;
+                pxEvent->ucReserved = 0U;
+                pxEvent->uxParameter1 = uxParameter1;
+                pxEvent->ulParameter2 = ulParameter2;
+
+                pxCoreBuffer->ulEventsWritten++;
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderObjectName( const void * pvObject,
+                                   const char * pcName )
+    {
+        const portPOINTER_SIZE_TYPE uxObject = traceRECORDER_HANDLE( pvObject );
+        TraceRecorderObjectName_t * pxEntryToWrite = NULL;
+        UBaseType_t ux;
+
+        if( ( pvObject != NULL ) && ( pcName != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Replace the name of an object with the same handle, as the
+                 * memory of a deleted object is often reused for a new one.
+                 * Otherwise use the first free entry. */
+                for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configTRACE_RECORDER_OBJECT_NAMES; ux++ )
+                {
+                    if( xObjectNames[ ux ].uxObject == uxObject )
+                    {
+                        pxEntryToWrite = &( xObjectNames[ ux ] );
+                        break;
+                    }
+                    else if( ( pxEntryToWrite == NULL ) && ( xObjectNames[ ux ].uxObject == ( portPOINTER_SIZE_TYPE ) 0 ) )
+                    {
+                        pxEntryToWrite = &( xObjectNames[ ux ] );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pxEntryToWrite == NULL )
+                {
+                    pxEntryToWrite = &( xObjectNames[ uxNextNameToReplace ] );
+                    uxNextNameToReplace++;
+
+                    if( uxNextNameToReplace >= ( UBaseType_t ) configTRACE_RECORDER_OBJECT_NAMES )
+                    {
+                        uxNextNameToReplace = ( UBaseType_t ) 0U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                pxEntryToWrite->uxObject = uxObject;
+
+                for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configMAX_TASK_NAME_LEN; ux++ )
+                {
+                    pxEntryToWrite->cName[ ux ] = pcName[ ux ];
+
+                    /* Don't copy all configMAX_TASK_NAME_LEN if the string is
+                     * shorter than configMAX_TASK_NAME_LEN characters just in
+                     * case the memory after the string is not accessible. */
+                    if( pcName[ ux ] == ( char ) 0x00 )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStart( void )
+    {
+        traceENTER_vTraceRecorderStart();
+
+        xRecording = pdTRUE;
+
+        traceRETURN_vTraceRecorderStart();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        traceENTER_vTraceRecorderStop();
+
+        xRecording = pdFALSE;
+
+        traceRETURN_vTraceRecorderStop();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderClear( void )
+    {
+        BaseType_t xCoreID;
+
+        traceENTER_vTraceRecorderClear();
+
+        configASSERT( xRecording == pdFALSE );
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            xCoreBuffers[ xCoreID ].ulEventsWritten = 0U;
+        }
+
+        traceRETURN_vTraceRecorderClear();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderUserEvent( uint32_t ulEventID,
+                                  uint32_t ulValue )
+    {
+        traceENTER_vTraceRecorderUserEvent( ulEventID, ulValue );
+
+        vTraceRecorderEvent( traceRECORDER_EVENT_USER, ulEventID, ulValue );
+
+        traceRETURN_vTraceRecorderUserEvent();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWriteFunction,
+                             void * pvContext )
+    {
+        TraceRecorderHeader_t xHeader;
+        TraceRecorderCoreHeader_t xCoreHeader;
+        const TraceRecorderCoreBuffer_t * pxCoreBuffer;
+        uint32_t ulOldestEvent;
+        UBaseType_t ux;
+        BaseType_t xCoreID;
+
+        traceENTER_vTraceRecorderDump( pxWriteFunction, pvContext );
+
+        configASSERT( pxWriteFunction != NULL );
+        configASSERT( xRecording == pdFALSE );
+
+        ( void ) memset( &xHeader, 0x00, sizeof( xHeader ) );
+        xHeader.ulMagic = tracerecorderMAGIC;
+        xHeader.usVersion = tracerecorderVERSION;
+        xHeader.usNumberOfCores = ( uint16_t ) configNUMBER_OF_CORES;
+        xHeader.ulEventsPerCore = ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS;
+        xHeader.usEventSize = ( uint16_t ) sizeof( TraceRecorderEvent_t );
+        xHeader.usNameLength = ( uint16_t ) configMAX_TASK_NAME_LEN;
+        xHeader.usHandleSize = ( uint16_t ) sizeof( portPOINTER_SIZE_TYPE );
+        xHeader.usNameEntrySize = ( uint16_t ) sizeof( TraceRecorderObjectName_t );
+        xHeader.ullTimestampFrequency = ( uint64_t ) configTRACE_RECORDER_TIMESTAMP_FREQUENCY;
+
+        taskENTER_CRITICAL();
+        {
+            for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configTRACE_RECORDER_OBJECT_NAMES; ux++ )
+            {
+                if( xObjectNames[ ux ].uxObject != ( portPOINTER_SIZE_TYPE ) 0 )
+                {
+                    xHeader.ulNumberOfNames++;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        pxWriteFunction( &xHeader, sizeof( xHeader ), pvContext );
+
+        /* The names are not written under the critical section as the write
+         * function may block.  A name recorded during the dump may therefore be
+         * missing from the dump, but only ulNumberOfNames entries are written. */
+        for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configTRACE_RECORDER_OBJECT_NAMES ) && ( xHeader.ulNumberOfNames > 0U ); ux++ )
+        {
+            if( xObjectNames[ ux ].uxObject != ( portPOINTER_SIZE_TYPE ) 0 )
+            {
+                pxWriteFunction( &( xObjectNames[ ux ] ), sizeof( xObjectNames[ ux ] ), pvContext );
+                xHeader.ulNumberOfNames--;
+            }
+        }
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxCoreBuffer = &( xCoreBuffers[ xCoreID ] );
+
+            xCoreHeader.ulCoreID = ( uint32_t ) xCoreID;
+            xCoreHeader.ulEventsWritten = pxCoreBuffer->ulEventsWritten;
+            pxWriteFunction( &xCoreHeader, sizeof( xCoreHeader ), pvContext );
+
+            if( xCoreHeader.ulEventsWritten <= ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS )
+            {
+                pxWriteFunction( pxCoreBuffer->xEvents, ( size_t ) xCoreHeader.ulEventsWritten * sizeof( TraceRecorderEvent_t ), pvContext );
+            }
+            else
+            {
+                /* The buffer has wrapped, so the oldest event is the one that
+                 * will be overwritten next. */
+                ulOldestEvent = xCoreHeader.ulEventsWritten & tracerecorderINDEX_MASK;
+
+                pxWriteFunction( &( pxCoreBuffer->xEvents[ ulOldestEvent ] ),
+                                 ( size_t ) ( ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS - ulOldestEvent ) * sizeof( TraceRecorderEvent_t ),
+                                 pvContext );
+                pxWriteFunction( pxCoreBuffer->xEvents, ( size_t ) ulOldestEvent * sizeof( TraceRecorderEvent_t ), pvContext );
+            }
+        }
+
+        traceRETURN_vTraceRecorderDump();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER == 1 */